@@ -0,0 +1,56 @@
+/*
+ * File:        FFTBench.cc
+ * Description: Benchmarks of the fast Fourier transform.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <FFT.h>
+#include <random>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+UTIL_BENCHMARK(fft_transform)
+{
+    const FFT::INTTYPE logPoints = FFT::INTTYPE(problemSize(14, 10));
+    FFT                fft(logPoints);
+
+    mt19937_64                                rng(1024);
+    uniform_real_distribution<FFT::FLOATTYPE> dist(-1.0L, 1.0L);
+    FFT::FLOATVECTOR                          samples(fft.numberOfPoints());
+    for(auto &s: samples)
+        s = dist(rng);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         fft.loadFloatVector(samples);
+         auto spectrum = fft.transform();
+         doNotOptimize(spectrum);
+     });
+    // n log n butterflies
+    report("fft_transform",
+           size_t(fft.numberOfPoints() * logPoints / 2),
+           samples.size() * sizeof(FFT::FLOATTYPE),
+           times);
+}
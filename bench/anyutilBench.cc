@@ -0,0 +1,113 @@
+/*
+ * File:        anyutilBench.cc
+ * Description: Benchmarks of comparing and sorting Var variants.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <anyutil.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+vector<Var> randomVars(size_t n, int kind)
+{
+    mt19937_64  rng(2001 + kind);
+    vector<Var> reval;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        switch(kind == 3 ? rng() % 3 : kind)
+        {
+            case 0:
+                reval.emplace_back(VAR_INT(rng() % 1000000) - 500000);
+                break;
+            case 1:
+                reval.emplace_back(VAR_FLOAT(rng() % 1000000) / 1000.0L);
+                break;
+            default:
+                reval.emplace_back(VAR_STRING("key" + to_string(rng() % 1000000)));
+                break;
+        }
+    }
+
+    return (reval);
+}
+
+/*
+ * operator<() is not a strict weak order across types (it falls back to comparing the string
+ * forms), so the variants are compared pairwise rather than sorted
+ */
+void benchCompare(const string &name, int kind)
+{
+    const size_t      n    = problemSize(200'000, 10'000);
+    const vector<Var> vars = randomVars(n, kind);
+
+    size_t    less  = 0;
+    run_times times = sampleSeconds(
+     [&]
+     {
+         less = 0;
+         for(size_t i = 1; i < vars.size(); i++)
+             less += vars[i - 1] < vars[i] ? 1 : 0;
+         doNotOptimize(less);
+     });
+    report(name + "_compare", n - 1, 0, times);
+
+    size_t equal = 0;
+    times        = sampleSeconds(
+     [&]
+     {
+         equal = 0;
+         for(size_t i = 1; i < vars.size(); i++)
+             equal += vars[i - 1] == vars[i] ? 1 : 0;
+         doNotOptimize(equal);
+     });
+    report(name + "_equal", n - 1, 0, times);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(var_int)
+{
+    benchCompare("var_int", 0);
+}
+
+UTIL_BENCHMARK(var_float)
+{
+    benchCompare("var_float", 1);
+}
+
+UTIL_BENCHMARK(var_string)
+{
+    benchCompare("var_string", 2);
+}
+
+UTIL_BENCHMARK(var_mixed)
+{
+    benchCompare("var_mixed", 3);
+}
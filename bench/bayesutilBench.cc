@@ -0,0 +1,85 @@
+/*
+ * File:        bayesutilBench.cc
+ * Description: Benchmarks of Bayes network queries.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <bayesutil.h>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+/**
+ * The sprinkler network: Cloud -> Rain, Cloud -> Sprinkler, Rain and Sprinkler -> WetGrass.
+ */
+void buildSprinklerNet(BayesNet &bn)
+{
+    bn.addNode("Cloud", EventValueRange(true), "clouds in the sky");
+    bn.addNode("Rain", EventValueRange(VAR_UINT(0), 5), "amount of rain");
+    bn.addNode("Sprinkler", EventValueRange(VAR_UINT(0), 3), "stage of the sprinkler");
+    bn.addNode("WetGrass", EventValueRange(true), "whether the grass is wet");
+    bn.addCauseEffect("Cloud", "Rain");
+    bn.addCauseEffect("Cloud", "Sprinkler");
+    bn.addCauseEffect("Sprinkler", "WetGrass");
+    bn.addCauseEffect("Rain", "WetGrass");
+    bn.canonise();
+    bn.normalise();
+}
+};
+// namespace
+
+UTIL_BENCHMARK(bayes_build)
+{
+    const size_t n = problemSize(50, 10);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < n; i++)
+         {
+             BayesNet bn;
+             buildSprinklerNet(bn);
+             doNotOptimize(bn);
+         }
+     });
+    report("bayes_build", n, 0, times);
+}
+
+UTIL_BENCHMARK(bayes_query)
+{
+    const size_t n = problemSize(2'000, 100);
+    BayesNet     bn;
+    buildSprinklerNet(bn);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         long double p = 0.0L;
+         for(size_t i = 0; i < n; i++)
+             p += bn.P(CondEvent(Event("Rain", VAR_UINT(i % 5)), Event("Cloud", i % 2 == 0)));
+         doNotOptimize(p);
+     });
+    report("bayes_conditional_query", n, 0, times);
+}
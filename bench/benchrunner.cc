@@ -0,0 +1,87 @@
+/*
+ * File:        benchrunner.cc
+ * Description: Runs the registered micro-benchmarks
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <fstream>
+#include <iostream>
+#include <perf_counters.h>
+#include <string>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+/*
+ * usage: benchrunner [--quick] [--perf] [--json file] [name-filter]
+ * runs all benchmarks whose name contains the filter and optionally writes the results as JSON;
+ * --perf adds hardware performance counters where the system provides them
+ */
+int main(int argc, char *argv[])
+{
+    string filter   = "";
+    string jsonFile = "";
+
+    for(int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+
+        if(arg == "--quick")
+            quickMode() = true;
+        else if(arg == "--perf")
+            perfMode() = true;
+        else if(arg == "--json" && i + 1 < argc)
+            jsonFile = argv[++i];
+        else
+            filter = arg;
+    }
+
+    if(perfMode() && !threadPerfCounters().status().empty())
+    {
+        if(perfCountersAvailable())
+            cerr << "some performance counters are unavailable (" << threadPerfCounters().status() << ")"
+                 << endl;
+        else
+            cerr << "performance counters are unavailable (" << threadPerfCounters().status()
+                 << "), --perf is ignored" << endl;
+    }
+
+    for(auto &[name, f]: registry())
+    {
+        if(name.find(filter) != string::npos)
+            f();
+    }
+
+    if(!jsonFile.empty())
+    {
+        ofstream os(jsonFile);
+        writeJson(os);
+        if(!os)
+        {
+            cerr << "cannot write " << jsonFile << endl;
+            return (1);
+        }
+    }
+
+    return (0);
+}
@@ -0,0 +1,267 @@
+/*
+ * File:        benchutil.h
+ * Description: Minimal micro-benchmark harness for the library subsystems
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_BENCHUTIL_H_INCLUDED
+#define NS_UTIL_BENCHUTIL_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <perf_counters.h>
+#include <string>
+#include <timer.h>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+namespace bench
+{
+    using benchmark_function = std::function<void()>;
+
+    /**
+     *  All benchmarks registered with UTIL_BENCHMARK, in registration order.
+     */
+    inline std::vector<std::pair<std::string, benchmark_function>> &registry()
+    {
+        static std::vector<std::pair<std::string, benchmark_function>> benchmarks;
+
+        return (benchmarks);
+    }
+
+    inline bool registerBenchmark(const std::string &name, benchmark_function f)
+    {
+        registry().emplace_back(name, std::move(f));
+
+        return (true);
+    }
+
+    /**
+     *  When set (benchrunner --quick) benchmarks use reduced problem sizes.
+     */
+    inline bool &quickMode()
+    {
+        static bool quick = false;
+
+        return (quick);
+    }
+
+    /**
+     *  When set (benchrunner --perf) the performance counters of the runs are reported as well.
+     */
+    inline bool &perfMode()
+    {
+        static bool perf = false;
+
+        return (perf);
+    }
+
+    /**
+     *  Select the problem size for the current mode.
+     */
+    inline size_t problemSize(size_t full, size_t quick)
+    {
+        return (quickMode() ? quick : full);
+    }
+
+    /**
+     *  Prevent the optimiser from discarding a computed value.
+     */
+    template<typename T_>
+    inline void doNotOptimize(const T_ &v)
+    {
+        asm volatile("" : : "g"(&v) : "memory");
+    }
+
+    /**
+     *  Wall-clock times of the runs of one benchmark, in seconds.
+     */
+    struct run_times
+    {
+        double      median = 0.0;
+        double      p99    = 0.0;  ///< nearest rank; the slowest run for fewer than 100 runs
+        double      min    = 0.0;
+        size_t      runs   = 0;
+        perf_sample events;  ///< sums over all runs, in perf mode where counters are available
+    };
+
+    /**
+     *  One reported result, as written by writeJson().
+     */
+    struct bench_result
+    {
+        std::string name;
+        size_t      items;
+        size_t      bytes;
+        run_times   times;
+    };
+
+    inline std::vector<bench_result> &results()
+    {
+        static std::vector<bench_result> reval;
+
+        return (reval);
+    }
+
+    /**
+     *  Run f at least repetitions times, and more often while the runs took less than a second
+     *  in total (a tenth in quick mode), up to 200 runs. In perf mode the counters are read
+     *  around, not inside, the timed part of each run.
+     */
+    template<typename F_>
+    run_times sampleSeconds(F_ f, size_t repetitions = 5)
+    {
+        const double        budget = quickMode() ? 0.1 : 1.0;
+        const bool          count  = perfMode() && perfCountersAvailable();
+        std::vector<double> times;
+        double              total = 0.0;
+        perf_sample         events;
+        util::timer         t;
+
+        while(times.size() < repetitions || (total < budget && times.size() < 200))
+        {
+            perf_sample before = count ? threadPerfCounters().read() : perf_sample{};
+            t.start();
+            f();
+            times.push_back(t.elapsed());
+            total += times.back();
+            if(count)
+                events += threadPerfCounters().read() - before;
+        }
+        std::sort(times.begin(), times.end());
+
+        run_times reval;
+        reval.median = times[times.size() / 2];
+        reval.p99    = times[size_t(std::ceil(0.99 * times.size())) - 1];
+        reval.min    = times.front();
+        reval.runs   = times.size();
+        reval.events = events;
+
+        return (reval);
+    }
+
+    /**
+     *  Run f repeatedly and return the median wall-clock time of one run in seconds.
+     */
+    template<typename F_>
+    double medianSeconds(F_ f, size_t repetitions = 5)
+    {
+        return (sampleSeconds(f, repetitions).median);
+    }
+
+    /**
+     *  Print one result line: items processed, median and 99th percentile time and throughput,
+     *  and keep it for writeJson(). Counter values, if any, are printed per item on a second
+     *  line.
+     */
+    inline void report(const std::string &name, size_t items, size_t bytes, const run_times &times)
+    {
+        const double seconds = times.median;
+        results().push_back(bench_result{name, items, bytes, times});
+
+        std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << items << std::fixed
+                  << std::setprecision(3) << std::setw(12) << seconds * 1e3 << " ms" << std::setw(12)
+                  << times.p99 * 1e3 << " ms p99" << std::setw(12) << items / seconds / 1e6 << " M/s"
+                  << std::setw(12) << bytes / seconds / 1e9 << " GB/s" << std::endl;
+
+        if(times.events.events == 0)
+            return;
+        double perItem = 1.0 / double(times.runs) / double(std::max(items, size_t(1)));
+        std::cout << "    per item:" << std::setprecision(2);
+        for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+            if(times.events.has(PerfEvent(e)))
+                std::cout << " " << perfEventName(PerfEvent(e)) << " " << double(times.events.values[e]) * perItem;
+        if(times.events.has(PerfEvent::CYCLES) && times.events.has(PerfEvent::INSTRUCTIONS) &&
+           times.events[PerfEvent::CYCLES] > 0)
+            std::cout << " IPC "
+                      << double(times.events[PerfEvent::INSTRUCTIONS]) / double(times.events[PerfEvent::CYCLES]);
+        std::cout << std::endl;
+    }
+
+    /**
+     *  A JSON number, or null for infinities and NaN (throughputs of runs too fast to time).
+     */
+    inline void writeJsonNumber(std::ostream &os, double value)
+    {
+        if(std::isfinite(value))
+            os << value;
+        else
+            os << "null";
+    }
+
+    /**
+     *  All reported results as a JSON document, for comparing runs of different releases.
+     */
+    inline void writeJson(std::ostream &os)
+    {
+        os << "{\n  \"quick\": " << (quickMode() ? "true" : "false") << ",\n  \"perf\": " << (perfMode() ? "true" : "false")
+           << ",\n  \"benchmarks\": [";
+        os << std::setprecision(9) << std::scientific;
+        for(size_t i = 0; i < results().size(); i++)
+        {
+            const auto &r = results()[i];
+            os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"";
+            for(char c: r.name)
+                os << (c == '"' || c == '\\' ? "\\" : "") << c;
+            os << "\", \"items\": " << r.items << ", \"bytes\": " << r.bytes << ", \"runs\": " << r.times.runs
+               << ", \"median_s\": " << r.times.median << ", \"p99_s\": " << r.times.p99
+               << ", \"min_s\": " << r.times.min << ", \"items_per_s\": ";
+            writeJsonNumber(os, r.items / r.times.median);
+            os << ", \"bytes_per_s\": ";
+            writeJsonNumber(os, r.bytes / r.times.median);
+            if(r.times.events.events != 0)
+            {
+                os << ", \"counters_per_run\": {";
+                const char *separator = "";
+                for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+                {
+                    if(!r.times.events.has(PerfEvent(e)))
+                        continue;
+                    os << separator << "\"" << perfEventName(PerfEvent(e))
+                       << "\": " << double(r.times.events.values[e]) / double(r.times.runs);
+                    separator = ", ";
+                }
+                os << "}";
+            }
+            os << "}";
+        }
+        os << "\n  ]\n}\n";
+        os << std::defaultfloat;
+    }
+};
+// namespace bench
+};
+// namespace util
+
+/**
+ *  Define and register a benchmark function.
+ */
+#define UTIL_BENCHMARK(name_)                                                                 \
+    static void       name_();                                                                \
+    static const bool name_##_registered_ = util::bench::registerBenchmark(#name_, &name_); \
+    static void       name_()
+
+#endif  // NS_UTIL_BENCHUTIL_H_INCLUDED
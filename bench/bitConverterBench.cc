@@ -0,0 +1,183 @@
+/*
+ * File:        bitConverterBench.cc
+ * Description: Benchmarks for decoding bit fields with bit_converter
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <bit>
+#include <bit_converter.h>
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+/**
+ * Random 64-bit protocol headers.
+ */
+const vector<uint64_t> &headers()
+{
+    static vector<uint64_t> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64 rng(2020);
+        reval.resize(problemSize(1UL << 22, 1UL << 14));
+        for(auto &h: reval)
+            h = rng();
+    }
+
+    return (reval);
+}
+
+/**
+ * Bit by bit through std::bitset, as bit_converter::asBitset() used to.
+ */
+template<long long N_>
+unsigned long fieldReference(const bit_converter<uint64_t> &c, long long start)
+{
+    bitset<64> allbits(0ULL);
+    for(size_t i = 8; i > 0; i--)
+    {
+        allbits <<= CHAR_BIT;
+        allbits |= bitset<64>(c.byte[i - 1]);
+    }
+
+    bitset<N_> reval;
+    for(long long i = 0; i < N_; i++)
+        reval[i] = allbits[i + start];
+
+    return (reval.to_ulong());
+}
+
+/**
+ * Sum of the fields of an IPv4-like header: version, header length, DSCP, ECN, total length,
+ * flags, fragment offset, time to live and protocol.
+ */
+uint64_t decodeReference(uint64_t h)
+{
+    bit_converter<uint64_t> c = h;
+
+    return (fieldReference<4>(c, 0) + fieldReference<4>(c, 4) + fieldReference<6>(c, 8) + fieldReference<2>(c, 14) +
+            fieldReference<16>(c, 16) + fieldReference<3>(c, 32) + fieldReference<13>(c, 35) +
+            fieldReference<8>(c, 48) + fieldReference<8>(c, 56));
+}
+
+uint64_t decode(uint64_t h)
+{
+    bit_converter<uint64_t> c = h;
+
+    return (c.getBits(0, 4) + c.getBits(4, 4) + c.getBits(8, 6) + c.getBits(14, 2) + c.getBits(16, 16) +
+            c.getBits(32, 3) + c.getBits(35, 13) + c.getBits(48, 8) + c.getBits(56, 8));
+}
+};
+// namespace
+
+UTIL_BENCHMARK(bit_field_decode_bitset_reference)
+{
+    const auto &h   = headers();
+    uint64_t    sum = 0;
+    run_times   times = sampleSeconds(
+     [&]
+     {
+         for(auto w: h)
+             sum += decodeReference(w);
+     });
+    doNotOptimize(sum);
+    report("bit_field_decode_bitset_reference", h.size(), h.size() * sizeof(uint64_t), times);
+}
+
+UTIL_BENCHMARK(bit_field_decode)
+{
+    const auto &h   = headers();
+    uint64_t    sum = 0;
+    run_times   times = sampleSeconds(
+     [&]
+     {
+         for(auto w: h)
+             sum += decode(w);
+     });
+    doNotOptimize(sum);
+    report("bit_field_decode", h.size(), h.size() * sizeof(uint64_t), times);
+}
+
+UTIL_BENCHMARK(bit_field_extract_scattered)
+{
+    // the flags and the protocol of each header as one value
+    const auto &h   = headers();
+    uint64_t    sum = 0;
+    run_times   times = sampleSeconds(
+     [&]
+     {
+         for(auto w: h)
+             sum += bit_converter<uint64_t>(w).extract(0xFF000007'00000000ULL);
+     });
+    doNotOptimize(sum);
+    report("bit_field_extract_scattered", h.size(), h.size() * sizeof(uint64_t), times);
+}
+
+UTIL_BENCHMARK(bit_rotate_bitset_reference)
+{
+    // the bit by bit rotation bit_converter::rotate() used to do
+    vector<uint64_t> h   = headers();
+    run_times        times = sampleSeconds(
+     [&]
+     {
+         for(auto &w: h)
+         {
+             bitset<64> allBits(w);
+             for(int shift = 0; shift < 13; shift++)
+             {
+                 bool extreme = allBits[0];
+                 allBits >>= 1;
+                 allBits.set(63, extreme);
+             }
+             w = allBits.to_ullong();
+         }
+     });
+    doNotOptimize(h);
+    report("bit_rotate_bitset_reference", h.size(), h.size() * sizeof(uint64_t), times);
+}
+
+UTIL_BENCHMARK(bit_rotate_and_swap)
+{
+    vector<uint64_t> h   = headers();
+    run_times        times = sampleSeconds(
+     [&]
+     {
+         for(auto &w: h)
+         {
+             bit_converter<uint64_t> c = w;
+             c.rotate(13);
+             c.convertByteOrder(std::endian::big);
+             w = c;
+         }
+     });
+    doNotOptimize(h);
+    report("bit_rotate_and_swap", h.size(), h.size() * sizeof(uint64_t), times);
+}
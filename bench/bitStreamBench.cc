@@ -0,0 +1,147 @@
+/*
+ * File:        bitStreamBench.cc
+ * Description: Benchmarks for packing and unpacking N-bit fields
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <bit>
+#include <bit_stream.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+constexpr unsigned telemetryWidths[] = {3, 5, 12};
+
+vector<uint32_t> fieldValues(unsigned bits)
+{
+    mt19937                  rng(bits);
+    vector<uint32_t>         reval(problemSize(1UL << 22, 1UL << 14));
+    uniform_int_distribution<uint32_t> value(0, (1U << bits) - 1);
+    for(auto &v: reval)
+        v = value(rng);
+
+    return (reval);
+}
+
+/**
+ * Bit by bit, as a straightforward decoder would.
+ */
+void unpackReference(span<const byte> in, unsigned bits, span<uint32_t> out)
+{
+    for(size_t i = 0; i < out.size(); i++)
+    {
+        uint32_t v = 0;
+        for(unsigned j = 0; j < bits; j++)
+        {
+            size_t k = i * bits + j;
+            v |= ((to_integer<uint32_t>(in[k / 8]) >> (k % 8)) & 1U) << j;
+        }
+        out[i] = v;
+    }
+}
+};
+// namespace
+
+UTIL_BENCHMARK(bit_unpack_bitwise_reference)
+{
+    for(unsigned bits: telemetryWidths)
+    {
+        auto         values = fieldValues(bits);
+        vector<byte> packed(packedSize(values.size(), bits));
+        packBits(span<const uint32_t>(values), bits, packed);
+        vector<uint32_t> out(values.size());
+        run_times        times = sampleSeconds([&] { unpackReference(packed, bits, out); });
+        doNotOptimize(out);
+        report("bit_unpack_bitwise_reference_" + to_string(bits), out.size(), packed.size(), times);
+    }
+}
+
+UTIL_BENCHMARK(bit_unpack)
+{
+    for(unsigned bits: telemetryWidths)
+    {
+        auto         values = fieldValues(bits);
+        vector<byte> packed(packedSize(values.size(), bits));
+        packBits(span<const uint32_t>(values), bits, packed);
+        for(auto order: {endian::little, endian::big})
+        {
+            vector<uint32_t> out(values.size());
+            run_times        times = sampleSeconds([&] { unpackBits(packed, bits, span<uint32_t>(out), order); });
+            doNotOptimize(out);
+            report(string("bit_unpack_") + (order == endian::little ? "lsb_" : "msb_") + to_string(bits),
+                   out.size(),
+                   packed.size(),
+                   times);
+        }
+
+        vector<uint16_t> out16(values.size());
+        run_times        times = sampleSeconds([&] { unpackBits(packed, bits, span<uint16_t>(out16)); });
+        doNotOptimize(out16);
+        report("bit_unpack_words_16bit_" + to_string(bits), out16.size(), packed.size(), times);
+    }
+}
+
+UTIL_BENCHMARK(bit_pack)
+{
+    for(unsigned bits: telemetryWidths)
+    {
+        auto         values = fieldValues(bits);
+        vector<byte> packed(packedSize(values.size(), bits));
+        for(auto order: {endian::little, endian::big})
+        {
+            run_times times = sampleSeconds([&] { packBits(span<const uint32_t>(values), bits, packed, order); });
+            doNotOptimize(packed);
+            report(string("bit_pack_") + (order == endian::little ? "lsb_" : "msb_") + to_string(bits),
+                   values.size(),
+                   packed.size(),
+                   times);
+        }
+    }
+}
+
+UTIL_BENCHMARK(bit_reader_fields)
+{
+    // a record of mixed widths read field by field
+    auto       values = fieldValues(12);
+    bit_writer writer;
+    for(size_t i = 0; i < values.size(); i++)
+        writer.write(values[i] >> (i % 3 * 4), telemetryWidths[i % 3]);
+
+    uint64_t  sum   = 0;
+    run_times times = sampleSeconds(
+     [&]
+     {
+         bit_reader reader(writer.bytes());
+         for(size_t i = 0; i < values.size(); i++)
+             sum += reader.read(telemetryWidths[i % 3]);
+     });
+    doNotOptimize(sum);
+    report("bit_reader_fields", values.size(), writer.bytes().size(), times);
+}
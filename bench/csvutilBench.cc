@@ -0,0 +1,62 @@
+/*
+ * File:        csvutilBench.cc
+ * Description: Benchmarks of reading csv files.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <csvutil.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+UTIL_BENCHMARK(csv_read)
+{
+    const size_t rows     = problemSize(5'000, 500);
+    const string filename = (filesystem::temp_directory_path() / "benchrunner_csv_read.csv").string();
+
+    {
+        mt19937_64 rng(1999);
+        ofstream   ofs(filename);
+        ofs << "name, active, count, ratio, day\n";
+        ofs << "string, bool, int, float, date\n";
+        for(size_t r = 0; r < rows; r++)
+            ofs << "item" << rng() % 1000 << ", " << (rng() % 2 == 0 ? "yes" : "no") << ", "
+                << int64_t(rng() % 2001) - 1000 << ", " << double(rng() % 100000) / 1000.0 << ", "
+                << 1 + rng() % 28 << "/" << 1 + rng() % 12 << "/" << 1970 + rng() % 50 << "\n";
+    }
+    size_t bytes = filesystem::file_size(filename);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         CSVAnalyzer csv;
+         csv.read(filename);
+         doNotOptimize(csv);
+     });
+    report("csv_read", rows, bytes, times);
+    filesystem::remove(filename);
+}
@@ -0,0 +1,172 @@
+/*
+ * File:        dateutilBench.cc
+ * Description: Benchmarks for date utilities
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <dateutil.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+using namespace util::datecalc;
+
+namespace
+{
+const vector<epoch_date> &timestamps()
+{
+    static vector<epoch_date> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64                                     rng(1967);
+        uniform_int_distribution<epoch_date::rep_type> dist(epoch_date::fromCivil(1900, 1, 1).ticks(),
+                                                            epoch_date::fromCivil(2100, 1, 1).ticks());
+
+        reval.resize(problemSize(100000000UL, 1000000UL));
+        for(auto &d: reval)
+            d = epoch_date(dist(rng));
+    }
+
+    return (reval);
+}
+
+void benchTruncate(const string &name, DateUnit unit)
+{
+    const auto        &in = timestamps();
+    vector<epoch_date> out(in.size());
+
+    run_times times = sampleSeconds([&] { truncate(in, out, unit); });
+    doNotOptimize(out);
+    report(name, in.size(), in.size() * sizeof(epoch_date), times);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(date_truncate_day)
+{
+    benchTruncate("date_truncate_day", DateUnit::Day);
+}
+
+UTIL_BENCHMARK(date_truncate_week)
+{
+    benchTruncate("date_truncate_week", DateUnit::Week);
+}
+
+UTIL_BENCHMARK(date_truncate_month)
+{
+    benchTruncate("date_truncate_month", DateUnit::Month);
+}
+
+UTIL_BENCHMARK(date_truncate_year)
+{
+    benchTruncate("date_truncate_year", DateUnit::Year);
+}
+
+UTIL_BENCHMARK(date_day_of_week)
+{
+    const auto           &in = timestamps();
+    vector<unsigned char> out(in.size());
+
+    run_times times = sampleSeconds([&] { dayOfWeek(in, out); });
+    doNotOptimize(out);
+    report("date_day_of_week", in.size(), in.size() * sizeof(epoch_date), times);
+}
+
+UTIL_BENCHMARK(date_difference)
+{
+    const auto                  &in = timestamps();
+    vector<epoch_date>           shifted(in.rbegin(), in.rend());
+    vector<epoch_date::rep_type> out(in.size());
+
+    run_times times = sampleSeconds([&] { difference(in, shifted, out); });
+    doNotOptimize(out);
+    report("date_difference", in.size(), 2 * in.size() * sizeof(epoch_date), times);
+}
+
+UTIL_BENCHMARK(date_to_time_t)
+{
+    const auto    &in = timestamps();
+    vector<time_t> out(in.size());
+
+    run_times times = sampleSeconds([&] { toTimeT(in, out); });
+    doNotOptimize(out);
+    report("date_to_time_t", in.size(), in.size() * sizeof(epoch_date), times);
+}
+
+UTIL_BENCHMARK(date_scan)
+{
+    const size_t   n = problemSize(2000UL, 200UL);
+    mt19937_64     rng(1984);
+    vector<string> in;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        auto d = civilFromDays(int64_t(rng() % 60000));
+        in.push_back(i % 2 == 0 ? to_string(d.day) + "/" + to_string(d.month) + "/" + to_string(d.year)
+                                : to_string(d.year) + "-" + to_string(d.month) + "-" + to_string(d.day) + " 12:34:56");
+    }
+
+    vector<val::ptime> out(in.size());
+    run_times          times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < in.size(); i++)
+             out[i] = datescan::scanDate(in[i]);
+     });
+    doNotOptimize(out);
+    report("date_scan", in.size(), 0, times);
+
+    vector<time_t> seconds(in.size());
+    times = sampleSeconds([&] { secondsFromEpoch(in, seconds); });
+    doNotOptimize(seconds);
+    report("date_seconds_from_epoch", in.size(), 0, times);
+}
+
+/*
+ * reference: the per-row boost::posix_time computation the kernels replace,
+ * on a sub-sample as it is orders of magnitude slower
+ */
+UTIL_BENCHMARK(date_truncate_month_ptime_reference)
+{
+    const auto        &all = timestamps();
+    vector<val::ptime> in;
+
+    for(size_t i = 0; i < min(all.size(), problemSize(10000000UL, 100000UL)); i++)
+        in.push_back(all[i].toPtime());
+    vector<val::ptime> out(in.size());
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < in.size(); i++)
+         {
+             auto ymd = in[i].date().year_month_day();
+             out[i]   = val::ptime(boost::gregorian::date(ymd.year, ymd.month, 1));
+         }
+     });
+    doNotOptimize(out);
+    report("date_truncate_month_ptime_reference", in.size(), in.size() * sizeof(val::ptime), times);
+}
@@ -0,0 +1,118 @@
+/*
+ * File:        fixedTrigBench.cc
+ * Description: Benchmarks for fixed-point trigonometry against floating point.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fixed_trig.h>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+size_t angleCount()
+{
+    return (problemSize(1'000'000, 50'000));
+}
+
+template<typename Angle_>
+vector<Angle_> randomAngles()
+{
+    mt19937_64                        rng(96);
+    uniform_int_distribution<int64_t> angle(Angle_::min().val(), Angle_::max().val());
+    vector<Angle_>                    reval;
+    for(size_t i = 0; i < angleCount(); i++)
+        reval.push_back(angle(rng));
+
+    return (reval);
+}
+
+/**
+ * What users do without fixedSin(): to double, std::sin, back to fixed point.
+ */
+template<typename Angle_>
+void floatingSin(const vector<Angle_> &angles, vector<q30_t> &out, double radiansPerUnit)
+{
+    for(size_t i = 0; i < angles.size(); i++)
+        out[i] = q30_t(lrint(sin(angles[i].val() * radiansPerUnit) * Q30_ONE));
+}
+
+template<typename Angle_>
+void benchSin(const string &name, double radiansPerUnit)
+{
+    auto          angles = randomAngles<Angle_>();
+    vector<q30_t> out(angles.size());
+
+    run_times times = sampleSeconds([&] { floatingSin(angles, out, radiansPerUnit); });
+    doNotOptimize(out);
+    report(name + "_sin_floating", angles.size(), angles.size() * sizeof(Angle_), times);
+
+    times = sampleSeconds([&] { fixedSin<Angle_>(angles, out); });
+    doNotOptimize(out);
+    report(name + "_sin_fixed", angles.size(), angles.size() * sizeof(Angle_), times);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(fixed_trig_sin)
+{
+    benchSin<Deg180>("deg180", numbers::pi / 180.0);
+    benchSin<Deg360>("deg360", numbers::pi / 180.0);
+    benchSin<Rad2Pi>("rad2pi", 1e-6);
+}
+
+UTIL_BENCHMARK(fixed_trig_atan2)
+{
+    mt19937                       rng(2);
+    uniform_int_distribution<int> coordinate(-1'000'000, 1'000'000);
+    vector<int32_t>               ys(angleCount());
+    vector<int32_t>               xs(angleCount());
+    for(size_t i = 0; i < ys.size(); i++)
+    {
+        ys[i] = coordinate(rng);
+        xs[i] = coordinate(rng);
+    }
+    vector<Rad2Pi> out(ys.size());
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < ys.size(); i++)
+         {
+             double a = atan2(double(ys[i]), double(xs[i]));
+             out[i]   = Rad2Pi(int64_t(llrint((a < 0 ? a + 2 * numbers::pi : a) * 1e6)));
+         }
+     });
+    doNotOptimize(out);
+    report("rad2pi_atan2_floating", ys.size(), ys.size() * 2 * sizeof(int32_t), times);
+
+    times = sampleSeconds([&] { fixedAtan2<Rad2Pi>(ys, xs, out); });
+    doNotOptimize(out);
+    report("rad2pi_atan2_fixed", ys.size(), ys.size() * 2 * sizeof(int32_t), times);
+}
@@ -0,0 +1,220 @@
+/*
+ * File:        floatingpointBench.cc
+ * Description: Benchmarks for quadruple <-> decimal conversions
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <floatingpoint.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+/*
+ * mix of "typical" values (prices, measurements: few significant digits) and
+ * values with full 64-bit significands over the whole exponent range
+ */
+const vector<quadruple> &values()
+{
+    static vector<quadruple> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64                           rng(2011);
+        uniform_int_distribution<long>       cents(1, 100000000);
+        uniform_real_distribution<quadruple> mantissa(1.0L, 10.0L);
+        uniform_int_distribution<int>        exponent(-300, 300);
+
+        reval.resize(problemSize(2000000UL, 50000UL));
+        for(size_t i = 0; i < reval.size(); i++)
+            reval[i] = (i % 2 == 0) ? quadruple(cents(rng)) / 100.0L : mantissa(rng) * powl(10.0L, exponent(rng));
+    }
+
+    return (reval);
+}
+
+const vector<decimal_record> &decimals()
+{
+    static vector<decimal_record> reval;
+
+    if(reval.empty())
+    {
+        const auto &in = values();
+        reval.resize(in.size());
+        for(size_t i = 0; i < in.size(); i++)
+            quadruple_to_shortest_decimal(&in[i], &reval[i]);
+    }
+
+    return (reval);
+}
+
+void benchToDecimal(const string &name, size_t count, void (*convert)(const quadruple *, decimal_record *))
+{
+    const auto            &in = values();
+    vector<decimal_record> out(min(count, in.size()));
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < out.size(); i++)
+             convert(&in[i], &out[i]);
+     });
+    doNotOptimize(out);
+    report(name, out.size(), out.size() * sizeof(quadruple), times);
+}
+
+void benchFromDecimal(const string &name, size_t count, void (*convert)(const decimal_record *, quadruple *))
+{
+    const auto       &in = decimals();
+    vector<quadruple> out(min(count, in.size()));
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < out.size(); i++)
+             convert(&in[i], &out[i]);
+     });
+    doNotOptimize(out);
+    report(name, out.size(), out.size() * sizeof(quadruple), times);
+}
+
+// reference: shortest round-trip by increasing the printf precision until strtold gives the value back
+void printfShortest(const quadruple *px, decimal_record *pd)
+{
+    for(int precision = 1; precision <= LDBL_DECIMAL_DIG; ++precision)
+    {
+        snprintf(pd->ds, sizeof(pd->ds), "%.*Le", precision - 1, *px);
+        if(strtold(pd->ds, nullptr) == *px)
+            break;
+    }
+}
+
+void legacyToDecimal(const quadruple *px, decimal_record *pd)
+{
+    decimal_mode            mode{fp_nearest, floating_form, LDBL_DECIMAL_DIG};
+    fp_exception_field_type ex = 0;
+    quadruple_to_decimal(const_cast<quadruple *>(px), &mode, pd, &ex);
+}
+
+void nearestFromDecimal(const decimal_record *pd, quadruple *px)
+{
+    decimal_to_nearest_quadruple(px, pd);
+}
+
+void strtoldFromDecimal(const decimal_record *pd, quadruple *px)
+{
+    char text[DECIMAL_STRING_LENGTH + 16];
+    snprintf(text, sizeof(text), "%se%d", pd->ds, pd->exponent);
+    *px = strtold(text, nullptr);
+}
+
+void legacyFromDecimal(const decimal_record *pd, quadruple *px)
+{
+    decimal_mode            mode{fp_nearest, floating_form, LDBL_DECIMAL_DIG};
+    fp_exception_field_type ex = 0;
+    decimal_to_quadruple(px, &mode, const_cast<decimal_record *>(pd), &ex);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(fp_to_shortest_decimal)
+{
+    benchToDecimal("fp_to_shortest_decimal", values().size(), quadruple_to_shortest_decimal);
+}
+
+UTIL_BENCHMARK(fp_to_shortest_decimal_printf_reference)
+{
+    benchToDecimal("fp_to_shortest_decimal_printf_reference", values().size(), printfShortest);
+}
+
+UTIL_BENCHMARK(fp_to_decimal_gmp_reference)
+{
+    benchToDecimal("fp_to_decimal_gmp_reference", problemSize(100000UL, 5000UL), legacyToDecimal);
+}
+
+UTIL_BENCHMARK(fp_from_nearest_decimal)
+{
+    benchFromDecimal("fp_from_nearest_decimal", decimals().size(), nearestFromDecimal);
+}
+
+UTIL_BENCHMARK(fp_from_decimal_strtold_reference)
+{
+    benchFromDecimal("fp_from_decimal_strtold_reference", decimals().size(), strtoldFromDecimal);
+}
+
+UTIL_BENCHMARK(fp_from_decimal_gmp_reference)
+{
+    benchFromDecimal("fp_from_decimal_gmp_reference", problemSize(100000UL, 5000UL), legacyFromDecimal);
+}
+
+UTIL_BENCHMARK(fp_column_to_decimals)
+{
+    const auto    &in = values();
+    decimal_column out;
+
+    run_times times = sampleSeconds([&] { quadruples_to_decimals(in, out); });
+    doNotOptimize(out);
+    report("fp_column_to_decimals", in.size(), out.arena().size(), times);
+}
+
+// reference: one std::string per element through an ostringstream
+UTIL_BENCHMARK(fp_column_to_strings_ostream_reference)
+{
+    const auto    &in = values();
+    vector<string> out(in.size());
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         ostringstream os;
+         os.precision(LDBL_DECIMAL_DIG);
+         for(size_t i = 0; i < in.size(); i++)
+         {
+             os.str("");
+             os << in[i];
+             out[i] = os.str();
+         }
+     });
+    doNotOptimize(out);
+    report("fp_column_to_strings_ostream_reference", in.size(), in.size() * sizeof(quadruple), times);
+}
+
+UTIL_BENCHMARK(fp_column_from_decimals)
+{
+    decimal_column column;
+    quadruples_to_decimals(values(), column);
+    vector<quadruple> out(column.size());
+
+    run_times times = sampleSeconds([&] { decimals_to_quadruples(column, out); });
+    doNotOptimize(out);
+    report("fp_column_from_decimals", out.size(), column.arena().size(), times);
+}
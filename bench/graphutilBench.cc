@@ -0,0 +1,110 @@
+/*
+ * File:        graphutilBench.cc
+ * Description: Benchmarks of building and traversing directed graphs.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <boost/graph/depth_first_search.hpp>
+#include <graphutil.h>
+#include <string>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+using node_type  = PODNode<size_t>;
+using graph_type = DirectedGraph<node_type, string>;
+
+/**
+ * Layered DAG: node i feeds the nodes i + 1 .. i + fanOut.
+ */
+void buildGraph(graph_type &g, size_t nodes, size_t fanOut)
+{
+    for(size_t i = 0; i < nodes; i++)
+        for(size_t k = 1; k <= fanOut && i + k < nodes; k++)
+            g.addEdge(node_type(i), node_type(i + k));
+}
+
+struct counting_visitor : public boost::dfs_visitor<>
+{
+    explicit counting_visitor(size_t &count) : count_(count)
+    {
+    }
+
+    template<class Vertex_, class Graph_>
+    void discover_vertex(Vertex_, Graph_ &)
+    {
+        count_++;
+    }
+
+    size_t &count_;
+};
+};
+// namespace
+
+UTIL_BENCHMARK(graph_build)
+{
+    const size_t nodes = problemSize(2'000, 200);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         graph_type g;
+         buildGraph(g, nodes, 3);
+         doNotOptimize(g);
+     });
+    report("graph_build_acyclic", nodes * 3, 0, times);
+}
+
+UTIL_BENCHMARK(graph_traverse)
+{
+    const size_t nodes = problemSize(20'000, 1'000);
+    graph_type   g(true, false);
+    buildGraph(g, nodes, 3);
+
+    size_t    visited = 0;
+    run_times times   = sampleSeconds(
+     [&]
+     {
+         visited = 0;
+         counting_visitor vis(visited);
+         g.applyDepthFirst(vis);
+         doNotOptimize(visited);
+     });
+    report("graph_depth_first", nodes, 0, times);
+
+    times = sampleSeconds([&] { doNotOptimize(g.hasCycle()); });
+    report("graph_has_cycle", nodes, 0, times);
+
+    const size_t queries = problemSize(10'000, 1'000);
+    times                = sampleSeconds(
+     [&]
+     {
+         size_t connected = 0;
+         for(size_t i = 0; i < queries; i++)
+             connected += g.connectedNodes(node_type(i * 7919 % nodes)).size();
+         doNotOptimize(connected);
+     });
+    report("graph_connected_nodes", queries, 0, times);
+}
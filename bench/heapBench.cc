@@ -0,0 +1,109 @@
+/*
+ * File:        heapBench.cc
+ * Description: Benchmarks of the binary heaps.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cstdint>
+#include <functional>
+#include <heap.h>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace util::bench;
+
+namespace
+{
+const vector<uint64_t> &keys()
+{
+    static vector<uint64_t> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64 rng(1962);
+        reval.resize(problemSize(1'000'000, 10'000));
+        for(auto &k: reval)
+            k = rng();
+    }
+
+    return (reval);
+}
+
+/**
+ * Insert all keys, then pop them all, summing the roots.
+ */
+template<typename Heap_>
+void benchHeap(const string &name)
+{
+    const auto &in = keys();
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         Heap_ h;
+         for(auto k: in)
+             h.insert(k);
+         uint64_t sum = 0;
+         while(!h.empty())
+         {
+             sum += h[0];
+             h.pop();
+         }
+         doNotOptimize(sum);
+     });
+    report(name, in.size(), in.size() * sizeof(uint64_t), times);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(heap_insert_pop)
+{
+    benchHeap<heap<uint64_t>>("heap_insert_pop");
+}
+
+UTIL_BENCHMARK(std_heap_insert_pop)
+{
+    benchHeap<std_heap<uint64_t>>("std_heap_insert_pop");
+}
+
+UTIL_BENCHMARK(heap_insert_pop_priority_queue_reference)
+{
+    const auto &in = keys();
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         priority_queue<uint64_t, vector<uint64_t>, greater<uint64_t>> h;
+         for(auto k: in)
+             h.push(k);
+         uint64_t sum = 0;
+         while(!h.empty())
+         {
+             sum += h.top();
+             h.pop();
+         }
+         doNotOptimize(sum);
+     });
+    report("heap_insert_pop_priority_queue_reference", in.size(), in.size() * sizeof(uint64_t), times);
+}
@@ -0,0 +1,124 @@
+/*
+ * File:        limitedIntBench.cc
+ * Description: Benchmarks for bulk limited_int operations.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cstdint>
+#include <degree_conversion.h>
+#include <limited_int.h>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+template<typename LimitedInt_>
+vector<LimitedInt_> randomAngles(size_t n)
+{
+    mt19937_64                        rng(360);
+    uniform_int_distribution<int64_t> angle(LimitedInt_::min().val(), LimitedInt_::max().val());
+    vector<LimitedInt_>               reval;
+    reval.reserve(n);
+    for(size_t i = 0; i < n; i++)
+        reval.push_back(angle(rng));
+
+    return (reval);
+}
+
+size_t angleCount()
+{
+    return (problemSize(4'000'000, 100'000));
+}
+};
+// namespace
+
+UTIL_BENCHMARK(limited_int_add)
+{
+    auto      values = randomAngles<Deg360>(angleCount());
+    run_times times  = sampleSeconds(
+     [&]
+     {
+         for(auto &v: values)
+             v = Deg360(v.val() + 97);
+     });
+    doNotOptimize(values);
+    report("deg360_add_scalar", values.size(), values.size() * sizeof(Deg360), times);
+
+    times = sampleSeconds([&] { Deg360::addAll(values, 97); });
+    doNotOptimize(values);
+    report("deg360_add_bulk", values.size(), values.size() * sizeof(Deg360), times);
+
+    auto radians = randomAngles<Rad2Pi>(angleCount());
+    auto deltas  = randomAngles<Rad2Pi>(angleCount());
+    times        = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < radians.size(); i++)
+             radians[i] = Rad2Pi(radians[i].val() + deltas[i].val());
+     });
+    doNotOptimize(radians);
+    report("rad2pi_add_elementwise_scalar", radians.size(), radians.size() * sizeof(Rad2Pi), times);
+
+    times = sampleSeconds([&] { Rad2Pi::addAll(radians, deltas); });
+    doNotOptimize(radians);
+    report("rad2pi_add_elementwise_bulk", radians.size(), radians.size() * sizeof(Rad2Pi), times);
+}
+
+UTIL_BENCHMARK(limited_int_scale)
+{
+    auto      values = randomAngles<Deg180>(angleCount());
+    run_times times  = sampleSeconds(
+     [&]
+     {
+         for(auto &v: values)
+             v = Deg180(v.val() * 7);
+     });
+    doNotOptimize(values);
+    report("deg180_scale_scalar", values.size(), values.size() * sizeof(Deg180), times);
+
+    times = sampleSeconds([&] { Deg180::scaleAll(values, 7); });
+    doNotOptimize(values);
+    report("deg180_scale_bulk", values.size(), values.size() * sizeof(Deg180), times);
+}
+
+UTIL_BENCHMARK(limited_int_convert)
+{
+    auto           degrees = randomAngles<Deg360>(angleCount());
+    vector<Rad2Pi> radians(degrees.size());
+    run_times      times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < degrees.size(); i++)
+             radians[i] = Rad2Pi(degrees[i]);
+     });
+    doNotOptimize(radians);
+    report("deg360_to_rad2pi_scalar", degrees.size(), degrees.size() * sizeof(Deg360), times);
+
+    times = sampleSeconds([&] { Rad2Pi::convertAll(span<const Deg360>(degrees), radians); });
+    doNotOptimize(radians);
+    report("deg360_to_rad2pi_bulk", degrees.size(), degrees.size() * sizeof(Deg360), times);
+}
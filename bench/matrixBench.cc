@@ -0,0 +1,83 @@
+/*
+ * File:        matrixBench.cc
+ * Description: Benchmarks of matrix multiplication and linear solves.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <matrix.h>
+#include <random>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+matrix<double> randomMatrix(size_t xDim, size_t yDim, uint64_t seed)
+{
+    mt19937_64                        rng(seed);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    matrix<double>                    reval(xDim, yDim);
+
+    for(size_t y = 0; y < yDim; y++)
+        for(size_t x = 0; x < xDim; x++)
+            reval(x, y) = dist(rng);
+
+    return (reval);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(matrix_multiply)
+{
+    const size_t   n   = problemSize(192, 48);
+    matrix<double> lhs = randomMatrix(n, n, 1);
+    matrix<double> rhs = randomMatrix(n, n, 2);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         auto product = lhs * rhs;
+         doNotOptimize(product);
+     });
+    // one multiply-add per item
+    report("matrix_multiply", n * n * n, 0, times);
+}
+
+UTIL_BENCHMARK(matrix_solve)
+{
+    const size_t   n = problemSize(192, 48);
+    matrix<double> m = randomMatrix(n, n, 3);
+    matrix<double> v = randomMatrix(1, n, 4);
+
+    // diagonally dominant, hence regular
+    for(size_t i = 0; i < n; i++)
+        m(i, i) += double(n);
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         auto solution = m.solve(v);
+         doNotOptimize(solution);
+     });
+    report("matrix_solve", n * n * n / 3, 0, times);
+}
@@ -0,0 +1,68 @@
+/*
+ * File:        primesBench.cc
+ * Description: Benchmarks of the prime sieve and prime checks.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <memory>
+#include <primes.h>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+UTIL_BENCHMARK(prime_sieve)
+{
+    // the sieve is a large bitset: keep it off the stack
+    auto checker = make_unique<prime_checker>();
+
+    run_times times = sampleSeconds([&] { doNotOptimize(checker->makePartialSieve()); });
+    report("prime_sieve", prime_checker::SIZE_ULL, prime_checker::SIZE_ULL / 8, times);
+}
+
+UTIL_BENCHMARK(prime_check)
+{
+    const size_t n       = problemSize(1'000'000, 10'000);
+    auto         checker = make_unique<prime_checker>();
+
+    size_t    primes = 0;
+    run_times times  = sampleSeconds(
+     [&]
+     {
+         primes = 0;
+         for(unsigned long long i = 0; i < n; i++)
+             primes += checker->isPrime(i * 2 + 1) ? 1 : 0;
+         doNotOptimize(primes);
+     });
+    report("prime_check_below_sieve_size", n, 0, times);
+
+    const size_t large = problemSize(2'000, 100);
+    times              = sampleSeconds(
+     [&]
+     {
+         primes = 0;
+         for(unsigned long long i = 0; i < large; i++)
+             primes += checker->isPrime(prime_checker::SIZE_ULL * 1000 + i * 2 + 1) ? 1 : 0;
+         doNotOptimize(primes);
+     });
+    report("prime_check_above_sieve_size", large, 0, times);
+}
@@ -0,0 +1,73 @@
+/*
+ * File:        profilingBench.cc
+ * Description: Benchmarks for the overhead of scoped timers.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cstdint>
+#include <profiling.h>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+UTIL_BENCHMARK(profile_scope)
+{
+    const size_t n = problemSize(10'000'000, 100'000);
+
+    uint64_t  sum   = 0;
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < n; i++)
+         {
+             UTIL_PROFILE_SCOPE("profile_scope");
+             sum += i;
+             doNotOptimize(sum);
+         }
+     });
+    report("profile_scope", n, 0, times);
+    cout << "    " << times.median / n * 1e9 << " ns per scope" << endl;
+
+    times = sampleSeconds([&] { profileReport(); });
+    report("profile_report", 1, 0, times);
+}
+
+UTIL_BENCHMARK(profile_counters_scope)
+{
+    const size_t n = problemSize(1'000'000, 10'000);
+
+    uint64_t  sum   = 0;
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < n; i++)
+         {
+             UTIL_PROFILE_COUNTERS_SCOPE("profile_counters_scope");
+             sum += i;
+             doNotOptimize(sum);
+         }
+     });
+    report("profile_counters_scope", n, 0, times);
+    cout << "    " << times.median / n * 1e9 << " ns per scope" << (perfCountersAvailable() ? "" : " (no counters)")
+         << endl;
+}
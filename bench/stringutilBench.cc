@@ -0,0 +1,1009 @@
+/*
+ * File:        stringutilBench.cc
+ * Description: Benchmarks for string utilities
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <algorithm>
+#include <climits>
+#include <clocale>
+#include <cwchar>
+#include <cwctype>
+#include <map>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <stringutil.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+/*
+ * CSV-like lines: a dozen fields of names, integers, decimals and dates, some of them empty
+ */
+const vector<string> &lines()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64                    rng(4711);
+        uniform_int_distribution<int> kind(0, 4);
+        uniform_int_distribution<int> number(0, 1000000);
+        const vector<string>          names = {"Smith", "Miller", "Kybelksties", "O'Neill", "van der Berg"};
+
+        reval.resize(problemSize(2000000UL, 20000UL));
+        for(auto &line: reval)
+        {
+            for(size_t field = 0; field < 12; field++)
+            {
+                if(field > 0)
+                    line += ',';
+                switch(kind(rng))
+                {
+                    case 0:
+                        line += names[number(rng) % names.size()];
+                        break;
+                    case 1:
+                        line += to_string(number(rng));
+                        break;
+                    case 2:
+                        line += to_string(number(rng)) + "." + to_string(number(rng) % 100);
+                        break;
+                    case 3:
+                        line += "2026-10-" + to_string(10 + number(rng) % 20);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    return (reval);
+}
+
+size_t totalBytes()
+{
+    size_t reval = 0;
+    for(const auto &line: lines())
+        reval += line.size();
+
+    return (reval);
+}
+
+template<typename F_>
+void benchSplit(const string &name, F_ splitLine)
+{
+    const auto &in     = lines();
+    size_t      tokens = 0;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         tokens = 0;
+         for(const auto &line: in)
+             tokens += splitLine(line);
+     });
+    doNotOptimize(tokens);
+    report(name, tokens, totalBytes(), times);
+}
+
+/*
+ * CSV cells as they come out of a split: padded with blanks and tabs, some with inner blanks
+ */
+const vector<string> &cells()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64                    rng(1701);
+        uniform_int_distribution<int> pad(0, 3);
+        for(const auto &line: lines())
+        {
+            for(auto token: splitView(line, ','))
+                reval.push_back(string(pad(rng), ' ') + string(token) + string(pad(rng) % 2, '\t'));
+        }
+    }
+
+    return (reval);
+}
+
+size_t cellBytes()
+{
+    size_t reval = 0;
+    for(const auto &cell: cells())
+        reval += cell.size();
+
+    return (reval);
+}
+
+template<typename F_>
+void benchCells(const string &name, F_ modify)
+{
+    const auto    &in = cells();
+    vector<string> work(in.size());
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < in.size(); i++)
+         {
+             work[i].assign(in[i]);
+             modify(work[i]);
+         }
+     });
+    doNotOptimize(work);
+    report(name, in.size(), cellBytes(), times);
+}
+
+// reference: strip as it was done before, a string::find per character and one append each
+void stripReference(string &v, const string &stripChars)
+{
+    string::size_type start  = v.find_first_not_of(stripChars);
+    string::size_type finish = v.find_last_not_of(stripChars) + 1;
+    string            reval  = "";
+
+    if(start == string::npos)
+    {
+        v = "";
+        return;
+    }
+    for(; start < finish; start++)
+    {
+        if(stripChars.find(v[start]) == string::npos)
+            reval.append(&v[start], 1);
+    }
+    v = reval;
+}
+
+// reference: case-insensitive traits as they were before, toupper() per character
+struct toupper_char_traits : public char_traits<char>
+{
+    static bool eq(char c1, char c2)
+    {
+        return (toupper(c1) == toupper(c2));
+    }
+
+    static bool lt(char c1, char c2)
+    {
+        return (toupper(c1) < toupper(c2));
+    }
+
+    static int compare(const char *s1, const char *s2, size_t n)
+    {
+        size_t i = 0;
+        while((i < n) && (*s1) && (*s2) && (eq(*s1, *s2)))
+        {
+            s1++;
+            s2++;
+            i++;
+        }
+        return (i == n ? 0 : lt(*s1, *s2) ? (-i - 1) : (eq(*s1, *s2) ? 0 : i + 1));
+    }
+};
+
+using toupper_string = basic_string<char, toupper_char_traits>;
+
+// reference: hash of the lower-cased copy, as hash<ci_string> was before
+struct toupper_string_hash
+{
+    size_t operator()(const toupper_string &s) const
+    {
+        string lower(s.data(), s.size());
+        toLowerInPlace(lower);
+        return (hash<string>()(lower));
+    }
+};
+
+/*
+ * Column-name-like keys "Customer_Address_0000123" and the same keys in random case
+ */
+const vector<string> &ciKeys()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        reval.resize(problemSize(1000000UL, 20000UL));
+        for(size_t i = 0; i < reval.size(); i++)
+            reval[i] = "Customer_Address_" + to_string(10000000 + i);
+    }
+
+    return (reval);
+}
+
+const vector<string> &ciQueries()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64 rng(99);
+        reval = ciKeys();
+        shuffle(reval.begin(), reval.end(), rng);
+        for(auto &q: reval)
+        {
+            for(auto &c: q)
+                c = rng() % 2 ? toupper(c) : tolower(c);
+        }
+    }
+
+    return (reval);
+}
+
+template<typename Map_>
+void benchCiLookup(const string &name)
+{
+    using key_type = typename Map_::key_type;
+
+    Map_ map;
+    for(size_t i = 0; i < ciKeys().size(); i++)
+        map.emplace(key_type(ciKeys()[i].data(), ciKeys()[i].size()), int(i));
+
+    vector<key_type> queries;
+    for(const auto &q: ciQueries())
+        queries.emplace_back(q.data(), q.size());
+
+    size_t    found = 0;
+    run_times times = sampleSeconds(
+     [&]
+     {
+         found = 0;
+         for(const auto &q: queries)
+             found += map.find(q) != map.end();
+     });
+    doNotOptimize(found);
+    if(found != queries.size())
+        throw logic_error(name + ": lookups failed");
+    report(name, queries.size(), 0, times);
+}
+
+// reference: classification as it was before (character set and length only), then a stream parse
+NumberClass classifyReference(const string &str)
+{
+    if(str.empty() || str.find_first_not_of("0123456789+-.eElL") != string::npos)
+        return (NONE);
+    if(str.find_first_of(".e") != string::npos)
+        return (FLOAT);
+
+    bool isSigned = (str[0] == '-' || str[0] == '+');
+    if(str.size() - (isSigned ? 1 : 0) > 20)
+        return (FLOAT);
+    if(str.size() - (isSigned ? 1 : 0) >= 19)
+        return (str[0] == '-' ? FLOAT : UINT);
+
+    return (INT);
+}
+
+/*
+ * The integer and decimal cells of the CSV-like lines (not the dates)
+ */
+const vector<string> &numberCells()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        for(const auto &cell: cells())
+        {
+            string number = cell;
+            strip(number, " \t");
+            if(!number.empty() && isdigit(number[0]) && number.find('-') == string::npos)
+                reval.push_back(number);
+        }
+    }
+
+    return (reval);
+}
+
+size_t numberBytes()
+{
+    size_t reval = 0;
+    for(const auto &cell: numberCells())
+        reval += cell.size();
+
+    return (reval);
+}
+
+// reference: boolean tokens as they were looked up before, a ci_string copy and a map search
+bool scanBoolReference(const string &strVal, bool &result)
+{
+    const static map<ci_string, bool> VALID_BOOL = {{"true", true},
+                                                    {"t", true},
+                                                    {"yes", true},
+                                                    {"y", true},
+                                                    {"1", true},
+                                                    {"on", true},
+                                                    {"false", false},
+                                                    {"f", false},
+                                                    {"no", false},
+                                                    {"n", false},
+                                                    {"0", false},
+                                                    {"off", false}};
+
+    auto found = VALID_BOOL.find(ci_string(strVal.c_str()));
+    result     = found != VALID_BOOL.end() ? found->second : false;
+
+    return (found != VALID_BOOL.end());
+}
+
+/*
+ * Cells as seen by type guessing: the CSV-like cells, half of them replaced by boolean tokens in
+ * random case
+ */
+const vector<string> &boolCells()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64           rng(2718);
+        const vector<string> tokens = {"true", "false", "yes", "no", "on", "off", "t", "f", "y", "n", "1", "0"};
+        for(const auto &cell: cells())
+        {
+            string token = cell;
+            if(rng() % 2)
+            {
+                token = tokens[rng() % tokens.size()];
+                for(auto &c: token)
+                    c = rng() % 2 ? toupper(c) : c;
+            }
+            strip(token, " \t");
+            reval.push_back(token);
+        }
+    }
+
+    return (reval);
+}
+
+template<typename F_>
+void benchBool(const string &name, F_ scan)
+{
+    const auto &in    = boolCells();
+    size_t      found = 0;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         found = 0;
+         for(const auto &cell: in)
+         {
+             bool result = false;
+             found += scan(cell, result) + result;
+         }
+     });
+    doNotOptimize(found);
+    report(name, in.size(), 0, times);
+}
+
+/*
+ * 200 keywords for the multi-pattern search: the names, 5-digit numbers and random words
+ */
+const vector<string> &keywords()
+{
+    static vector<string> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64 rng(1234);
+        reval = {"Smith", "Miller", "Kybelksties", "O'Neill", "van der Berg"};
+        while(reval.size() < 100)
+            reval.push_back(to_string(10000 + rng() % 90000));
+        while(reval.size() < 200)
+        {
+            string word(5 + rng() % 5, ' ');
+            for(auto &c: word)
+                c = 'a' + rng() % 26;
+            reval.push_back(word);
+        }
+    }
+
+    return (reval);
+}
+
+span<const string> searchLines()
+{
+    return (span<const string>(lines()).first(min(lines().size(), problemSize(200000UL, 5000UL))));
+}
+
+template<typename F_>
+void benchSearch(const string &name, F_ countMatches)
+{
+    auto   in      = searchLines();
+    size_t matches = 0;
+    size_t bytes   = 0;
+    for(const auto &line: in)
+        bytes += line.size();
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         matches = 0;
+         for(const auto &line: in)
+             matches += countMatches(line);
+     });
+    doNotOptimize(matches);
+    report(name, in.size(), bytes, times);
+}
+
+// reference: the string helpers as they were before, a stringstream and a string per call
+template<typename T_>
+string asStringReference(const T_ &v)
+{
+    stringstream ss;
+    ss << v;
+
+    return (ss.str());
+}
+
+template<typename T_>
+string enclosedReference(const T_ &v, const string &leftBrace, const string &rightBrace)
+{
+    stringstream ss;
+    ss << leftBrace << v << rightBrace;
+
+    return (ss.str());
+}
+
+/*
+ * Report rows: an id, a name, a measurement and a few tags
+ */
+struct ReportRow
+{
+    long long   id;
+    string      name;
+    double      value;
+    vector<int> tags;
+};
+
+const vector<ReportRow> &reportRows()
+{
+    static vector<ReportRow> reval;
+
+    if(reval.empty())
+    {
+        mt19937_64           rng(31415);
+        const vector<string> names = {"Smith", "Miller", "Kybelksties", "O'Neill", "van der Berg"};
+        reval.resize(problemSize(1000000UL, 20000UL));
+        for(size_t i = 0; i < reval.size(); i++)
+        {
+            reval[i].id    = 1000000 + i;
+            reval[i].name  = names[rng() % names.size()];
+            reval[i].value = double(rng() % 1000000) / 1000.0;
+            reval[i].tags.resize(rng() % 4);
+            for(auto &tag: reval[i].tags)
+                tag = rng() % 100;
+        }
+    }
+
+    return (reval);
+}
+};
+// namespace
+
+UTIL_BENCHMARK(split_into_vector_reference)
+{
+    benchSplit("split_into_vector_reference", [](const string &line) { return (splitIntoVector(line, ',').size()); });
+}
+
+UTIL_BENCHMARK(split_into_set_reference)
+{
+    benchSplit("split_into_set_reference", [](const string &line) { return (splitIntoSet(line, ',').size()); });
+}
+
+UTIL_BENCHMARK(split_any_of_into_vector_reference)
+{
+    benchSplit("split_any_of_into_vector_reference",
+               [](const string &line) { return (splitIntoVector(line, string(",;")).size()); });
+}
+
+UTIL_BENCHMARK(split_view_char)
+{
+    benchSplit("split_view_char",
+               [](const string &line)
+               {
+                   size_t n = 0;
+                   for(auto token: splitView(line, ','))
+                   {
+                       doNotOptimize(token);
+                       n++;
+                   }
+                   return (n);
+               });
+}
+
+UTIL_BENCHMARK(split_view_any_of)
+{
+    benchSplit("split_view_any_of",
+               [](const string &line)
+               {
+                   size_t n = 0;
+                   for(auto token: splitViewAnyOf(line, ",;"))
+                   {
+                       doNotOptimize(token);
+                       n++;
+                   }
+                   return (n);
+               });
+}
+
+UTIL_BENCHMARK(split_view_exact)
+{
+    benchSplit("split_view_exact",
+               [](const string &line)
+               {
+                   size_t n = 0;
+                   for(auto token: splitViewExact(line, ","))
+                   {
+                       doNotOptimize(token);
+                       n++;
+                   }
+                   return (n);
+               });
+}
+
+UTIL_BENCHMARK(split_into_views_reused)
+{
+    vector<string_view> tokens;
+    benchSplit("split_into_views_reused",
+               [&tokens](const string &line)
+               {
+                   splitIntoViews(line, ',', tokens);
+                   return (tokens.size());
+               });
+}
+
+UTIL_BENCHMARK(csv_cell_copy_only_reference)
+{
+    benchCells("csv_cell_copy_only_reference", [](string &) {});
+}
+
+UTIL_BENCHMARK(csv_cell_strip_reference)
+{
+    const string whitespace = "\t \r\n";
+    benchCells("csv_cell_strip_reference", [&whitespace](string &v) { stripReference(v, whitespace); });
+}
+
+UTIL_BENCHMARK(csv_cell_strip)
+{
+    const string whitespace = "\t \r\n";
+    benchCells("csv_cell_strip", [&whitespace](string &v) { strip(v, whitespace); });
+}
+
+UTIL_BENCHMARK(csv_cell_trim)
+{
+    const string whitespace = "\t \r\n";
+    benchCells("csv_cell_trim", [&whitespace](string &v) { trim(v, whitespace); });
+}
+
+UTIL_BENCHMARK(csv_cell_replace_char)
+{
+    const string whitespace = "\t \r\n";
+    benchCells("csv_cell_replace_char",
+               [&whitespace](string &v) { replaceChar(v, whitespace, '_', StripTrimMode::ALL); });
+}
+
+UTIL_BENCHMARK(csv_cell_to_lower)
+{
+    benchCells("csv_cell_to_lower", [](string &v) { toLowerInPlace(v); });
+}
+
+UTIL_BENCHMARK(csv_line_strip)
+{
+    const auto    &in = lines();
+    vector<string> work(in.size());
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < in.size(); i++)
+         {
+             work[i].assign(in[i]);
+             strip(work[i], ",");
+         }
+     });
+    doNotOptimize(work);
+    report("csv_line_strip", in.size(), totalBytes(), times);
+}
+
+UTIL_BENCHMARK(ci_unordered_map_lookup_reference)
+{
+    benchCiLookup<unordered_map<toupper_string, int, toupper_string_hash>>("ci_unordered_map_lookup_reference");
+}
+
+UTIL_BENCHMARK(ci_unordered_map_lookup)
+{
+    benchCiLookup<unordered_map<ci_string, int>>("ci_unordered_map_lookup");
+}
+
+UTIL_BENCHMARK(ci_map_lookup_reference)
+{
+    benchCiLookup<map<toupper_string, int>>("ci_map_lookup_reference");
+}
+
+UTIL_BENCHMARK(ci_map_lookup)
+{
+    benchCiLookup<map<ci_string, int>>("ci_map_lookup");
+}
+
+UTIL_BENCHMARK(number_classify_reparse_reference)
+{
+    const auto &in  = numberCells();
+    long double sum = 0.0L;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         sum = 0.0L;
+         for(const auto &cell: in)
+         {
+             NumberClass numClass = classifyReference(cell);
+             stringstream ss(cell);
+             if(numClass == INT)
+             {
+                 long long v = 0;
+                 ss >> v;
+                 sum += v;
+             }
+             else
+             {
+                 long double v = 0.0L;
+                 ss >> v;
+                 sum += v;
+             }
+         }
+     });
+    doNotOptimize(sum);
+    report("number_classify_reparse_reference", in.size(), numberBytes(), times);
+}
+
+UTIL_BENCHMARK(number_scan)
+{
+    const auto &in  = numberCells();
+    long double sum = 0.0L;
+    NumberValue value;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         sum = 0.0L;
+         for(const auto &cell: in)
+         {
+             NumberClass numClass = scanNumberString(cell, value);
+             sum += numClass == INT ? value.intValue : value.floatValue;
+         }
+     });
+    doNotOptimize(sum);
+    report("number_scan", in.size(), numberBytes(), times);
+}
+
+UTIL_BENCHMARK(number_scan_column)
+{
+    vector<string_view> in(numberCells().begin(), numberCells().end());
+    vector<NumberValue> values;
+    NumberClass         numClass = NONE;
+
+    run_times times = sampleSeconds([&] { numClass = scanNumberStrings(in, values); });
+    doNotOptimize(values);
+    if(numClass != FLOAT)
+        throw logic_error("number_scan_column: mixed column not classified FLOAT");
+    report("number_scan_column", in.size(), numberBytes(), times);
+}
+
+UTIL_BENCHMARK(bool_token_map_reference)
+{
+    benchBool("bool_token_map_reference", [](const string &cell, bool &result) { return (scanBoolReference(cell, result)); });
+}
+
+UTIL_BENCHMARK(bool_token_perfect_hash)
+{
+    benchBool("bool_token_perfect_hash", [](const string &cell, bool &result) { return (scanBoolString(cell, result)); });
+}
+
+UTIL_BENCHMARK(bool_token_perfect_hash_with_user_tokens)
+{
+    addBoolToken("ja", true);
+    addBoolToken("nein", false);
+    benchBool("bool_token_perfect_hash_with_user_tokens",
+              [](const string &cell, bool &result) { return (scanBoolString(cell, result)); });
+    resetBoolTokens();
+}
+
+UTIL_BENCHMARK(keyword_search_find_reference)
+{
+    benchSearch("keyword_search_find_reference",
+                [](const string &line)
+                {
+                    size_t reval = 0;
+                    for(const auto &keyword: keywords())
+                    {
+                        for(size_t pos = line.find(keyword); pos != string::npos; pos = line.find(keyword, pos + 1))
+                            reval++;
+                    }
+                    return (reval);
+                });
+}
+
+UTIL_BENCHMARK(keyword_search_aho_corasick)
+{
+    aho_corasick ac(keywords());
+    benchSearch("keyword_search_aho_corasick",
+                [&ac](const string &line)
+                {
+                    size_t reval = 0;
+                    ac.forEachMatch(line, [&reval](const substring_match &) { reval++; });
+                    return (reval);
+                });
+}
+
+UTIL_BENCHMARK(keyword_search_aho_corasick_ci)
+{
+    aho_corasick ac(keywords(), true);
+    benchSearch("keyword_search_aho_corasick_ci",
+                [&ac](const string &line)
+                {
+                    size_t reval = 0;
+                    ac.forEachMatch(line, [&reval](const substring_match &) { reval++; });
+                    return (reval);
+                });
+}
+
+UTIL_BENCHMARK(keyword_search_aho_corasick_stream)
+{
+    aho_corasick ac(keywords());
+    benchSearch("keyword_search_aho_corasick_stream",
+                [matcher = aho_corasick::stream(ac)](const string &line) mutable
+                {
+                    size_t reval = 0;
+                    matcher.feed(line, [&reval](const substring_match &) { reval++; });
+                    return (reval);
+                });
+}
+
+UTIL_BENCHMARK(report_stringstream_reference)
+{
+    const auto &rows = reportRows();
+    string      text;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         text.clear();
+         for(const auto &row: rows)
+         {
+             text += asStringReference(row.id) + "," + enclosedReference(row.name, "\"", "\"") + ","
+                       + asStringReference(row.value) + "," + enclosedReference(row.tags, "[", "]") + "\n";
+         }
+     });
+    doNotOptimize(text);
+    report("report_stringstream_reference", rows.size(), text.size(), times);
+}
+
+UTIL_BENCHMARK(report_string_builder)
+{
+    const auto    &rows = reportRows();
+    string_builder sb;
+
+    run_times times = sampleSeconds(
+     [&]
+     {
+         sb.clear();
+         for(const auto &row: rows)
+         {
+             sb << row.id << ',';
+             util::quoted(sb, row.name) << ',' << row.value << ',';
+             bracketed(sb, row.tags) << '\n';
+         }
+     });
+    doNotOptimize(sb);
+    report("report_string_builder", rows.size(), sb.size(), times);
+}
+
+UTIL_BENCHMARK(report_nested_container)
+{
+    map<string, vector<double>> nested;
+    for(const auto &row: reportRows())
+        nested[row.name + to_string(row.id % 1000)].push_back(row.value);
+
+    string    text;
+    run_times times = sampleSeconds([&] { text = asString(nested); });
+    doNotOptimize(text);
+    report("report_nested_container", reportRows().size(), text.size(), times);
+}
+
+UTIL_BENCHMARK(report_nested_container_stream_reference)
+{
+    map<string, vector<double>> nested;
+    for(const auto &row: reportRows())
+        nested[row.name + to_string(row.id % 1000)].push_back(row.value);
+
+    string    text;
+    run_times times = sampleSeconds([&] { text = asStringReference(nested); });
+    doNotOptimize(text);
+    report("report_nested_container_stream_reference", reportRows().size(), text.size(), times);
+}
+
+namespace
+{
+/**
+ * Mostly ASCII text with some accented letters, or text in Greek and Cyrillic.
+ */
+const string &utf8Text(bool mostlyAscii)
+{
+    static const string asciiText = []
+    {
+        const char *words[] = {"Stra\u00dfe", "M\u00fcnchen", "caf\u00e9", "Report", "of", "the",
+                               "quarterly", "RESULTS", "for", "all", "regions", "and", "\u00c5RHUS"};
+        string      reval;
+        for(size_t i = 0; reval.size() < problemSize(1 << 22, 1 << 16); i++)
+            reval += string(words[(i * 7) % 13]) + ' ';
+        return (reval);
+    }();
+    static const string mixedText = []
+    {
+        const char *words[] = {"\u039f\u0394\u03a5\u03a3\u03a3\u0395\u03a5\u03a3", "\u03bb\u03cc\u03b3\u03bf\u03c2",
+                               "\u041f\u0440\u0438\u0432\u0435\u0442", "\u041c\u041e\u0421\u041a\u0412\u0410", "and"};
+        string      reval;
+        for(size_t i = 0; reval.size() < problemSize(1 << 22, 1 << 16); i++)
+            reval += string(words[(i * 3) % 5]) + ' ';
+        return (reval);
+    }();
+
+    return (mostlyAscii ? asciiText : mixedText);
+}
+
+/**
+ * Validate byte by byte through the C library.
+ */
+bool isValidUtf8Reference(const string &text)
+{
+    mbstate_t state{};
+    for(size_t i = 0; i < text.size();)
+    {
+        size_t length = mbrtowc(nullptr, text.data() + i, text.size() - i, &state);
+        if(length == size_t(-1) || length == size_t(-2))
+            return (false);
+        i += max(size_t(1), length);
+    }
+
+    return (true);
+}
+
+/**
+ * Lower case through the wide character functions of the C library.
+ */
+string utf8ToLowerReference(const string &text)
+{
+    string    reval;
+    mbstate_t in{};
+    mbstate_t out{};
+    char      buffer[MB_LEN_MAX];
+    for(size_t i = 0; i < text.size();)
+    {
+        wchar_t c;
+        size_t  length = mbrtowc(&c, text.data() + i, text.size() - i, &in);
+        if(length == size_t(-1) || length == size_t(-2))
+        {
+            reval += text[i++];
+            in = mbstate_t{};
+            continue;
+        }
+        reval.append(buffer, wcrtomb(buffer, towlower(c), &out));
+        i += max(size_t(1), length);
+    }
+
+    return (reval);
+}
+
+struct Utf8Locale
+{
+    Utf8Locale()
+    : previous_(setlocale(LC_CTYPE, nullptr))
+    {
+        setlocale(LC_CTYPE, "C.UTF-8");
+    }
+
+    ~Utf8Locale()
+    {
+        setlocale(LC_CTYPE, previous_.c_str());
+    }
+
+    string previous_;
+};
+};
+// namespace
+
+UTIL_BENCHMARK(utf8_validate)
+{
+    for(bool mostlyAscii: {true, false})
+    {
+        const string &text  = utf8Text(mostlyAscii);
+        bool          valid = false;
+        run_times     times = sampleSeconds([&] { valid = isValidUtf8(text); });
+        doNotOptimize(valid);
+        report(mostlyAscii ? "utf8_validate_ascii" : "utf8_validate_mixed", text.size(), text.size(), times);
+    }
+}
+
+UTIL_BENCHMARK(utf8_validate_mbrtowc_reference)
+{
+    Utf8Locale locale;
+    for(bool mostlyAscii: {true, false})
+    {
+        const string &text  = utf8Text(mostlyAscii);
+        bool          valid = false;
+        run_times     times = sampleSeconds([&] { valid = isValidUtf8Reference(text); });
+        doNotOptimize(valid);
+        report(mostlyAscii ? "utf8_validate_mbrtowc_reference_ascii" : "utf8_validate_mbrtowc_reference_mixed",
+               text.size(),
+               text.size(),
+               times);
+    }
+}
+
+UTIL_BENCHMARK(utf8_to_lower)
+{
+    for(bool mostlyAscii: {true, false})
+    {
+        const string &text = utf8Text(mostlyAscii);
+        string        lower;
+        run_times     times = sampleSeconds([&] { lower = utf8ToLower(text); });
+        doNotOptimize(lower);
+        report(mostlyAscii ? "utf8_to_lower_ascii" : "utf8_to_lower_mixed", text.size(), text.size(), times);
+    }
+}
+
+UTIL_BENCHMARK(utf8_to_lower_towlower_reference)
+{
+    Utf8Locale locale;
+    for(bool mostlyAscii: {true, false})
+    {
+        const string &text = utf8Text(mostlyAscii);
+        string        lower;
+        run_times     times = sampleSeconds([&] { lower = utf8ToLowerReference(text); });
+        doNotOptimize(lower);
+        report(mostlyAscii ? "utf8_to_lower_towlower_reference_ascii" : "utf8_to_lower_towlower_reference_mixed",
+               text.size(),
+               text.size(),
+               times);
+    }
+}
+
+UTIL_BENCHMARK(utf8_equals_ignore_case)
+{
+    const string &text  = utf8Text(false);
+    string        upper = utf8ToUpper(text);
+    bool          equal = false;
+    run_times     times = sampleSeconds([&] { equal = utf8EqualsIgnoreCase(text, upper); });
+    doNotOptimize(equal);
+    report("utf8_equals_ignore_case_mixed", text.size(), text.size(), times);
+}
@@ -0,0 +1,161 @@
+/*
+ * File:        tinyteaBench.cc
+ * Description: Benchmarks for TEA/XTEA buffer encryption
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <string>
+#include <tinytea.h>
+#include <vector>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+namespace
+{
+constexpr uint64_t benchKey1  = 0x0123456789ABCDEFULL;
+constexpr uint64_t benchKey2  = 0xFEDCBA9876543210ULL;
+constexpr uint64_t benchNonce = 0x5EED5EED00000000ULL;
+
+vector<byte> &records()
+{
+    static vector<byte> reval(problemSize(64UL << 20, 1UL << 20));
+
+    return (reval);
+}
+
+/**
+ * Counter mode one block at a time with tinyTea.
+ */
+void ctrReference(span<byte> data)
+{
+    for(size_t i = 0; i < data.size(); i += sizeof(uint64_t))
+    {
+        uint64_t key = tinyTea<>::encrypt(benchNonce + i / sizeof(uint64_t), benchKey1, benchKey2);
+        uint64_t word;
+        memcpy(&word, data.data() + i, sizeof(word));
+        word ^= key;
+        memcpy(data.data() + i, &word, sizeof(word));
+    }
+}
+};
+// namespace
+
+UTIL_BENCHMARK(tea_ctr_block_reference)
+{
+    auto     &data  = records();
+    run_times times = sampleSeconds([&] { ctrReference(data); });
+    doNotOptimize(data);
+    report("tea_ctr_block_reference", data.size(), data.size(), times);
+}
+
+namespace
+{
+string kernelName(TeaKernel kernel)
+{
+    return (kernel == TeaKernel::SCALAR ? "scalar" : kernel == TeaKernel::SSE2 ? "sse2" : "avx2");
+}
+};
+// namespace
+
+UTIL_BENCHMARK(tea_blocks)
+{
+    auto            &data = records();
+    span<uint64_t>   blocks(reinterpret_cast<uint64_t *>(data.data()), data.size() / sizeof(uint64_t));
+    for(auto variant: {TeaVariant::TEA, TeaVariant::XTEA})
+    {
+        for(auto kernel: {TeaKernel::SCALAR, TeaKernel::SSE2, TeaKernel::AVX2})
+        {
+            if(!teaKernelSupported(kernel))
+                continue;
+            run_times times = sampleSeconds([&] { teaEncryptBlocks(blocks, benchKey1, benchKey2, variant, kernel); });
+            doNotOptimize(data);
+            report(string(variant == TeaVariant::TEA ? "tea" : "xtea") + "_blocks_" + kernelName(kernel),
+                   data.size(),
+                   data.size(),
+                   times);
+        }
+    }
+}
+
+UTIL_BENCHMARK(tea_ctr_buffers)
+{
+    // single-threaded: buffers below the threshold for the thread pool
+    constexpr size_t slice = 256UL << 10;
+
+    auto &data = records();
+    for(auto variant: {TeaVariant::TEA, TeaVariant::XTEA})
+    {
+        for(auto kernel: {TeaKernel::SCALAR, TeaKernel::SSE2, TeaKernel::AVX2})
+        {
+            if(!teaKernelSupported(kernel))
+                continue;
+
+            tea_ctr cipher(benchKey1, benchKey2, benchNonce, variant, kernel);
+            string  name = string(variant == TeaVariant::TEA ? "tea" : "xtea") + "_ctr_" + kernelName(kernel);
+
+            run_times times = sampleSeconds(
+             [&]
+             {
+                 for(size_t i = 0; i < data.size(); i += slice)
+                     cipher.apply(span<byte>(data).subspan(i, min(slice, data.size() - i)), i);
+             });
+            doNotOptimize(data);
+            report(name + "_single_thread", data.size(), data.size(), times);
+        }
+
+        tea_ctr   cipher(benchKey1, benchKey2, benchNonce, variant);
+        run_times times = sampleSeconds([&] { cipher.apply(data); });
+        doNotOptimize(data);
+        report(string(variant == TeaVariant::TEA ? "tea" : "xtea") + "_ctr_thread_pool",
+               data.size(),
+               data.size(),
+               times);
+    }
+}
+
+UTIL_BENCHMARK(tea_file_cipher_stream)
+{
+    // in-memory streams, so that the pipeline rather than the disk is measured
+    auto  &data = records();
+    string plain(reinterpret_cast<const char *>(data.data()), data.size());
+    for(size_t chunkSize: {64UL << 10, 1UL << 20})
+    {
+        tea_file_cipher cipher(benchKey1, benchKey2, TeaVariant::TEA, chunkSize);
+        run_times       times = sampleSeconds(
+         [&]
+         {
+             istringstream in(plain);
+             ostringstream out;
+             cipher.encryptStream(in, out, benchNonce);
+             doNotOptimize(out);
+         });
+        report("tea_file_cipher_chunk_" + to_string(chunkSize >> 10) + "k", data.size(), data.size(), times);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * File:        traceBackendBench.cc
+ * Description: Benchmarks of asynchronous tracing.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "benchutil.h"
+
+#include <cstdint>
+#include <string>
+#include <trace_backend.h>
+
+using namespace std;
+using namespace util;
+using namespace util::bench;
+
+UTIL_BENCHMARK(trace_record)
+{
+    const size_t n = problemSize(1'000'000, 10'000);
+
+    startTracing("/dev/null", size_t(1) << 24);
+    string    name  = "trace_record";
+    run_times times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < n; i++)
+             UTIL_TRACE_VALUES(TraceLevel::TRACE_INFO, i, name);
+         flushTracing();
+     });
+    report("trace_record", n, 0, times);
+    cout << "    " << times.median / n * 1e9 << " ns per record incl. draining, " << droppedTraceRecords() << " dropped"
+         << endl;
+
+    setTraceLevel(TraceLevel::TRACE_WARNING);
+    times = sampleSeconds(
+     [&]
+     {
+         for(size_t i = 0; i < n; i++)
+             UTIL_TRACE_VALUES(TraceLevel::TRACE_INFO, i, name);
+     });
+    report("trace_record_filtered", n, 0, times);
+    setTraceLevel(TraceLevel::TRACE_DEBUG);
+    stopTracing();
+}
@@ -105,8 +105,8 @@ using VAR_UINT = unsigned long long;
 
 /** The only floating point type allowed in Var-variants. */
 using VAR_FLOAT = long double;
-/** The only date type allowed in Var-variants. */
-using VAR_DATE = boost::posix_time::ptime;
+/** The only date type allowed in Var-variants (compact, integer-backed). */
+using VAR_DATE = epoch_date;
 
 /**The only character-string type allowed in Var-variants.*/
 using VAR_STRING = std::string;
@@ -150,7 +150,7 @@ inline T_ maxVal()
 template<>
 inline VAR_DATE minVal<VAR_DATE>()
 {
-    return (VAR_DATE(boost::posix_time::min_date_time));
+    return (VAR_DATE::minDate());
 }
 
 /**
@@ -160,7 +160,7 @@ inline VAR_DATE minVal<VAR_DATE>()
 template<>
 inline VAR_DATE maxVal<VAR_DATE>()
 {
-    return (VAR_DATE(boost::posix_time::max_date_time));
+    return (VAR_DATE::maxDate());
 }
 
 enum class borderType : unsigned char
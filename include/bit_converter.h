@@ -25,14 +25,90 @@
     #define NS_UTIL_BIT_CONVERTER_H_INCLUDED
 
     #include <algorithm>
+    #include <bit>
     #include <bitset>
+    #include <cstdint>
     #include <cstdlib>
+    #include <cstring>
     #include <initializer_list>
     #include <iostream>
     #include <limits.h>
+    #include <type_traits>
+    #if defined(__BMI2__)
+        #include <immintrin.h>
+    #endif
 
 namespace util
 {
+/**
+ * Reverse the order of the bytes of an unsigned integer (std::byteswap() before C++23).
+ */
+template<typename U_>
+constexpr U_ byteSwap(U_ value)
+{
+    static_assert(std::is_unsigned_v<U_>, "byteSwap() needs an unsigned integer type.");
+    if constexpr(sizeof(U_) == 1)
+        return (value);
+    else if constexpr(sizeof(U_) == 2)
+        return (__builtin_bswap16(value));
+    else if constexpr(sizeof(U_) == 4)
+        return (__builtin_bswap32(value));
+    else
+        return (__builtin_bswap64(value));
+}
+
+/**
+ * Gather the bits of value selected by mask into the low bits of the result (BMI2 PEXT).
+ */
+inline uint64_t extractBits(uint64_t value, uint64_t mask)
+{
+    #if defined(__BMI2__)
+    return (_pext_u64(value, mask));
+    #else
+    // contiguous runs of the mask are moved in one step
+    uint64_t reval = 0ULL;
+    int      width = 0;
+    while(mask != 0ULL)
+    {
+        int      low  = std::countr_zero(mask);
+        int      run  = std::countr_one(mask >> low);
+        uint64_t bits = (value >> low) & (run == 64 ? ~0ULL : (1ULL << run) - 1);
+        reval |= bits << width;
+        width += run;
+        mask &= (run + low == 64) ? 0ULL : ~0ULL << (run + low);
+    }
+    return (reval);
+    #endif
+}
+
+/**
+ * Scatter the low bits of value to the positions selected by mask (BMI2 PDEP).
+ */
+inline uint64_t depositBits(uint64_t value, uint64_t mask)
+{
+    #if defined(__BMI2__)
+    return (_pdep_u64(value, mask));
+    #else
+    uint64_t reval = 0ULL;
+    while(mask != 0ULL)
+    {
+        int      low  = std::countr_zero(mask);
+        int      run  = std::countr_one(mask >> low);
+        uint64_t bits = value & (run == 64 ? ~0ULL : (1ULL << run) - 1);
+        reval |= bits << low;
+        value = (run == 64) ? 0ULL : value >> run;
+        mask &= (run + low == 64) ? 0ULL : ~0ULL << (run + low);
+    }
+    return (reval);
+    #endif
+}
+
+/**
+ * Access the bits and bytes of a T_. Bit i is bit i % 8 of byte i / 8, so on little-endian
+ * machines bit i of an integer is bit i of the converter.
+ * Types of 1, 2, 4 or 8 bytes are handled as one unsigned machine word (WordType), all others
+ * byte by byte.
+ */
 template<typename T_>
 union bit_converter
 {
@@ -41,6 +117,12 @@ union bit_converter
     static constexpr long long BYTES_IN_DATA = (sizeof(DataType) / sizeof(uint8_t)) * BYTES_IN_CHAR;
     static constexpr long long BITS_IN_DATA  = BYTES_IN_DATA << 3;
 
+    static constexpr bool IS_WORD = BYTES_IN_DATA == 1 || BYTES_IN_DATA == 2 || BYTES_IN_DATA == 4 || BYTES_IN_DATA == 8;
+    using WordType                = std::conditional_t<
+     BYTES_IN_DATA == 1,
+     uint8_t,
+     std::conditional_t<BYTES_IN_DATA == 2, uint16_t, std::conditional_t<BYTES_IN_DATA == 4, uint32_t, uint64_t>>>;
+
     DataType data_;
     uint8_t  byte[BYTES_IN_DATA];
 
@@ -72,65 +154,247 @@ union bit_converter
         return (data_);
     }
 
+    /**
+     * The bytes as an unsigned word in bit order, i.e. little-endian (word types only).
+     */
+    WordType word() const
+    {
+        static_assert(IS_WORD, "word() needs a data type of 1, 2, 4 or 8 bytes.");
+        WordType reval;
+        std::memcpy(&reval, byte, sizeof(reval));
+        if constexpr(std::endian::native == std::endian::big)
+            reval = byteSwap(reval);
+
+        return (reval);
+    }
+
+    void setWord(WordType w)
+    {
+        static_assert(IS_WORD, "setWord() needs a data type of 1, 2, 4 or 8 bytes.");
+        if constexpr(std::endian::native == std::endian::big)
+            w = byteSwap(w);
+        std::memcpy(byte, &w, sizeof(w));
+    }
+
     template<long long NumberOfBits_ = BITS_IN_DATA>
     std::bitset<NumberOfBits_> asBitset(long long StartBit_ = 0LL) const
     {
         static_assert(NumberOfBits_ > 0, "Number of requested bits needs to be greater than 0.");
-        std::bitset<BITS_IN_DATA> allbits(0ULL);
 
-        for(size_t ullCount = BYTES_IN_DATA; ullCount > 0; ullCount--)
+        if constexpr(IS_WORD)
+        {
+            if(StartBit_ >= BITS_IN_DATA || StartBit_ <= -NumberOfBits_)
+                return (std::bitset<NumberOfBits_>());
+            if(StartBit_ >= 0LL)
+                return (std::bitset<NumberOfBits_>(static_cast<unsigned long long>(word() >> StartBit_)));
+            return (std::bitset<NumberOfBits_>(static_cast<unsigned long long>(word())) << -StartBit_);
+        }
+        else
         {
-            allbits <<= CHAR_BIT;
-            allbits |= std::bitset<BITS_IN_DATA>(byte[ullCount - 1]);
+            std::bitset<NumberOfBits_> reval;
+
+            for(long long i = 0; i < NumberOfBits_; i++)
+            {
+                long long allIdx = (i + StartBit_);
+                if(allIdx >= 0LL && allIdx < BITS_IN_DATA)
+                    reval[i] = getBit(allIdx);
+            }
+
+            return (reval);
         }
+    }
 
-        std::bitset<NumberOfBits_> reval;
+    /**
+     * Rotate the bits towards bit 0 by bitsToShift, towards the top for negative values.
+     */
+    void rotate(long long bitsToShift)
+    {
+        bitsToShift %= BITS_IN_DATA;
+        if(bitsToShift == 0LL)
+            return;
 
-        for(long long i = 0; i < NumberOfBits_; i++)
+        if constexpr(IS_WORD)
+        {
+            setWord(std::rotr(word(), static_cast<int>(bitsToShift)));
+        }
+        else
         {
-            long long allIdx = (i + StartBit_);
-            if(allIdx >= 0LL && allIdx < BITS_IN_DATA)
+            if(bitsToShift < 0LL)
+                bitsToShift += BITS_IN_DATA;
+
+            // whole bytes first, then the remaining bits across byte boundaries
+            std::rotate(byte, byte + bitsToShift / CHAR_BIT, byte + BYTES_IN_DATA);
+            int bits = static_cast<int>(bitsToShift % CHAR_BIT);
+            if(bits != 0)
             {
-                reval[i] = allbits[allIdx];
+                uint8_t first = byte[0];
+                for(long long i = 0; i < BYTES_IN_DATA - 1; i++)
+                    byte[i] = static_cast<uint8_t>((byte[i] >> bits) | (byte[i + 1] << (CHAR_BIT - bits)));
+                byte[BYTES_IN_DATA - 1] = static_cast<uint8_t>((byte[BYTES_IN_DATA - 1] >> bits) |
+                                                               (first << (CHAR_BIT - bits)));
             }
         }
+    }
 
-        return (reval);
+    void rotateLeft(long long bitsToShift)
+    {
+        rotate(-(bitsToShift % BITS_IN_DATA));
     }
 
-    void rotate(long long bitsToShift)
+    void rotateRight(long long bitsToShift)
+    {
+        rotate(bitsToShift);
+    }
+
+    /**
+     * Number of set bits.
+     */
+    int popCount() const
     {
-        if(bitsToShift != 0LL)
+        if constexpr(IS_WORD)
+        {
+            return (std::popcount(word()));
+        }
+        else
         {
-            std::bitset<BITS_IN_DATA> allBits = asBitset();
-            bool                      toLeft  = (bitsToShift < 0);
+            int reval = 0;
+            for(long long i = 0; i < BYTES_IN_DATA; i++)
+                reval += std::popcount(byte[i]);
+            return (reval);
+        }
+    }
 
-            bitsToShift %= BITS_IN_DATA;
+    /**
+     * Index of the lowest set bit, BITS_IN_DATA if none is set.
+     */
+    int countTrailingZeros() const
+    {
+        if constexpr(IS_WORD)
+        {
+            return (std::countr_zero(word()));
+        }
+        else
+        {
+            for(long long i = 0; i < BYTES_IN_DATA; i++)
+                if(byte[i] != 0)
+                    return (static_cast<int>(i * CHAR_BIT) + std::countr_zero(byte[i]));
+            return (static_cast<int>(BITS_IN_DATA));
+        }
+    }
 
-            for(long long shiftCount = 0; shiftCount < std::abs(bitsToShift); shiftCount++)
-            {
-                bool extremeIsSet = (toLeft) ? allBits[BITS_IN_DATA - 1] : allBits[0];
-                if(toLeft)
-                {
-                    allBits <<= 1;
-                    allBits.set(0, extremeIsSet);
-                }
-                else
-                {
-                    allBits >>= 1;
-                    allBits.set(BITS_IN_DATA - 1, extremeIsSet);
-                }
-            }
+    /**
+     * Number of clear bits above the highest set bit, BITS_IN_DATA if none is set.
+     */
+    int countLeadingZeros() const
+    {
+        if constexpr(IS_WORD)
+        {
+            return (std::countl_zero(word()));
+        }
+        else
+        {
+            for(long long i = BYTES_IN_DATA; i > 0; i--)
+                if(byte[i - 1] != 0)
+                    return (static_cast<int>((BYTES_IN_DATA - i) * CHAR_BIT) + std::countl_zero(byte[i - 1]));
+            return (static_cast<int>(BITS_IN_DATA));
+        }
+    }
 
-            static constexpr std::bitset<BITS_IN_DATA> mask = (static_cast<unsigned long long>(-1));
+    /**
+     * Reverse the order of the bytes.
+     */
+    void swapBytes()
+    {
+        if constexpr(IS_WORD)
+            setWord(byteSwap(word()));
+        else
+            std::reverse(byte, byte + BYTES_IN_DATA);
+    }
 
-            for(size_t ullCount = 0; ullCount < BITS_IN_DATA; ullCount++)
-            {
-                setBit(ullCount, allBits[ullCount]);
-            }
+    /**
+     * Convert between native and the given byte order, e.g. for data read from or written to the
+     * network in big-endian order. Does nothing if order is the native one.
+     */
+    void convertByteOrder(std::endian order)
+    {
+        if(order != std::endian::native)
+            swapBytes();
+    }
+
+    /**
+     * The count (at most 64) bits starting at bit startBit as an unsigned integer; the field must
+     * lie within the data.
+     */
+    uint64_t getBits(long long startBit, long long count) const
+    {
+        uint64_t mask = (count >= 64) ? ~0ULL : (1ULL << count) - 1;
+
+        if constexpr(IS_WORD)
+        {
+            return ((static_cast<uint64_t>(word()) >> startBit) & mask);
+        }
+        else
+        {
+            // load the (up to nine) bytes covering the field
+            long long   first = startBit / CHAR_BIT;
+            long long   last  = std::min(BYTES_IN_DATA, (startBit + count + CHAR_BIT - 1) / CHAR_BIT);
+            int         shift = static_cast<int>(startBit % CHAR_BIT);
+            __uint128_t bits  = 0;
+            for(long long i = last; i > first; i--)
+                bits = (bits << CHAR_BIT) | byte[i - 1];
+
+            return (static_cast<uint64_t>(bits >> shift) & mask);
         }
     }
 
+    /**
+     * Replace the count (at most 64) bits starting at bit startBit by the low bits of value; the
+     * field must lie within the data.
+     */
+    void setBits(long long startBit, long long count, uint64_t value)
+    {
+        uint64_t mask = (count >= 64) ? ~0ULL : (1ULL << count) - 1;
+
+        if constexpr(IS_WORD)
+        {
+            WordType w = word();
+            w          = static_cast<WordType>((w & ~(mask << startBit)) | ((value & mask) << startBit));
+            setWord(w);
+        }
+        else
+        {
+            long long   first  = startBit / CHAR_BIT;
+            long long   last   = std::min(BYTES_IN_DATA, (startBit + count + CHAR_BIT - 1) / CHAR_BIT);
+            int         shift  = static_cast<int>(startBit % CHAR_BIT);
+            __uint128_t bits   = 0;
+            __uint128_t field  = static_cast<__uint128_t>(mask) << shift;
+            __uint128_t update = static_cast<__uint128_t>(value & mask) << shift;
+            for(long long i = last; i > first; i--)
+                bits = (bits << CHAR_BIT) | byte[i - 1];
+            bits = (bits & ~field) | update;
+            for(long long i = first; i < last; i++, bits >>= CHAR_BIT)
+                byte[i] = static_cast<uint8_t>(bits);
+        }
+    }
+
+    /**
+     * The bits selected by mask, packed into the low bits of the result (see extractBits()).
+     */
+    uint64_t extract(uint64_t mask) const
+    {
+        static_assert(IS_WORD, "extract() needs a data type of 1, 2, 4 or 8 bytes.");
+        return (extractBits(word(), mask));
+    }
+
+    /**
+     * Replace the bits selected by mask by the low bits of value (see depositBits()).
+     */
+    void insert(uint64_t mask, uint64_t value)
+    {
+        static_assert(IS_WORD, "insert() needs a data type of 1, 2, 4 or 8 bytes.");
+        setWord(static_cast<WordType>((word() & ~mask) | depositBits(value, mask)));
+    }
+
     uint8_t& operator[](long long n)
     {
         return (byte[n]);
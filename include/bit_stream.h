@@ -0,0 +1,358 @@
+/*
+ * File:        bit_stream.h
+ * Description: Read and write streams of packed N-bit fields.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_BIT_STREAM_H_INCLUDED
+#define NS_UTIL_BIT_STREAM_H_INCLUDED
+
+#include <algorithm>
+#include <bit>
+#include <bit_converter.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace util
+{
+/**
+ * Fields are packed back to back without padding, in one of two orders:
+ * <ul>
+ * <li>std::endian::little: least significant bit first; bit k of the stream is bit k % 8 of
+ *     byte k / 8, as in bit_converter.</li>
+ * <li>std::endian::big: most significant bit first; bit k of the stream is bit 7 - k % 8 of
+ *     byte k / 8, as in network protocols.</li>
+ * </ul>
+ * Fields are 1 to 64 bits wide.
+ */
+
+/**
+ * Bytes needed for count fields of the given width.
+ */
+inline size_t packedSize(size_t count, unsigned bits)
+{
+    return ((count * bits + 7) / 8);
+}
+
+/**
+ * The eight bytes of data from byteIndex on, padded with zeros at the end of data.
+ */
+inline bit_converter<uint64_t> loadBitWindow(std::span<const std::byte> data, size_t byteIndex)
+{
+    bit_converter<uint64_t> reval = 0ULL;
+    size_t                  avail = data.size() > byteIndex ? data.size() - byteIndex : 0;
+    std::memcpy(reval.byte, data.data() + byteIndex, std::min(avail, sizeof(uint64_t)));
+
+    return (reval);
+}
+
+/**
+ * The field of the given width at bitPosition of data. The field must lie within data.
+ */
+inline uint64_t peekBits(std::span<const std::byte> data,
+                         size_t                     bitPosition,
+                         unsigned                   bits,
+                         std::endian                order = std::endian::little)
+{
+    unsigned shift = bitPosition % 8;
+
+    if(shift + bits > 64)
+    {
+        // cannot be loaded as one word: the upper and lower part
+        if(order == std::endian::little)
+            return (peekBits(data, bitPosition, 32, order) | peekBits(data, bitPosition + 32, bits - 32, order) << 32);
+        return (peekBits(data, bitPosition, bits - 32, order) << 32 | peekBits(data, bitPosition + bits - 32, 32, order));
+    }
+
+    bit_converter<uint64_t> window = loadBitWindow(data, bitPosition / 8);
+    if(order == std::endian::little)
+        return (window.getBits(shift, bits));
+    window.swapBytes();
+
+    return (window.getBits(64 - shift - bits, bits));
+}
+
+/**
+ * Replace the field of the given width at bitPosition of data by the low bits of value. The
+ * field must lie within data.
+ */
+inline void pokeBits(std::span<std::byte> data,
+                     size_t               bitPosition,
+                     unsigned             bits,
+                     uint64_t             value,
+                     std::endian          order = std::endian::little)
+{
+    unsigned shift = bitPosition % 8;
+
+    if(shift + bits > 64)
+    {
+        if(order == std::endian::little)
+        {
+            pokeBits(data, bitPosition, 32, value, order);
+            pokeBits(data, bitPosition + 32, bits - 32, value >> 32, order);
+        }
+        else
+        {
+            pokeBits(data, bitPosition, bits - 32, value >> 32, order);
+            pokeBits(data, bitPosition + bits - 32, 32, value, order);
+        }
+        return;
+    }
+
+    size_t                  byteIndex = bitPosition / 8;
+    bit_converter<uint64_t> window    = loadBitWindow(data, byteIndex);
+    if(order == std::endian::little)
+    {
+        window.setBits(shift, bits, value);
+    }
+    else
+    {
+        window.swapBytes();
+        window.setBits(64 - shift - bits, bits, value);
+        window.swapBytes();
+    }
+    std::memcpy(data.data() + byteIndex, window.byte, (shift + bits + 7) / 8);
+}
+
+/**
+ * Unpack out.size() fields of the given width from the start of in into out, 64-bit words at a
+ * time, and eight fields per AVX2 instruction sequence for fields of up to 16 bits unpacked
+ * into 32-bit integers.
+ * @throw std::invalid_argument if bits is not in 1..64 or wider than the elements of out
+ * @throw std::out_of_range if in is shorter than packedSize(out.size(), bits)
+ */
+void unpackBits(std::span<const std::byte> in,
+                unsigned                   bits,
+                std::span<uint8_t>         out,
+                std::endian                order = std::endian::little);
+void unpackBits(std::span<const std::byte> in,
+                unsigned                   bits,
+                std::span<uint16_t>        out,
+                std::endian                order = std::endian::little);
+void unpackBits(std::span<const std::byte> in,
+                unsigned                   bits,
+                std::span<uint32_t>        out,
+                std::endian                order = std::endian::little);
+void unpackBits(std::span<const std::byte> in,
+                unsigned                   bits,
+                std::span<uint64_t>        out,
+                std::endian                order = std::endian::little);
+
+/**
+ * Pack the low bits of each value of in into fields of the given width at the start of out,
+ * through a 64-bit accumulator. Bits of out after the last field are cleared up to the end of
+ * its byte.
+ * @throw std::invalid_argument if bits is not in 1..64
+ * @throw std::out_of_range if out is shorter than packedSize(in.size(), bits)
+ */
+void packBits(std::span<const uint8_t> in,
+              unsigned                 bits,
+              std::span<std::byte>     out,
+              std::endian              order = std::endian::little);
+void packBits(std::span<const uint16_t> in,
+              unsigned                  bits,
+              std::span<std::byte>      out,
+              std::endian               order = std::endian::little);
+void packBits(std::span<const uint32_t> in,
+              unsigned                  bits,
+              std::span<std::byte>      out,
+              std::endian               order = std::endian::little);
+void packBits(std::span<const uint64_t> in,
+              unsigned                  bits,
+              std::span<std::byte>      out,
+              std::endian               order = std::endian::little);
+
+/**
+ * Sequential reader of fields of any width from a buffer it does not own.
+ */
+class bit_reader
+{
+    public:
+    explicit bit_reader(std::span<const std::byte> data, std::endian order = std::endian::little)
+    : data_(data)
+    , order_(order)
+    {
+    }
+
+    /**
+     * The next field of the given width (1..64 bits).
+     * @throw std::out_of_range if fewer than bits bits remain
+     */
+    uint64_t read(unsigned bits)
+    {
+        checkRemaining(bits);
+        uint64_t reval = peekBits(data_, position_, bits, order_);
+        position_ += bits;
+
+        return (reval);
+    }
+
+    /**
+     * The next out.size() fields of the given width; in bulk if the reader is at a byte boundary.
+     * @throw std::out_of_range if too few bits remain
+     */
+    template<typename T_>
+    void read(unsigned bits, std::span<T_> out)
+    {
+        checkRemaining(out.size() * bits);
+        if(position_ % 8 == 0)
+            unpackBits(data_.subspan(position_ / 8), bits, out, order_);
+        else
+            for(auto &v: out)
+                v = static_cast<T_>(peekBits(data_, position_ + (&v - out.data()) * bits, bits, order_));
+        position_ += out.size() * bits;
+    }
+
+    /**
+     * Skip to the next byte boundary.
+     */
+    void align()
+    {
+        position_ = std::min(size(), (position_ + 7) / 8 * 8);
+    }
+
+    void seek(size_t bitPosition)
+    {
+        if(bitPosition > size())
+            throw std::out_of_range("bit_reader::seek() beyond the end of the data");
+        position_ = bitPosition;
+    }
+
+    /**
+     * Bit position of the next field.
+     */
+    size_t position() const
+    {
+        return (position_);
+    }
+
+    /**
+     * Size of the data in bits.
+     */
+    size_t size() const
+    {
+        return (data_.size() * 8);
+    }
+
+    size_t remaining() const
+    {
+        return (size() - position_);
+    }
+
+    private:
+    void checkRemaining(size_t bits) const
+    {
+        if(bits > remaining())
+            throw std::out_of_range("bit_reader: " + std::to_string(bits) + " bits requested but only " +
+                                    std::to_string(remaining()) + " remain");
+    }
+
+    std::span<const std::byte> data_;
+    std::endian                order_;
+    size_t                     position_ = 0;
+};
+
+/**
+ * Writer of fields of any width into a growing buffer.
+ */
+class bit_writer
+{
+    public:
+    explicit bit_writer(std::endian order = std::endian::little)
+    : order_(order)
+    {
+    }
+
+    /**
+     * Append the low bits of value as a field of the given width (1..64 bits).
+     */
+    void write(uint64_t value, unsigned bits)
+    {
+        buffer_.resize((position_ + bits + 7) / 8);
+        pokeBits(buffer_, position_, bits, value, order_);
+        position_ += bits;
+    }
+
+    /**
+     * Append fields of the given width; in bulk if the writer is at a byte boundary.
+     */
+    template<typename T_>
+    void write(std::span<const T_> values, unsigned bits)
+    {
+        size_t start = position_;
+        buffer_.resize((position_ + values.size() * bits + 7) / 8);
+        if(start % 8 == 0)
+            packBits(values, bits, std::span<std::byte>(buffer_).subspan(start / 8), order_);
+        else
+            for(size_t i = 0; i < values.size(); i++)
+                pokeBits(buffer_, start + i * bits, bits, values[i], order_);
+        position_ += values.size() * bits;
+    }
+
+    template<typename T_>
+    void write(const std::vector<T_> &values, unsigned bits)
+    {
+        write(std::span<const T_>(values), bits);
+    }
+
+    /**
+     * Pad with zero bits to the next byte boundary.
+     */
+    void align()
+    {
+        position_ = (position_ + 7) / 8 * 8;
+    }
+
+    /**
+     * The bytes written so far; the last one is padded with zero bits.
+     */
+    std::span<const std::byte> bytes() const
+    {
+        return (buffer_);
+    }
+
+    /**
+     * Number of bits written.
+     */
+    size_t position() const
+    {
+        return (position_);
+    }
+
+    void clear()
+    {
+        buffer_.clear();
+        position_ = 0;
+    }
+
+    private:
+    std::vector<std::byte> buffer_;
+    std::endian            order_;
+    size_t                 position_ = 0;
+};
+};
+// namespace util
+
+#endif  // NS_UTIL_BIT_STREAM_H_INCLUDED
@@ -25,6 +25,8 @@
 #ifndef NS_UTIL_CONTANTS_H_INCLUDED
 #define NS_UTIL_CONTANTS_H_INCLUDED
 
+#include <cstdint>
+
 // Pi~31415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679
 const constexpr int64_t MICRO_RAD_PI      = 3'141'592LL;
 const constexpr int64_t MICRO_RAD_2PI_MIN = 0LL;
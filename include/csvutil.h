@@ -233,6 +233,12 @@ class CSVAnalyzer
      */
     static std::string guessType(const std::string &stringVal);
 
+    /**
+     * Guess the type of a value and keep its number (see scanNumberString()), so that numeric
+     * cells need not be scanned again for conversion.
+     */
+    static std::string guessType(const std::string &stringVal, NumberValue &number);
+
     /**
      * Set header-strings to unique default-headers per column.
      */
@@ -244,6 +250,12 @@ class CSVAnalyzer
      */
     bool createTypesFromValues(const std::vector<std::string> &values);
 
+    /**
+     * Guess the column types from a row of value strings and keep the number of each value in
+     * numbers (resized to the size of values).
+     */
+    bool createTypesFromValues(const std::vector<std::string> &values, std::vector<NumberValue> &numbers);
+
     /**
      * Retrieve the configured separator string used for output.
      */
@@ -26,13 +26,20 @@
 #define NS_UTIL_DATEUTIL_H_INCLUDED
 
 #include <algorithm>
+#include <atomic>
 #include <boost/date_time.hpp>  // gregorian dates/posix time/...
-#include <ctime>                // for struct tm
+#include <chrono>
+#include <cstdint>
+#include <ctime>  // for struct tm
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace util
@@ -52,7 +59,62 @@ namespace datescan
         European,
         USA
     };
-    extern std::vector<std::locale> formats;  ///< A sequence of formats a string is tested against.
+
+    /**
+     *  A sequence of formats a string is tested against.
+     */
+    using DateFormats = std::vector<std::locale>;
+
+    /**
+     *  Immutable, reference-counted snapshot of a format sequence. Readers keep
+     *  a snapshot alive for as long as they use it, writers never modify a
+     *  published snapshot but publish a new one (read-copy-update).
+     */
+    using DateFormatsPtr = std::shared_ptr<const DateFormats>;
+
+    /**
+     *  Get the currently published snapshot of the global date-formats.
+     */
+    DateFormatsPtr currentDateFormats();
+
+    /**
+     *  Atomically publish a new set of global date-formats.
+     */
+    void setDateFormats(DateFormats fmts);
+
+    /**
+     *  Per-thread parsing state: one input stream per format of a snapshot,
+     *  imbued once and re-used for every string scanned. The context picks up
+     *  a newly published global snapshot on the next scan, but never blocks
+     *  or races with writers. A context must not be shared between threads.
+     */
+    class DateParseContext
+    {
+        public:
+        DateParseContext() = default;
+
+        /**
+         *  Use a fixed set of formats rather than the global ones.
+         */
+        explicit DateParseContext(DateFormatsPtr fmts);
+
+        DateParseContext(const DateParseContext &) = delete;
+        DateParseContext &operator=(const DateParseContext &) = delete;
+
+        /**
+         *  Scan/parse a string into a date using the formats of this context.
+         */
+        val::ptime scan(const std::string &s);
+
+        private:
+        void refresh();
+        void imbueStreams();
+
+        bool                                             followGlobal_ = true;
+        unsigned long                                    version_      = 0;
+        DateFormatsPtr                                   formats_;
+        std::vector<std::unique_ptr<std::istringstream>> streams_;
+    };
 
     /**
      *  Conversion of a boost::posix_time to a time_t.
@@ -65,7 +127,9 @@ namespace datescan
     time_t seconds_from_epoch(const std::string &s);
 
     /**
-     *  Scan/parse a string into a date.
+     *  Scan/parse a string into a date using the global formats and a
+     *  thread-local parse context. Safe to call concurrently with changes
+     *  to the global formats.
      */
     val::ptime scanDate(const std::string &s);
 
@@ -87,18 +151,33 @@ namespace datescan
     /**
      *  Add a format to the list of valid formats.
      */
-    void addDateFormat(const std::string &fmt, std::vector<std::locale> &formatVec = datescan::formats);
+    void addDateFormat(const std::string &fmt, DateFormats &formatVec);
+
+    /**
+     *  Add a format to the global formats (publishes a new snapshot).
+     */
+    void addDateFormat(const std::string &fmt);
 
     /**
      *  Initialise the list of valid formats to a set of commonly used ones.
      */
-    std::vector<std::locale> initDateFormats(DateFormatPreference      pref      = DateFormatPreference::European,
-                                             std::vector<std::locale> &formatVec = datescan::formats);
+    DateFormats initDateFormats(DateFormatPreference pref, DateFormats &formatVec);
+
+    /**
+     *  Initialise the global formats to a set of commonly used ones (publishes
+     *  a new snapshot).
+     */
+    DateFormats initDateFormats(DateFormatPreference pref = DateFormatPreference::European);
 
     /**
      *  Clear the list of all formats.
      */
-    void resetDateFormats(std::vector<std::locale> &fmts = datescan::formats);
+    void resetDateFormats(DateFormats &fmts);
+
+    /**
+     *  Clear the global formats (publishes an empty snapshot).
+     */
+    void resetDateFormats();
 
     /**
      *  Create a time using year/month/day/hour/minute/seconds/milliseconds
@@ -125,6 +204,417 @@ inline bool valid(const val::ptime &pt)
 {
     return (!pt.is_infinity() && !pt.is_not_a_date_time() && (pt.date().year() >= 1900) && (pt.date().year() <= 2200));
 }
+
+/**
+ *  Number of days between 1970-01-01 and the proleptic gregorian date y-m-d.
+ *  Branch-free "days from civil" algorithm (H. Hinnant), valid for all years
+ *  representable in an int.
+ */
+constexpr std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const auto         yoe = static_cast<unsigned>(y - era * 400);             // [0, 399]
+    const unsigned     doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;  // [0, 365]
+    const unsigned     doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;            // [0, 146096]
+
+    return (era * 146097 + static_cast<std::int64_t>(doe) - 719468);
+}
+
+/**
+ *  Proleptic gregorian year/month/day.
+ */
+struct civil_date
+{
+    std::int64_t year;
+    unsigned     month;  ///< [1, 12]
+    unsigned     day;    ///< [1, 31]
+};
+
+/**
+ *  Inverse of daysFromCivil(): the civil date that lies z days after
+ *  1970-01-01. Branch-free "civil from days" algorithm (H. Hinnant).
+ */
+constexpr civil_date civilFromDays(std::int64_t z)
+{
+    z += 719468;
+    const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto         doe = static_cast<unsigned>(z - era * 146097);                 // [0, 146096]
+    const unsigned     yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    const unsigned     doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                // [0, 365]
+    const unsigned     mp  = (5 * doy + 2) / 153;                                    // [0, 11]
+    const unsigned     d   = doy - (153 * mp + 2) / 5 + 1;                           // [1, 31]
+    const unsigned     m   = mp < 10 ? mp + 3 : mp - 9;                              // [1, 12]
+
+    return (civil_date{static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2), m, d});
+}
+
+/**
+ *  Compact date-time: a signed 64-bit count of microseconds since
+ *  1970-01-01 00:00:00.
+ *  All comparisons and arithmetic are plain integer operations. The special
+ *  values of boost::posix_time (not-a-date-time, -infinity, +infinity) are
+ *  encoded as reserved extreme tick-counts, so that they order consistently
+ *  (not-a-date-time &lt; -infinity &lt; any date &lt; +infinity).
+ */
+class epoch_date
+{
+    public:
+    using rep_type = std::int64_t;
+
+    static constexpr rep_type ticks_per_second = 1000000LL;
+    static constexpr rep_type ticks_per_day    = 86400LL * ticks_per_second;
+    static constexpr rep_type not_a_date_ticks = std::numeric_limits<rep_type>::min();
+    static constexpr rep_type neg_infin_ticks  = not_a_date_ticks + 1;
+    static constexpr rep_type pos_infin_ticks  = std::numeric_limits<rep_type>::max();
+
+    /**
+     * Default construct a not-a-date-time, like boost::posix_time::ptime.
+     */
+    constexpr epoch_date() = default;
+
+    /**
+     * Construct from a raw count of microseconds since the epoch.
+     */
+    constexpr explicit epoch_date(rep_type ticks) : ticks_(ticks)
+    {
+    }
+
+    /**
+     * Construct from a POSIX-time, special values are preserved.
+     */
+    epoch_date(const val::ptime &pt)
+    : ticks_(pt.is_not_a_date_time() ? not_a_date_ticks :
+             pt.is_neg_infinity()    ? neg_infin_ticks :
+             pt.is_pos_infinity()    ? pos_infin_ticks :
+                                       (pt - epochPtime()).total_microseconds())
+    {
+    }
+
+    /**
+     * Construct midnight of a gregorian date.
+     */
+    explicit epoch_date(const boost::gregorian::date &d) : epoch_date(val::ptime(d))
+    {
+    }
+
+    /**
+     * Create a date-time from its civil components at compile-time if required.
+     */
+    static constexpr epoch_date
+     fromCivil(int y, unsigned m, unsigned d, int H = 0, int M = 0, int S = 0, rep_type us = 0)
+    {
+        return (epoch_date(daysFromCivil(y, m, d) * ticks_per_day
+                           + ((H * 60LL + M) * 60LL + S) * ticks_per_second + us));
+    }
+
+    /**
+     * Create a date-time from seconds since the epoch.
+     */
+    static constexpr epoch_date fromTimeT(std::time_t secs)
+    {
+        return (epoch_date(static_cast<rep_type>(secs) * ticks_per_second));
+    }
+
+    /**
+     * Earliest date-time boost supports (1400-Jan-01 00:00:00).
+     */
+    static constexpr epoch_date minDate()
+    {
+        return (fromCivil(1400, 1, 1));
+    }
+
+    /**
+     * Latest date-time boost supports (9999-Dec-31 23:59:59.999999).
+     */
+    static constexpr epoch_date maxDate()
+    {
+        return (fromCivil(9999, 12, 31, 23, 59, 59, ticks_per_second - 1));
+    }
+
+    static constexpr epoch_date notADateTime()
+    {
+        return (epoch_date(not_a_date_ticks));
+    }
+
+    static constexpr epoch_date negInfinity()
+    {
+        return (epoch_date(neg_infin_ticks));
+    }
+
+    static constexpr epoch_date posInfinity()
+    {
+        return (epoch_date(pos_infin_ticks));
+    }
+
+    [[nodiscard]] constexpr rep_type ticks() const
+    {
+        return (ticks_);
+    }
+
+    [[nodiscard]] constexpr bool isNotADateTime() const
+    {
+        return (ticks_ == not_a_date_ticks);
+    }
+
+    [[nodiscard]] constexpr bool isInfinity() const
+    {
+        return (ticks_ == neg_infin_ticks || ticks_ == pos_infin_ticks);
+    }
+
+    [[nodiscard]] constexpr bool isSpecial() const
+    {
+        return (ticks_ <= neg_infin_ticks || ticks_ == pos_infin_ticks);
+    }
+
+    /**
+     * Whole days since the epoch, rounded towards -infinity.
+     */
+    [[nodiscard]] constexpr rep_type daysSinceEpoch() const
+    {
+        return (ticks_ / ticks_per_day - (ticks_ % ticks_per_day < 0));
+    }
+
+    /**
+     * Microseconds since midnight.
+     */
+    [[nodiscard]] constexpr rep_type timeOfDay() const
+    {
+        return (ticks_ - daysSinceEpoch() * ticks_per_day);
+    }
+
+    /**
+     * Seconds since the epoch, rounded towards -infinity.
+     */
+    [[nodiscard]] constexpr std::time_t toTimeT() const
+    {
+        return (static_cast<std::time_t>(ticks_ / ticks_per_second - (ticks_ % ticks_per_second < 0)));
+    }
+
+    /**
+     * Convert back into a POSIX-time, special values are preserved.
+     */
+    [[nodiscard]] val::ptime toPtime() const
+    {
+        if(isNotADateTime())
+            return (val::ptime(val::not_a_date_time));
+        if(ticks_ == neg_infin_ticks)
+            return (val::ptime(val::neg_infin));
+        if(ticks_ == pos_infin_ticks)
+            return (val::ptime(val::pos_infin));
+
+        return (epochPtime() + val::microseconds(ticks_));
+    }
+
+    explicit operator val::ptime() const
+    {
+        return (toPtime());
+    }
+
+    constexpr epoch_date &operator+=(std::chrono::microseconds d)
+    {
+        if(!isSpecial())
+            ticks_ += d.count();
+
+        return (*this);
+    }
+
+    constexpr epoch_date &operator-=(std::chrono::microseconds d)
+    {
+        if(!isSpecial())
+            ticks_ -= d.count();
+
+        return (*this);
+    }
+
+    friend constexpr epoch_date operator+(epoch_date lhs, std::chrono::microseconds d)
+    {
+        return (lhs += d);
+    }
+
+    friend constexpr epoch_date operator-(epoch_date lhs, std::chrono::microseconds d)
+    {
+        return (lhs -= d);
+    }
+
+    /**
+     * lhs - rhs in ticks, with the special values of boost::posix_time: infinity minus a date is
+     * that infinity, infinity minus itself and anything involving not-a-date-time is
+     * not_a_date_ticks; differences of dates too large for rep_type saturate to the infinities.
+     * Selects only, so that loops over columns vectorise: the plain difference, taken in unsigned
+     * arithmetic that cannot overflow, is blended with the saturated and the special results.
+     */
+    static constexpr rep_type tickDifference(rep_type lhs, rep_type rhs)
+    {
+        using urep_type       = std::make_unsigned_t<rep_type>;
+        constexpr auto nadt   = not_a_date_ticks;
+        constexpr auto negInf = neg_infin_ticks;
+        constexpr auto posInf = pos_infin_ticks;
+
+        const auto plain    = static_cast<rep_type>(static_cast<urep_type>(lhs) - static_cast<urep_type>(rhs));
+        const bool overflow = ((lhs ^ rhs) & (lhs ^ plain)) < 0;
+        const bool tooLarge = overflow | (plain <= negInf) | (plain == posInf);
+        const auto dates    = tooLarge ? (lhs > rhs ? posInf : negInf) : plain;
+
+        const bool special  = (lhs <= negInf) | (lhs == posInf) | (rhs <= negInf) | (rhs == posInf);
+        const bool notADate = (lhs == nadt) | (rhs == nadt) | (lhs == rhs);
+        const auto infinity = (lhs == posInf) | (rhs == negInf) ? posInf : negInf;
+        const auto specials = notADate ? nadt : infinity;
+
+        return (special ? specials : dates);
+    }
+
+    /**
+     * Distance between two date-times; special values and overflows give the reserved
+     * tick-counts as described for tickDifference().
+     */
+    friend constexpr std::chrono::microseconds operator-(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (std::chrono::microseconds(tickDifference(lhs.ticks_, rhs.ticks_)));
+    }
+
+    friend constexpr bool operator==(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ == rhs.ticks_);
+    }
+
+    friend constexpr bool operator!=(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ != rhs.ticks_);
+    }
+
+    friend constexpr bool operator<(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ < rhs.ticks_);
+    }
+
+    friend constexpr bool operator<=(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ <= rhs.ticks_);
+    }
+
+    friend constexpr bool operator>(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ > rhs.ticks_);
+    }
+
+    friend constexpr bool operator>=(const epoch_date &lhs, const epoch_date &rhs)
+    {
+        return (lhs.ticks_ >= rhs.ticks_);
+    }
+
+    /**
+     * Out-stream via POSIX-time, so that imbued date-facets are honoured.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const epoch_date &d)
+    {
+        os << d.toPtime();
+
+        return (os);
+    }
+
+    private:
+    static val::ptime epochPtime()
+    {
+        static const val::ptime epoch(boost::gregorian::date(1970, 1, 1));
+
+        return (epoch);
+    }
+
+    rep_type ticks_ = not_a_date_ticks;
+};
+
+/**
+ *  Checks whether a compact date-time is a valid time (integer range check).
+ */
+constexpr bool valid(const epoch_date &d)
+{
+    return ((d >= epoch_date::fromCivil(1900, 1, 1)) && (d < epoch_date::fromCivil(2201, 1, 1)));
+}
+
+/**
+ *  Calendar arithmetic on compact date-times.
+ *  Every scalar function is constexpr and branch-free (selects only), the
+ *  bulk overloads apply them to contiguous date columns in tight loops the
+ *  compiler can unroll and vectorise. Special values (not-a-date-time,
+ *  infinities) pass through the truncations unchanged.
+ */
+namespace datecalc
+{
+    /**
+     *  Granularity for truncation of date-times.
+     */
+    enum class DateUnit
+    {
+        Day,    ///< midnight of the same day
+        Week,   ///< midnight of the Monday starting the (ISO-)week
+        Month,  ///< midnight of the first of the month
+        Year    ///< midnight of the first of January
+    };
+
+    /**
+     *  Day of the week, 0 = Sunday .. 6 = Saturday (like struct tm and
+     *  boost::gregorian), 7 for special values.
+     */
+    constexpr unsigned dayOfWeek(const epoch_date &d)
+    {
+        const std::int64_t days = d.daysSinceEpoch();
+        const auto         dow  = static_cast<unsigned>((days % 7 + 11) % 7);  // 1970-01-01 was a Thursday
+
+        return (d.isSpecial() ? 7U : dow);
+    }
+
+    /**
+     *  Truncate a date-time to the start of the unit it lies in.
+     */
+    constexpr epoch_date truncate(const epoch_date &d, DateUnit unit)
+    {
+        const std::int64_t days  = d.daysSinceEpoch();
+        const civil_date   civil = civilFromDays(days);
+        const std::int64_t start = unit == DateUnit::Day  ? days :
+                                   unit == DateUnit::Week ? days - (dayOfWeek(d) + 6) % 7 :
+                                   unit == DateUnit::Month ? days - (civil.day - 1) :
+                                                             daysFromCivil(civil.year, 1, 1);
+
+        return (d.isSpecial() ? d : epoch_date(start * epoch_date::ticks_per_day));
+    }
+
+    /**
+     *  Truncate each date-time in the column to the start of its unit.
+     *  in and out may be the same span.
+     */
+    void truncate(std::span<const epoch_date> in, std::span<epoch_date> out, DateUnit unit);
+
+    /**
+     *  Day of the week of each date-time in the column.
+     */
+    void dayOfWeek(std::span<const epoch_date> in, std::span<unsigned char> out);
+
+    /**
+     *  Element-wise differences lhs - rhs in microseconds. Special values follow
+     *  boost::posix_time and are given as the reserved tick-counts of epoch_date:
+     *  infinity minus a date is that infinity, infinity minus the same infinity and
+     *  anything involving not-a-date-time is not_a_date_ticks. Differences too large
+     *  for rep_type saturate to the infinities (epoch_date::tickDifference()).
+     */
+    void difference(std::span<const epoch_date> lhs,
+                    std::span<const epoch_date> rhs,
+                    std::span<epoch_date::rep_type> out);
+
+    /**
+     *  Element-wise conversion to time_t (seconds since 1970), the bulk form of
+     *  datescan::pt_to_time_t(): fractional seconds are truncated toward zero, unlike
+     *  epoch_date::toTimeT(), which rounds towards -infinity.
+     */
+    void toTimeT(std::span<const epoch_date> in, std::span<std::time_t> out);
+
+    /**
+     *  Scan each string and convert it to time_t, the bulk form of
+     *  datescan::seconds_from_epoch().
+     */
+    void secondsFromEpoch(const std::vector<std::string> &in, std::span<std::time_t> out);
+};
+// namespace datecalc
 };
 // namespace util
 
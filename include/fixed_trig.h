@@ -0,0 +1,82 @@
+/*
+ * File:        fixed_trig.h
+ * Description: Fixed-point sine, cosine and atan2 for integer angle types.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_FIXED_TRIG_H_INCLUDED
+#define NS_UTIL_FIXED_TRIG_H_INCLUDED
+
+#include <cstdint>
+#include <degree_conversion.h>
+#include <span>
+
+namespace util
+{
+/**
+ * Fixed point number with 30 fractional bits: Q30_ONE represents 1.0.
+ */
+using q30_t              = int32_t;
+constexpr int   Q30_BITS = 30;
+constexpr q30_t Q30_ONE  = q30_t(1) << Q30_BITS;
+
+/**
+ * Sine and cosine of Deg180, Deg360 and Rad2Pi angles as Q30 fixed point numbers, without a
+ * detour through floating point. Accuracy, relative to the exact value of the angle:
+ * <ul>
+ * <li>Deg180, Deg360: correctly rounded (error at most 2^-31), by lookup.</li>
+ * <li>Rad2Pi: error below 1e-8, from a 4096 entry table and the angle addition theorem for the
+ *     remaining at most 0.77 milli-radians.</li>
+ * </ul>
+ * The angles must be valid().
+ */
+template<typename Angle_>
+q30_t fixedSin(Angle_ angle);
+
+template<typename Angle_>
+q30_t fixedCos(Angle_ angle);
+
+/**
+ * out[i] = fixedSin(angles[i]), resp. fixedCos().
+ * @throw std::invalid_argument if the sizes differ
+ */
+template<typename Angle_>
+void fixedSin(std::span<const Angle_> angles, std::span<q30_t> out);
+
+template<typename Angle_>
+void fixedCos(std::span<const Angle_> angles, std::span<q30_t> out);
+
+/**
+ * The angle of the point (x, y), rounded to the nearest unit of Angle_ (one degree, or one
+ * micro-radian for Rad2Pi); atan2(0, 0) is 0. Before rounding, the error is below 1e-7 radians.
+ */
+template<typename Angle_>
+Angle_ fixedAtan2(int32_t y, int32_t x);
+
+/**
+ * out[i] = fixedAtan2(y[i], x[i]).
+ * @throw std::invalid_argument if the sizes differ
+ */
+template<typename Angle_>
+void fixedAtan2(std::span<const int32_t> y, std::span<const int32_t> x, std::span<Angle_> out);
+};
+// namespace util
+
+#endif  // NS_UTIL_FIXED_TRIG_H_INCLUDED
@@ -26,7 +26,11 @@
 #define NS_UTIL_FLOATINGPOINT_H_INCLUDED
 
 #include <climits>
+#include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace util
 {
@@ -178,6 +182,67 @@ void quadruple_to_decimal(quadruple *px, decimal_mode *pm, decimal_record *pd, f
  */
 void decimal_to_quadruple(quadruple *px, decimal_mode *pm, decimal_record *pd, fp_exception_field_type *ps);
 
+/**
+ * Convert a quadruple to the shortest decimal record that converts back (round-to-nearest) to
+ * exactly the same quadruple. pd->ds receives the significant digits without leading or trailing
+ * zeros, pd->exponent the power of ten of the last digit, pd->ndigits the number of digits.
+ * Zero is "0", infinities and NaNs have an empty ds.
+ * The common case is computed in 128-bit integer arithmetic; only inputs for which that cannot be
+ * proven correct fall back to exact multi-precision conversion.
+ */
+void quadruple_to_shortest_decimal(const quadruple *px, decimal_record *pd);
+
+/**
+ * Convert a decimal record to the correctly rounded (round-to-nearest) quadruple. pd->more is
+ * honoured as in decimal_to_quadruple(). Up to 19 digits with a small exponent take a single
+ * floating point operation, everything else falls back to exact multi-precision conversion.
+ */
+void decimal_to_nearest_quadruple(quadruple *px, const decimal_record *pd);
+
+/**
+ * Decimal strings of a column of quadruples, stored back to back in a single arena so that a
+ * column needs two buffers rather than one allocation per element.
+ */
+class decimal_column
+{
+    public:
+    size_t           size() const;
+    bool             empty() const;
+    std::string_view operator[](size_t i) const;
+
+    /**
+     * All strings concatenated, without separators.
+     */
+    const std::string &arena() const;
+
+    void clear();
+    void append(std::string_view text);
+
+    private:
+    friend void quadruples_to_decimals(std::span<const quadruple> values, decimal_column &out);
+
+    std::string         arena_;
+    std::vector<size_t> ends_;  ///< end offset of each string in arena_
+};
+
+/**
+ * Replace out by the shortest round-trip strings of values (see quadruple_to_shortest_decimal()),
+ * in plain notation for 1e-6 <= |x| < 1e21 and scientific notation ("1.5e-7") otherwise, with
+ * "inf", "-inf" and "nan" for the special values. Large columns are converted on the shared
+ * thread_pool.
+ */
+void quadruples_to_decimals(std::span<const quadruple> values, decimal_column &out);
+
+/**
+ * Convert decimal strings to the nearest quadruples, in parallel for large columns. Accepts an
+ * optional sign, digits with an optional decimal point, an optional exponent and "inf",
+ * "infinity" and "nan" in any case.
+ * @throw std::out_of_range if the sizes of in and out differ
+ * @throw std::invalid_argument if a string is not a decimal number
+ */
+void decimals_to_quadruples(const decimal_column &in, std::span<quadruple> out);
+void decimals_to_quadruples(std::span<const std::string_view> in, std::span<quadruple> out);
+
 };
 // namespace util
 
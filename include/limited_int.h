@@ -25,10 +25,16 @@
 #ifndef LIMITED_INT_H_INCLUDED
 #define LIMITED_INT_H_INCLUDED
 
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <iostream>
 #include <limits>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <typeinfo>
 
 namespace util
@@ -40,7 +46,7 @@ namespace util
 struct resolve_modulo
 {
     template<typename T_>
-    static bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
+    static constexpr bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
     {
         const T_ dist = max - min + 1;
 
@@ -54,6 +60,34 @@ struct resolve_modulo
 
         return (true);
     }
+
+    static constexpr bool throwing = false;
+
+    /**
+     * Branch-free form of resolve() for bulk operations: the modulo by the (usually compile-time
+     * constant) interval width without the sign test.
+     */
+    template<typename T_>
+    static constexpr T_ resolveValue(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        const T_ dist  = max - min + 1;
+        T_       reval = (val - min) % dist;
+        reval += dist & -T_(reval < 0);
+
+        return (reval + min);
+    }
+
+    /**
+     * resolveValue() for values less than one interval width outside [min, max]: a conditional
+     * add or subtract, which vectorises.
+     */
+    template<typename T_>
+    static constexpr T_ resolveNear(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        const T_ dist = max - min + 1;
+
+        return (val - (dist & -T_(val > max)) + (dist & -T_(val < min)));
+    }
 };
 
 /**
@@ -62,16 +96,44 @@ struct resolve_modulo
  */
 struct resolve_throw
 {
+    /**
+     * In a constant expression the exception makes an out of range value a compile-time error.
+     */
     template<typename T_>
-    static bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
+    static constexpr bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
+    {
+        const T_ outOfRange = val;
+        val = (std::numeric_limits<T_>::min() != min ? std::numeric_limits<T_>::min() : std::numeric_limits<T_>::max());
+
+        throw std::out_of_range(message(min, max, outOfRange));
+    }
+
+    template<typename T_>
+    static std::string message(T_ min, T_ max, T_ val)
     {
         std::stringstream ss;
 
         ss << "resolve_throw::resolve() limited_int<" << typeid(T_).name() << "," << min << "," << max << ">(" << val
            << ") out of range.";
-        val = (std::numeric_limits<T_>::min() != min ? std::numeric_limits<T_>::min() : std::numeric_limits<T_>::max());
 
-        throw std::out_of_range(ss.str());
+        return (ss.str());
+    }
+
+    /**
+     * Bulk operations mark out of range values invalid and throw once they are done.
+     */
+    static constexpr bool throwing = true;
+
+    template<typename T_>
+    static constexpr T_ resolveValue(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        return ((val >= min) & (val <= max) ? val : invalid);
+    }
+
+    template<typename T_>
+    static constexpr T_ resolveNear(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        return (resolveValue(min, max, val, invalid));
     }
 };
 
@@ -82,12 +144,26 @@ struct resolve_throw
 struct resolve_invalid
 {
     template<typename T_>
-    static bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
+    static constexpr bool resolve(T_ min, T_ max, T_ &val, T_ invalid)
     {
         val = invalid;
 
         return (false);
     }
+
+    static constexpr bool throwing = false;
+
+    template<typename T_>
+    static constexpr T_ resolveValue(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        return ((val >= min) & (val <= max) ? val : invalid);
+    }
+
+    template<typename T_>
+    static constexpr T_ resolveNear(T_ min, T_ max, T_ val, T_ invalid)
+    {
+        return (resolveValue(min, max, val, invalid));
+    }
 };
 
 /**
@@ -126,23 +202,84 @@ struct is_out_of_bounds_resolver<resolve_throw> : std::true_type
 {
 };
 
+/**
+ * Distance from min to max; unsigned, so that it fits for the full range of any integral type.
+ */
+template<typename T_>
+constexpr uintmax_t limitedIntDistance(T_ min, T_ max)
+{
+    return (uintmax_t(max) - uintmax_t(min));
+}
+
+/**
+ * The exact factor num / den by which a converter maps distances of one limited_int scale onto
+ * another, reduced at compile time; multiply() uses a 128-bit product only if a 64-bit one could
+ * overflow, so that a conversion is an integer multiplication followed by a division by a
+ * constant, which the compiler turns into a multiplication and a shift.
+ */
+template<uintmax_t lhsDist_, uintmax_t rhsDist_>
+struct limited_int_ratio
+{
+    static_assert(lhsDist_ > 0 && rhsDist_ > 0, "limited_int_ratio needs positive distances");
+
+    static constexpr uintmax_t gcd(uintmax_t a, uintmax_t b)
+    {
+        return (b == 0 ? a : gcd(b, a % b));
+    }
+
+    static constexpr uintmax_t num = lhsDist_ / gcd(lhsDist_, rhsDist_);
+    static constexpr uintmax_t den = rhsDist_ / gcd(lhsDist_, rhsDist_);
+
+    /**
+     * floor(val * num / den) for val in [0, rhsDist_]; inexact tells whether a remainder was
+     * dropped.
+     */
+    static constexpr uintmax_t multiply(uintmax_t val, bool &inexact)
+    {
+        if constexpr(num <= std::numeric_limits<uintmax_t>::max() / rhsDist_)
+        {
+            inexact = val * num % den != 0;
+            return (val * num / den);
+        }
+        else
+        {
+            unsigned __int128 product = (unsigned __int128)(val)*num;
+            inexact                   = product % den != 0;
+            return (uintmax_t(product / den));
+        }
+    }
+
+    static constexpr uintmax_t multiply(uintmax_t val)
+    {
+        bool inexact = false;
+
+        return (multiply(val, inexact));
+    }
+};
+
 /**
  * Helper class that deals with the conversion between different limited_int
- * specialisations by scaling the rhs interval onto the lhs interval.
+ * specialisations by scaling the rhs interval onto the lhs interval. The result, min plus
+ * the exactly scaled distance, is truncated toward zero.
  */
 struct convert_scale
 {
-    template<typename T_, typename LimitedInt2_>
-    static T_ convertFrom(T_ min_, T_ max_, const LimitedInt2_ &rhs)
+    template<typename T_, T_ min_, T_ max_, typename LimitedInt2_>
+    static constexpr T_ convertFrom(const LimitedInt2_ &rhs)
     {
-        long double distLhs     = (static_cast<long double>(max_) - static_cast<long double>(min_));
-        long double distRhs     = (rhs.max() - rhs.min());
-        long double valRhsTo0   = (static_cast<long double>(rhs.val()) - rhs.min());
-        long double scaleFactor = distLhs / distRhs;
-        long double valLhsTo0   = valRhsTo0 * scaleFactor;
-        T_          reval(valLhsTo0 + static_cast<long double>(min_));
+        constexpr auto rhsMin  = LimitedInt2_::min().val();
+        constexpr auto rhsDist = limitedIntDistance(rhsMin, LimitedInt2_::max().val());
+        using ratio            = limited_int_ratio<limitedIntDistance(min_, max_), rhsDist>;
 
-        return (reval);
+        bool      inexact = false;
+        uintmax_t offset  = ratio::multiply(limitedIntDistance(rhsMin, rhs.val()), inexact);
+        __int128  reval   = __int128(min_) + __int128(offset);
+
+        // min_ plus the exact scaled distance, truncated toward zero
+        if(inexact && reval < 0)
+            reval++;
+
+        return (T_(reval));
     }
 };
 
@@ -152,27 +289,29 @@ struct convert_scale
  */
 struct convert_circular_scale
 {
-    template<typename T_, typename LimitedInt2_>
-    static T_ convertFrom(T_ min_, T_ max_, const LimitedInt2_ &rhs)
+    template<typename T_, T_ min_, T_ max_, typename LimitedInt2_>
+    static constexpr T_ convertFrom(const LimitedInt2_ &rhs)
     {
-        if(((rhs.min() + rhs.max() > 1) && rhs.min() != 0) || ((min_ + max_ > 1) && min_ != 0))
-        {
-            std::stringstream ss;
-            ss << "convert_circular_scale::convertFrom(" << min_ << "," << max_ << "," << rhs
-               << "):can only user circular scale conversion on symmetric around 0 or [0, pos] limited ints";
-            throw std::out_of_range(ss.str());
-        }
+        constexpr intmax_t rhsMin = LimitedInt2_::min().val();
+        constexpr intmax_t rhsMax = LimitedInt2_::max().val();
+        static_assert((rhsMin + rhsMax <= 1 || rhsMin == 0) && (intmax_t(min_) + max_ <= 1 || min_ == 0),
+                      "can only use circular scale conversion on symmetric around 0 or [0, pos] limited ints");
 
-        T_ rhsDist      = rhs.max() - rhs.min();
-        T_ rhsValMapped = (rhs.min() < 0 && rhs.val() < 0) ? rhs.val() + rhsDist : rhs.val();
-        T_ lhsDist      = max_ - min_;
-        T_ scale        = lhsDist / rhsDist;
-        T_ lhsValMapped = T_(static_cast<long double>(rhsValMapped) * static_cast<long double>(scale));
+        // one turn has max - min + 1 units, as in resolve_modulo
+        constexpr uintmax_t rhsPeriod = limitedIntDistance(rhsMin, rhsMax) + 1;
+        constexpr uintmax_t lhsPeriod = limitedIntDistance(min_, max_) + 1;
+        static_assert(rhsPeriod <= uintmax_t(std::numeric_limits<intmax_t>::max()) &&
+                       lhsPeriod <= uintmax_t(std::numeric_limits<intmax_t>::max()),
+                      "circular scale conversion needs limited ints of fewer than 2^63 values");
+        using ratio = limited_int_ratio<lhsPeriod, rhsPeriod>;
 
-        if(min_ < 0)
-            lhsValMapped = (lhsValMapped - lhsDist) % lhsDist;
+        intmax_t rhsValMapped = (rhsMin < 0 && rhs.val() < 0) ? rhs.val() + intmax_t(rhsPeriod) : rhs.val();
+        intmax_t lhsValMapped = intmax_t(ratio::multiply(uintmax_t(rhsValMapped)));
 
-        return (lhsValMapped);
+        if(min_ < 0 && lhsValMapped > max_)
+            lhsValMapped -= intmax_t(lhsPeriod);
+
+        return (T_(lhsValMapped));
     }
 };
 
@@ -228,12 +367,12 @@ struct limited_int_traits
         return (invalid_);
     }
 
-    static bool withinBounds(const INT_ &val)
+    static constexpr bool withinBounds(const INT_ &val)
     {
         return ((val >= min_) && (val <= max_) && (min_ < max_));
     }
 
-    static bool apply(INT_ &val)
+    static constexpr bool apply(INT_ &val)
     {
         if(!withinBounds(val))
         {
@@ -243,14 +382,33 @@ struct limited_int_traits
         return (true);
     }
 
+    /**
+     * Branch-free apply() for bulk operations, returning the resolved value.
+     */
+    static constexpr INT_ applyValue(INT_ val)
+    {
+        return (Resolver::resolveValue(min_, max_, val, invalid_));
+    }
+
+    /**
+     * applyValue() for values less than one interval width outside [min_, max_].
+     */
+    static constexpr INT_ applyNear(INT_ val)
+    {
+        return (Resolver::resolveNear(min_, max_, val, invalid_));
+    }
+
+    /**
+     * The value of rhs on this scale; invalid() if rhs is not valid.
+     */
     template<typename LimitedInt_>
-    static INT_ convertFrom(const LimitedInt_ &rhs)
+    static constexpr INT_ convertFrom(const LimitedInt_ &rhs)
     {
-        return (Converter::convertFrom(min_, max_, rhs));
+        return (rhs.isValid() ? Converter::template convertFrom<INT_, min_, max_>(rhs) : invalid());
     }
 
     template<typename LimitedInt_>
-    static LimitedInt_ nth_next(const LimitedInt_ &val, const decltype(val.val()) &n)
+    static constexpr LimitedInt_ nth_next(const LimitedInt_ &val, const decltype(val.val()) &n)
     {
         return (val.val() + n);
     }
@@ -267,7 +425,7 @@ template<typename T_,
 struct limited_int
 {
     private:
-    explicit limited_int(bool dummy) : val_(Traits_::invalid_)
+    explicit constexpr limited_int(bool dummy) : val_(Traits_::invalid_)
     {
     }
 
@@ -277,7 +435,7 @@ struct limited_int
     using TraitsType = Traits_;
     using iterator   = limited_int_iterator<limited_int<T_, min_, max_, Traits_>>;
 
-    limited_int(T_ val = min_) : val_(val)
+    constexpr limited_int(T_ val = min_) : val_(val)
     {
         static_assert(true == std::is_integral<T_>::value, "limited_int<> needs integral type as template parameter");
         static_assert(min_ < max_, "limited_int<> min needs to be smaller than max");
@@ -287,13 +445,15 @@ struct limited_int
         Traits_::apply(val_);
     }
 
+    /**
+     * Convert from another scale; the conversion factor is computed at compile time.
+     */
     template<typename T2_, T2_ min2_, T2_ max2_, typename Traits2_>
-    limited_int(const limited_int<T2_, min2_, max2_, Traits2_> &rhs)
+    constexpr limited_int(const limited_int<T2_, min2_, max2_, Traits2_> &rhs) : val_(Traits_::convertFrom(rhs))
     {
-        val_ = Traits_::convertFrom(rhs);
     }
 
-    [[nodiscard]] bool isValid() const
+    [[nodiscard]] constexpr bool isValid() const
     {
         return (val_ != Traits_::invalid());
     }
@@ -303,11 +463,9 @@ struct limited_int
         return (min_);
     }
 
-    static limited_int invalid()
+    static constexpr limited_int invalid()
     {
-        static limited_int<T_, min_, max_, Traits_> invalidLimitedInt(false);
-
-        return (invalidLimitedInt);
+        return (limited_int(false));
     }
 
     static constexpr limited_int max()
@@ -315,12 +473,12 @@ struct limited_int
         return (max_);
     }
 
-    T_ val() const
+    constexpr T_ val() const
     {
         return (val_);
     }
 
-    operator T_() const
+    constexpr operator T_() const
     {
         return (val());
     }
@@ -345,6 +503,62 @@ struct limited_int
         return (iterator(rfinish, true));
     }
 
+    /**
+     * Bulk operations: values[i] = limited_int(values[i] + delta), etc., with the out of range
+     * resolution done without branches so that loops vectorise. The results equal those of the
+     * element-by-element operations, except that with resolve_throw all values are processed,
+     * those out of range are set to invalid(), and only then std::out_of_range is thrown.
+     * Operations involving values that are not valid() give unspecified results.
+     */
+    static void addAll(std::span<limited_int> values, T_ delta)
+    {
+        if(delta > min_ - max_ - 1 && delta < max_ - min_ + 1)
+            transformAll<true>(values, [delta](T_ v, size_t) { return (v + delta); });
+        else
+            transformAll<false>(values, [delta](T_ v, size_t) { return (v + delta); });
+    }
+
+    static void subtractAll(std::span<limited_int> values, T_ delta)
+    {
+        if(delta > min_ - max_ - 1 && delta < max_ - min_ + 1)
+            transformAll<true>(values, [delta](T_ v, size_t) { return (v - delta); });
+        else
+            transformAll<false>(values, [delta](T_ v, size_t) { return (v - delta); });
+    }
+
+    /**
+     * Element-wise values[i] = limited_int(values[i] + rhs[i]).
+     * @throw std::invalid_argument if the sizes differ
+     */
+    static void addAll(std::span<limited_int> values, std::span<const limited_int> rhs)
+    {
+        checkSizes("addAll", values.size(), rhs.size());
+        transformAll<sumsNear()>(values, [rhs](T_ v, size_t i) { return (v + rhs[i].val_); });
+    }
+
+    static void subtractAll(std::span<limited_int> values, std::span<const limited_int> rhs)
+    {
+        checkSizes("subtractAll", values.size(), rhs.size());
+        transformAll<sumsNear()>(values, [rhs](T_ v, size_t i) { return (v - rhs[i].val_); });
+    }
+
+    static void scaleAll(std::span<limited_int> values, T_ factor)
+    {
+        transformAll<false>(values, [factor](T_ v, size_t) { return (v * factor); });
+    }
+
+    /**
+     * out[i] = limited_int(in[i]), converted from another scale.
+     * @throw std::invalid_argument if the sizes differ
+     */
+    template<typename T2_, T2_ min2_, T2_ max2_, typename Traits2_>
+    static void convertAll(std::span<const limited_int<T2_, min2_, max2_, Traits2_>> in, std::span<limited_int> out)
+    {
+        checkSizes("convertAll", out.size(), in.size());
+        for(size_t i = 0; i < in.size(); i++)
+            out[i].val_ = Traits_::convertFrom(in[i]);
+    }
+
     /**
      * global stream operator defined as friend within the template body.
      */
@@ -359,6 +573,48 @@ struct limited_int
 
         return (os);
     }
+
+    private:
+    /**
+     * Whether sums and differences of two valid values lie within one interval width of
+     * [min_, max_].
+     */
+    static constexpr bool sumsNear()
+    {
+        return (min_ >= -(max_ - min_ + 1) && max_ <= max_ - min_ + 1);
+    }
+
+    static void checkSizes(const char *function, size_t valuesSize, size_t otherSize)
+    {
+        if(valuesSize != otherSize)
+            throw std::invalid_argument(std::string("limited_int::") + function + "(): " + std::to_string(valuesSize) +
+                                        " values but " + std::to_string(otherSize) + " operands");
+    }
+
+    /**
+     * values[i].val_ = resolved op(values[i].val_, i); near_ if all results are within one
+     * interval width of [min_, max_].
+     */
+    template<bool near_, typename Op_>
+    static void transformAll(std::span<limited_int> values, Op_ op)
+    {
+        bool failed = false;
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            T_ val = op(values[i].val_, i);
+            if constexpr(Traits_::Resolver::throwing)
+                failed |= !((val >= min_) & (val <= max_));
+            values[i].val_ = near_ ? Traits_::applyNear(val) : Traits_::applyValue(val);
+        }
+
+        if(failed)
+        {
+            std::stringstream ss;
+            ss << "limited_int<" << typeid(T_).name() << "," << min_ << "," << max_
+               << "> bulk operation: results out of range.";
+            throw std::out_of_range(ss.str());
+        }
+    }
 };
 
 /**
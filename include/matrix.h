@@ -1468,7 +1468,7 @@ class matrix : public matrix_interface
     }
 };
 
-template<bool enable = false>
+template<bool enable>
 inline void checkBounds(const matrix_interface &lhs, size_t x, size_t y, const std::string &location)
 {
     if(!lhs.withinBounds(x, y))
@@ -0,0 +1,206 @@
+/*
+ * File:        perf_counters.h
+ * Description: Hardware performance counters through Linux perf_event_open.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_PERF_COUNTERS_H_INCLUDED
+#define NS_UTIL_PERF_COUNTERS_H_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace util
+{
+/**
+ * Counted events; TASK_CLOCK (nanoseconds on the CPU) is a software event that is usually
+ * available where the hardware events are not, as in containers and virtual machines.
+ */
+enum class PerfEvent : uint8_t
+{
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,     ///< level 1 data cache load misses
+    LLC_MISSES,     ///< last level cache load misses
+    BRANCH_MISSES,  ///< mispredicted branches
+    TASK_CLOCK
+};
+
+constexpr size_t PERF_EVENT_COUNT = 6;
+
+constexpr uint32_t perfEventBit(PerfEvent event)
+{
+    return (uint32_t(1) << unsigned(event));
+}
+
+constexpr uint32_t ALL_PERF_EVENTS = (uint32_t(1) << PERF_EVENT_COUNT) - 1;
+
+/**
+ * Name of the event as used by the perf tool, e.g. "branch-misses".
+ */
+const char *perfEventName(PerfEvent event);
+
+/**
+ * Counter values; only the events in the mask were counted.
+ */
+struct perf_sample
+{
+    std::array<uint64_t, PERF_EVENT_COUNT> values{};
+    uint32_t                               events = 0;
+
+    bool has(PerfEvent event) const
+    {
+        return ((events & perfEventBit(event)) != 0);
+    }
+
+    uint64_t operator[](PerfEvent event) const
+    {
+        return (values[size_t(event)]);
+    }
+
+    perf_sample &operator+=(const perf_sample &rhs)
+    {
+        for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+            values[e] += rhs.values[e];
+        events |= rhs.events;
+
+        return (*this);
+    }
+
+    /**
+     * The counts between two reads of the same group. Counts scaled for multiplexing can
+     * decrease between reads; such deltas are 0 rather than wrapping around.
+     */
+    friend perf_sample operator-(perf_sample lhs, const perf_sample &rhs)
+    {
+        for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+            lhs.values[e] = lhs.values[e] > rhs.values[e] ? lhs.values[e] - rhs.values[e] : 0;
+        lhs.events &= rhs.events;
+
+        return (lhs);
+    }
+};
+
+/**
+ * Group of counters of the calling thread (user space only), read together with one system
+ * call. Events that cannot be opened (no PMU, perf_event_paranoid, seccomp, not Linux) are left
+ * out rather than reported as errors; if none can be opened the group is empty and reads
+ * return empty samples without a system call. Counts are scaled if the kernel multiplexed the
+ * group with others.
+ */
+class perf_counter_group
+{
+    public:
+    explicit perf_counter_group(uint32_t events = ALL_PERF_EVENTS);
+    ~perf_counter_group();
+
+    perf_counter_group(const perf_counter_group &)            = delete;
+    perf_counter_group &operator=(const perf_counter_group &) = delete;
+
+    /**
+     * Whether any event is counted.
+     */
+    bool available() const
+    {
+        return (leader_ >= 0);
+    }
+
+    /**
+     * Mask of the counted events.
+     */
+    uint32_t events() const
+    {
+        return (events_);
+    }
+
+    /**
+     * Why requested events are missing (the error of the first event that failed to open), or
+     * empty.
+     */
+    const std::string &status() const
+    {
+        return (status_);
+    }
+
+    /**
+     * Zero the counters and start counting.
+     */
+    void start();
+
+    void stop();
+
+    /**
+     * The counts since start().
+     */
+    perf_sample read() const;
+
+    private:
+    int                                     leader_ = -1;
+    std::array<int, PERF_EVENT_COUNT>       fds_;
+    std::array<PerfEvent, PERF_EVENT_COUNT> order_;  ///< event of each value in a group read
+    size_t                                  opened_ = 0;
+    uint32_t                                events_ = 0;
+    std::string                             status_;
+};
+
+/**
+ * Group of all events of the calling thread, opened and started on first use.
+ */
+perf_counter_group &threadPerfCounters();
+
+/**
+ * Whether threadPerfCounters() counts any event.
+ */
+inline bool perfCountersAvailable()
+{
+    return (threadPerfCounters().available());
+}
+
+/**
+ * Add the counts of the enclosing scope, in the calling thread, to a total; scopes may be
+ * nested. Costs two system calls if counters are available and nothing otherwise.
+ */
+class scoped_perf_counters
+{
+    public:
+    explicit scoped_perf_counters(perf_sample &total)
+    : total_(total)
+    , start_(threadPerfCounters().read())
+    {
+    }
+
+    scoped_perf_counters(const scoped_perf_counters &)            = delete;
+    scoped_perf_counters &operator=(const scoped_perf_counters &) = delete;
+
+    ~scoped_perf_counters()
+    {
+        total_ += threadPerfCounters().read() - start_;
+    }
+
+    private:
+    perf_sample &total_;
+    perf_sample  start_;
+};
+};
+// namespace util
+
+#endif  // NS_UTIL_PERF_COUNTERS_H_INCLUDED
@@ -0,0 +1,330 @@
+/*
+ * File:        profiling.h
+ * Description: Low-overhead scoped timers with per-thread aggregation.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+
+#ifndef NS_UTIL_PROFILING_H_INCLUDED
+#define NS_UTIL_PROFILING_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <perf_counters.h>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <x86intrin.h>
+#else
+    #include <chrono>
+#endif
+
+namespace util
+{
+/**
+ * Current time in profiling ticks: the time stamp counter on x86-64 (assumed invariant, as on
+ * all current CPUs), nanoseconds of std::chrono::steady_clock elsewhere.
+ */
+inline uint64_t profileTicks()
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    return (__rdtsc());
+#else
+    return (uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count()));
+#endif
+}
+
+/**
+ * Ticks per nanosecond, calibrated against std::chrono::steady_clock on first use (which takes
+ * about 20 milliseconds).
+ */
+double ticksPerNanosecond();
+
+/**
+ * Latency histogram with logarithmic buckets of 16 linear sub-buckets each, as in HDR
+ * histograms: values up to 31 are exact, larger ones are recorded with a relative error below
+ * 1/16. Values of 2^48 and more share the last bucket.
+ */
+struct latency_histogram
+{
+    static constexpr unsigned subBucketBits = 4;
+    static constexpr unsigned maxExponent   = 47;
+    static constexpr size_t   bucketCount   = (maxExponent - subBucketBits + 2) << subBucketBits;
+
+    static size_t bucketOf(uint64_t value)
+    {
+        constexpr uint64_t linear = uint64_t(2) << subBucketBits;
+        if(value < linear)
+            return (size_t(value));
+
+        unsigned exponent = std::min(63U - unsigned(__builtin_clzll(value)), maxExponent);
+        uint64_t sub      = (std::min(value, (uint64_t(2) << maxExponent) - 1) >> (exponent - subBucketBits)) &
+                       ((uint64_t(1) << subBucketBits) - 1);
+
+        return (size_t((exponent - subBucketBits + 1) << subBucketBits) + size_t(sub));
+    }
+
+    /**
+     * Smallest value recorded in bucket.
+     */
+    static uint64_t lowerBound(size_t bucket)
+    {
+        constexpr size_t linear = size_t(2) << subBucketBits;
+        if(bucket < linear)
+            return (bucket);
+
+        unsigned exponent = unsigned(bucket >> subBucketBits) + subBucketBits - 1;
+        uint64_t sub      = bucket & ((size_t(1) << subBucketBits) - 1);
+
+        return ((uint64_t(1) << exponent) + (sub << (exponent - subBucketBits)));
+    }
+
+    static uint64_t upperBound(size_t bucket)
+    {
+        return (bucket + 1 < bucketCount ? lowerBound(bucket + 1) - 1 : UINT64_MAX);
+    }
+};
+
+/**
+ * Statistics of one profiled scope in one thread. Only the owning thread writes, with relaxed
+ * atomic loads and stores rather than read-modify-write instructions, so that reports can be
+ * taken from other threads at any time without locks.
+ */
+struct profile_counters
+{
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalTicks{0};
+    std::atomic<uint64_t> minTicks{UINT64_MAX};
+    std::atomic<uint64_t> maxTicks{0};
+    std::array<std::atomic<uint64_t>, latency_histogram::bucketCount> histogram{};
+    std::atomic<uint64_t> eventScopes{0};  ///< scopes with counter values
+    std::array<std::atomic<uint64_t>, PERF_EVENT_COUNT> events{};
+    std::atomic<uint32_t> eventMask{0};
+
+    static void bump(std::atomic<uint64_t> &a, uint64_t v)
+    {
+        a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t ticks)
+    {
+        bump(count, 1);
+        bump(totalTicks, ticks);
+        if(ticks < minTicks.load(std::memory_order_relaxed))
+            minTicks.store(ticks, std::memory_order_relaxed);
+        if(ticks > maxTicks.load(std::memory_order_relaxed))
+            maxTicks.store(ticks, std::memory_order_relaxed);
+        bump(histogram[latency_histogram::bucketOf(ticks)], 1);
+    }
+
+    /**
+     * Add the performance counter values of one scope; empty samples are ignored.
+     */
+    void recordEvents(const perf_sample &sample)
+    {
+        if(sample.events == 0)
+            return;
+        bump(eventScopes, 1);
+        for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+            bump(events[e], sample.values[e]);
+        eventMask.store(eventMask.load(std::memory_order_relaxed) | sample.events, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Upper limit of distinct profiling labels in a process.
+ */
+constexpr size_t MAX_PROFILE_SITES = 1024;
+
+/**
+ * Number the label; the same text always gives the same number.
+ * @throw std::length_error if there are more than MAX_PROFILE_SITES labels
+ */
+uint32_t registerProfileSite(const std::string &label);
+
+/**
+ * The counters of site in the calling thread, created on first use. Once the thread's counters
+ * have been folded into the totals at thread exit, this is a sink that is never reported.
+ */
+profile_counters &threadProfileCounters(uint32_t site);
+
+namespace profiling_detail
+{
+    /**
+     * Per-thread table of counters, indexed by site; nullptr until the thread first records.
+     */
+    extern thread_local constinit std::atomic<profile_counters *> *threadSites;
+
+    inline profile_counters &counters(uint32_t site)
+    {
+        profile_counters *reval = threadSites != nullptr ? threadSites[site].load(std::memory_order_relaxed) : nullptr;
+
+        return (reval != nullptr ? *reval : threadProfileCounters(site));
+    }
+};
+// namespace profiling_detail
+
+/**
+ * String literal usable as template argument: scoped_timer<"parse">.
+ */
+template<size_t N_>
+struct profile_label
+{
+    constexpr profile_label(const char (&text)[N_])
+    {
+        std::copy_n(text, N_, value);
+    }
+
+    char value[N_];
+};
+
+/**
+ * Time the enclosing scope and add the duration to the statistics of Label_ of the calling
+ * thread; costs two time stamp counter reads and a handful of thread-local stores.
+ */
+template<profile_label Label_>
+class scoped_timer
+{
+    public:
+    scoped_timer() : start_(profileTicks())
+    {
+    }
+
+    scoped_timer(const scoped_timer &)            = delete;
+    scoped_timer &operator=(const scoped_timer &) = delete;
+
+    ~scoped_timer()
+    {
+        uint64_t ticks = profileTicks() - start_;
+        profiling_detail::counters(site()).record(ticks);
+    }
+
+    static uint32_t site()
+    {
+        static const uint32_t reval = registerProfileSite(Label_.value);
+
+        return (reval);
+    }
+
+    private:
+    uint64_t start_;
+};
+
+/**
+ * Like scoped_timer, but also adds the performance counters of the calling thread (see
+ * threadPerfCounters()) to the statistics of Label_. Where counters are available this costs two
+ * system calls, so it suits scopes of some microseconds and more.
+ */
+template<profile_label Label_>
+class scoped_perf_timer
+{
+    public:
+    scoped_perf_timer()
+    : events_(threadPerfCounters().read())
+    , start_(profileTicks())
+    {
+    }
+
+    scoped_perf_timer(const scoped_perf_timer &)            = delete;
+    scoped_perf_timer &operator=(const scoped_perf_timer &) = delete;
+
+    ~scoped_perf_timer()
+    {
+        uint64_t          ticks    = profileTicks() - start_;
+        profile_counters &counters = profiling_detail::counters(scoped_timer<Label_>::site());
+        counters.record(ticks);
+        counters.recordEvents(threadPerfCounters().read() - events_);
+    }
+
+    private:
+    perf_sample events_;
+    uint64_t    start_;
+};
+
+/**
+ * Statistics of one label, merged over all threads, in nanoseconds.
+ */
+struct profile_entry
+{
+    std::string label;
+    uint64_t    count       = 0;
+    double      totalNs     = 0.0;
+    double      minNs       = 0.0;
+    double      maxNs       = 0.0;
+    double      meanNs      = 0.0;
+    double      p50Ns       = 0.0;
+    double      p90Ns       = 0.0;
+    double      p99Ns       = 0.0;
+    double      p999Ns      = 0.0;
+    uint64_t    eventScopes = 0;  ///< scopes timed by scoped_perf_timer with counters available
+    perf_sample events;           ///< sums over those scopes
+};
+
+/**
+ * Statistics of all labels recorded so far, merged over all threads (including finished ones),
+ * by descending total time. Percentiles are the upper bounds of the histogram buckets.
+ */
+std::vector<profile_entry> profileReport();
+
+/**
+ * Print profileReport() as a table, followed by a table of the mean counter values per scope if
+ * any label has them.
+ */
+void printProfileReport(std::ostream &os = std::cout);
+
+/**
+ * Print profileReport() as a JSON array.
+ */
+void printProfileReportJson(std::ostream &os);
+
+/**
+ * Zero all statistics. Scopes finishing concurrently may be lost or partially counted.
+ */
+void resetProfile();
+};
+// namespace util
+
+#define UTIL_PROFILE_CONCAT_(a_, b_) a_##b_
+#define UTIL_PROFILE_CONCAT(a_, b_)  UTIL_PROFILE_CONCAT_(a_, b_)
+
+#if defined NO_PROFILING_
+    #define UTIL_PROFILE_SCOPE(label_)
+    #define UTIL_PROFILE_COUNTERS_SCOPE(label_)
+#else
+    /**
+     * Time the rest of the enclosing scope under the string literal label_.
+     */
+    #define UTIL_PROFILE_SCOPE(label_) \
+        util::scoped_timer<label_> UTIL_PROFILE_CONCAT(utilProfileScope_, __LINE__)
+
+    /**
+     * Time the rest of the enclosing scope and count its hardware events under label_.
+     */
+    #define UTIL_PROFILE_COUNTERS_SCOPE(label_) \
+        util::scoped_perf_timer<label_> UTIL_PROFILE_CONCAT(utilProfileScope_, __LINE__)
+#endif  // NO_PROFILING_
+
+#endif  // NS_UTIL_PROFILING_H_INCLUDED
@@ -28,15 +28,24 @@
 #include "iosutil.h"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ctime>  // for struct tm
 #include <deque>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -56,6 +65,18 @@ enum NumberClass
     FLOAT  ///< A floating point number
 };
 
+/**
+ * Class and value of a number string as found by scanNumberString(). The value is held by the
+ * member belonging to the class: intValue for INT, uintValue for UINT and floatValue for FLOAT.
+ */
+struct NumberValue
+{
+    NumberClass numberClass = NONE;
+    int64_t     intValue    = 0;
+    uint64_t    uintValue   = 0;
+    long double floatValue  = 0.0L;
+};
+
 enum class StripTrimMode : unsigned char
 {
     FRONT   = 0x01,                  ///< Strip or trim the left-hand-side
@@ -68,72 +89,264 @@ enum class StripTrimMode : unsigned char
 };
 
 /**
- * Convert objects to a string, provided a ostream - &lt;&lt; operator is defined.
+ * Append-only text buffer for building reports: numbers are formatted with std::to_chars,
+ * strings and the standard containers are copied in directly, so that nested containers are
+ * printed into a single growing buffer instead of one stream (and string) per element.
+ * The output is the same as the ostream - &lt;&lt; operators produce with default stream settings
+ * (floating point numbers with 6 significant digits, bool as 0/1). Other types are written by
+ * their ostream - &lt;&lt; operator through one stream that the builder re-uses.
+ */
+class string_builder
+{
+    public:
+    explicit string_builder(size_t capacity = 256)
+    {
+        buffer_.reserve(capacity);
+    }
+
+    string_builder(const string_builder &)            = delete;
+    string_builder &operator=(const string_builder &) = delete;
+    string_builder(string_builder &&)                 = default;
+    string_builder &operator=(string_builder &&)      = default;
+
+    size_t size() const
+    {
+        return (buffer_.size());
+    }
+
+    bool empty() const
+    {
+        return (buffer_.empty());
+    }
+
+    void reserve(size_t capacity)
+    {
+        buffer_.reserve(capacity);
+    }
+
+    /**
+     * Drop the content, but keep the capacity.
+     */
+    void clear()
+    {
+        buffer_.clear();
+    }
+
+    std::string_view view() const
+    {
+        return (buffer_);
+    }
+
+    std::string str() const &
+    {
+        return (buffer_);
+    }
+
+    /**
+     * Hand over the buffer without copying it.
+     */
+    std::string str() &&
+    {
+        return (std::move(buffer_));
+    }
+
+    string_builder &append(std::string_view s)
+    {
+        buffer_.append(s);
+
+        return (*this);
+    }
+
+    string_builder &append(const char *s)
+    {
+        if(s != nullptr)
+            buffer_.append(s);
+
+        return (*this);
+    }
+
+    string_builder &append(char c)
+    {
+        buffer_.push_back(c);
+
+        return (*this);
+    }
+
+    template<typename Traits_, typename Alloc_>
+    string_builder &append(const std::basic_string<char, Traits_, Alloc_> &s)
+    {
+        buffer_.append(s.data(), s.size());
+
+        return (*this);
+    }
+
+    template<typename T_, typename Alloc_>
+    string_builder &append(const std::vector<T_, Alloc_> &vec)
+    {
+        if(vec.empty())
+            return (append("< >"));
+
+        append("< ");
+        for(auto it = vec.begin(); it != vec.end() - 1; it++)
+            append(*it).append(" | ");
+
+        return (append(vec.back()).append(" >"));
+    }
+
+    template<typename T_, typename Alloc_>
+    string_builder &append(const std::deque<T_, Alloc_> &deq)
+    {
+        if(deq.empty())
+            return (append("(* *)"));
+
+        append("(* ");
+        for(auto it = deq.begin(); it != deq.end() - 1; it++)
+            append(*it).append(" < ");
+
+        return (append(deq.back()).append(" *)"));
+    }
+
+    template<typename T1_, typename T2_>
+    string_builder &append(const std::pair<T1_, T2_> &p)
+    {
+        return (append('(').append(p.first).append("->").append(p.second).append(')'));
+    }
+
+    template<typename T_, typename Compare_, typename Alloc_>
+    string_builder &append(const std::set<T_, Compare_, Alloc_> &set)
+    {
+        if(set.empty())
+            return (append("{ }"));
+
+        append("{ ");
+        for(auto it = set.begin(); it != set.end(); it++)
+            append(it == set.begin() ? "" : ", ").append(*it);
+
+        return (append(" }"));
+    }
+
+    template<typename T1_, typename T2_, typename Compare_, typename Alloc_>
+    string_builder &append(const std::map<T1_, T2_, Compare_, Alloc_> &map)
+    {
+        append("[ ");
+        for(const auto &element: map)
+            append(element).append(' ');
+
+        return (append("]"));
+    }
+
+    template<typename Value_, typename Hash_, typename Pred_, typename Alloc_>
+    string_builder &append(const std::unordered_set<Value_, Hash_, Pred_, Alloc_> &set)
+    {
+        append("{~ ");
+        for(const auto &element: set)
+            append(element).append(' ');
+
+        return (append("~}"));
+    }
+
+    template<typename Key_, typename Value_, typename Hash_, typename Pred_, typename Alloc_>
+    string_builder &append(const std::unordered_map<Key_, Value_, Hash_, Pred_, Alloc_> &map)
+    {
+        append("{~ ");
+        for(const auto &element: map)
+            append(element).append(' ');
+
+        return (append("~}"));
+    }
+
+    /**
+     * Numbers with std::to_chars, everything else with its ostream - &lt;&lt; operator.
+     */
+    template<typename T_>
+    string_builder &append(const T_ &v)
+    {
+        if constexpr(std::is_same_v<T_, bool>)
+            buffer_.push_back(v ? '1' : '0');
+        else if constexpr(std::is_same_v<T_, signed char> || std::is_same_v<T_, unsigned char>)
+            buffer_.push_back(static_cast<char>(v));
+        else if constexpr(std::is_integral_v<T_>)
+            appendChars([&v](char *first, char *last) { return (std::to_chars(first, last, v)); });
+        else if constexpr(std::is_floating_point_v<T_>)
+            appendChars([&v](char *first, char *last)
+                        { return (std::to_chars(first, last, v, std::chars_format::general, 6)); });
+        else
+        {
+            if(!stream_)
+                stream_ = std::make_unique<std::ostringstream>();
+            stream_->str(std::string());
+            *stream_ << v;
+            buffer_.append(stream_->view());
+        }
+
+        return (*this);
+    }
+
+    template<typename T_>
+    string_builder &operator<<(const T_ &v)
+    {
+        return (append(v));
+    }
+
+    private:
+    template<typename F_>
+    void appendChars(F_ toChars)
+    {
+        char buffer[64];
+        auto result = toChars(buffer, buffer + sizeof(buffer));
+        buffer_.append(buffer, result.ptr);
+    }
+
+    std::string                          buffer_;
+    std::unique_ptr<std::ostringstream>  stream_;  ///< for types without built-in formatting
+};
+
+/**
+ * Convert objects to a string, provided a ostream - &lt;&lt; operator is defined. Numbers,
+ * strings and standard containers are formatted by a string_builder without a stream.
  */
 template<typename T_>
 inline std::string asString(const T_ &v)
 {
-    std::stringstream ss;
-    ss << v;
+    string_builder sb(32);
+    sb << v;
 
-    return (ss.str());
+    return (std::move(sb).str());
 }
 
 /**
- * Generic ostream - &lt;&lt; operator for vectors.
+ * Generic ostream - &lt;&lt; operator for vectors. The container operators write what
+ * string_builder::append() formats, so both give the same layout; elements are formatted as by
+ * asString(), not with the flags of the stream.
  */
 template<typename T_, typename Alloc_>
 inline std::ostream &operator<<(std::ostream &os, const std::vector<T_, Alloc_> &vec)
 {
-    if(!vec.empty())
-    {
-        os << "< ";
-        std::copy(vec.begin(), vec.end() - 1, std::ostream_iterator<T_>(os, " | "));
-        os << vec.back() << " >";
-    }
-    else
-        os << "< >";
+    string_builder sb;
 
-    return (os);
+    return (os << sb.append(vec).view());
 }
 
 /**
  * Generic ostream - &lt;&lt; operator for double ended queues.
  */
 template<typename T_, typename Alloc_>
-inline std::ostream &operator<<(std::ostream &os, const std::deque<T_, Alloc_> &vec)
+inline std::ostream &operator<<(std::ostream &os, const std::deque<T_, Alloc_> &deq)
 {
-    if(!vec.empty())
-    {
-        os << "(* ";
-        std::copy(vec.begin(), vec.end() - 1, std::ostream_iterator<T_>(os, " < "));
-        os << vec.back() << " *)";
-    }
-    else
-        os << "(* *)";
+    string_builder sb;
 
-    return (os);
+    return (os << sb.append(deq).view());
 }
 
 /**
  * Generic ostream - &lt;&lt; operator for unordered sets.
  */
 template<typename Value, typename Hash, typename Pred, typename Alloc>
-inline std::ostream &operator<<(std::ostream &os, const std::unordered_set<Value, Hash, Pred, Alloc> &vec)
+inline std::ostream &operator<<(std::ostream &os, const std::unordered_set<Value, Hash, Pred, Alloc> &set)
 {
-    if(!vec.empty())
-    {
-        os << "{~ ";
-        for(auto it = vec.begin(); it != vec.end(); it++)
-        {
-            os << *it << " ";
-        }
-        os << "~}";
-    }
-    else
-        os << "{~ ~}";
+    string_builder sb;
 
-    return (os);
+    return (os << sb.append(set).view());
 }
 
 /**
@@ -142,9 +355,9 @@ inline std::ostream &operator<<(std::ostream &os, const std::unordered_set<Value
 template<typename T1_, typename T2_>
 inline std::ostream &operator<<(std::ostream &os, const std::pair<T1_, T2_> &p)
 {
-    os << "(" << p.first << "->" << p.second << ")";
+    string_builder sb(32);
 
-    return (os);
+    return (os << sb.append(p).view());
 }
 
 /**
@@ -153,19 +366,9 @@ inline std::ostream &operator<<(std::ostream &os, const std::pair<T1_, T2_> &p)
 template<typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
 inline std::ostream &operator<<(std::ostream &os, const std::unordered_map<Key, Value, Hash, Pred, Alloc> &m)
 {
-    if(!m.empty())
-    {
-        os << "{~ ";
-        for(auto it = m.begin(); it != m.end(); it++)
-        {
-            os << *it << " ";
-        }
-        os << "~}";
-    }
-    else
-        os << "{~ ~}";
+    string_builder sb;
 
-    return (os);
+    return (os << sb.append(m).view());
 }
 
 /**
@@ -174,19 +377,9 @@ inline std::ostream &operator<<(std::ostream &os, const std::unordered_map<Key,
 template<typename T1_, typename T2_, typename Compare_, typename Alloc_>
 inline std::ostream &operator<<(std::ostream &os, const std::map<T1_, T2_, Compare_, Alloc_> &m)
 {
-    if(!m.empty())
-    {
-        os << "[ ";
-        for(auto it = m.begin(); it != m.end(); it++)
-        {
-            os << *it << " ";
-        }
-        os << "]";
-    }
-    else
-        os << "[ ]";
+    string_builder sb;
 
-    return (os);
+    return (os << sb.append(m).view());
 }
 
 /**
@@ -209,18 +402,9 @@ inline std::vector<T_, Alloc_> vectorFromSet(const std::set<T_, Compare_, Alloc_
 template<typename T_, typename Compare_, typename Alloc_>
 inline std::ostream &operator<<(std::ostream &os, const std::set<T_, Compare_, Alloc_> &s)
 {
-    if(!s.empty())
-    {
-        auto vec = vectorFromSet(s);
+    string_builder sb;
 
-        os << "{ ";
-        std::copy(vec.begin(), vec.end() - 1, std::ostream_iterator<T_>(os, ", "));
-        os << vec.back() << " }";
-    }
-    else
-        os << "{ }";
-
-    return (os);
+    return (os << sb.append(s).view());
 }
 
 /**
@@ -256,30 +440,108 @@ inline std::set<Value> setFromUnordered(const std::unordered_set<Value, Hash, Pr
     return (reval);
 }
 
+/**
+ * Append v enclosed by brace on both sides to sb.
+ */
+template<typename T_>
+inline string_builder &enclosed(string_builder &sb, const T_ &v, std::string_view brace = "\"")
+{
+    return (sb.append(brace).append(v).append(brace));
+}
+
+/**
+ * Append v enclosed by custom braces to sb.
+ */
+template<typename T_>
+inline string_builder &
+ enclosed(string_builder &sb, const T_ &v, std::string_view leftBrace, std::string_view rightBrace)
+{
+    return (sb.append(leftBrace).append(v).append(rightBrace));
+}
+
+/**
+ * Append v enclosed by quote(") to sb.
+ */
+template<typename T_>
+inline string_builder &quoted(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "\""));
+}
+
+/**
+ * Append v enclosed by single quote(') to sb.
+ */
+template<typename T_>
+inline string_builder &squoted(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "'"));
+}
+
+/**
+ * Append v enclosed by braces({ and }) to sb.
+ */
+template<typename T_>
+inline string_builder &braced(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "{", "}"));
+}
+
+/**
+ * Append v enclosed by brackets([ and ]) to sb.
+ */
+template<typename T_>
+inline string_builder &bracketed(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "[", "]"));
+}
+
+/**
+ * Append v enclosed by angled braces(\< and \>) to sb.
+ */
+template<typename T_>
+inline string_builder &angled(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "<", ">"));
+}
+
+/**
+ * Append v enclosed by round braces to sb.
+ */
+template<typename T_>
+inline string_builder &roundBraced(string_builder &sb, const T_ &v)
+{
+    return (enclosed(sb, v, "(", ")"));
+}
+
 /**
  * Create an enclosed string copy of out-stream-able object.
  */
 template<typename T_>
 inline std::string enclosed(const T_ &v, const std::string &brace = "\"")
 {
-    std::stringstream ss;
+    string_builder sb(32);
 
-    ss << brace << v << brace;
-
-    return (ss.str());
+    return (std::move(enclosed(sb, v, std::string_view(brace))).str());
 }
 
 /**
  * Create a string copy of out-stream-able object enclosed by custom braces.
  */
 template<typename T_>
-inline std::string eclosed(const T_ &v, const std::string &leftBrace, const std::string &rightBrace)
+inline std::string enclosed(const T_ &v, const std::string &leftBrace, const std::string &rightBrace)
 {
-    std::stringstream ss;
+    string_builder sb(32);
 
-    ss << leftBrace << v << rightBrace;
+    return (std::move(enclosed(sb, v, std::string_view(leftBrace), std::string_view(rightBrace))).str());
+}
 
-    return (ss.str());
+/**
+ * Create a string copy of out-stream-able object enclosed by custom braces.
+ */
+template<typename T_>
+inline std::string eclosed(const T_ &v, const std::string &leftBrace, const std::string &rightBrace)
+{
+    return (enclosed(v, leftBrace, rightBrace));
 }
 
 /**
@@ -338,41 +600,104 @@ inline std::string roundBraced(const T_ &v)
     return (enclosed(v, "(", ")"));
 }
 
+/**
+ * Case fold table for case-insensitive strings: ASCII a-z map to A-Z, all other bytes to
+ * themselves (independent of the C locale).
+ */
+inline constexpr std::array<unsigned char, 256> ciFoldTable = []() {
+    std::array<unsigned char, 256> reval{};
+    for(size_t c = 0; c < reval.size(); c++)
+        reval[c] = static_cast<unsigned char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+    return (reval);
+}();
+
+/**
+ * Fold a single character with ciFoldTable.
+ */
+constexpr unsigned char ciFold(char c)
+{
+    return (ciFoldTable[static_cast<unsigned char>(c)]);
+}
+
+/**
+ * Fold the eight bytes packed into w as ciFold() would, without a table look-up per byte.
+ */
+constexpr uint64_t ciFoldWord(uint64_t w)
+{
+    constexpr uint64_t ones  = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+
+    uint64_t heptets = w & ~highs;
+    uint64_t geA     = heptets + ones * (0x80 - 'a');      // high bit set where byte >= 'a'
+    uint64_t gtZ     = heptets + ones * (0x80 - 'z' - 1);  // high bit set where byte >  'z'
+    uint64_t lower   = geA & ~gtZ & ~w & highs;            // ... and the byte was ASCII
+
+    return (w ^ (lower >> 2));
+}
+
+/**
+ * Case-insensitive hash of n bytes, consistent with ci_char_traits equality; folds and mixes
+ * eight bytes at a time.
+ */
+inline size_t ciHash(const char *s, size_t n)
+{
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ n;
+
+    for(; n >= sizeof(uint64_t); s += sizeof(uint64_t), n -= sizeof(uint64_t))
+    {
+        uint64_t w;
+        std::memcpy(&w, s, sizeof(w));
+        h = (h ^ ciFoldWord(w)) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+    if(n > 0)
+    {
+        uint64_t w = 0;
+        std::memcpy(&w, s, n);
+        h = (h ^ ciFoldWord(w)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+
+    return (static_cast<size_t>(h ^ (h >> 29)));
+}
+
 /**
  * Character traits for case-insensitive string type.
  * Inherits all the functions that we don't need to override for
- * case-insensitivity.
+ * case-insensitivity. Characters are compared through ciFoldTable.
  */
 struct ci_char_traits : public std::char_traits<char>
 {
     /**
      * Equality of two characters ignoring their case.
      */
-    static bool eq(char c1, char c2)
+    static constexpr bool eq(char c1, char c2)
     {
-        return (toupper(c1) == toupper(c2));
+        return (ciFold(c1) == ciFold(c2));
     }
 
     /**
      * Non-equality of two characters ignoring their case.
      */
-    static bool ne(char c1, char c2)
+    static constexpr bool ne(char c1, char c2)
     {
-        return (toupper(c1) != toupper(c2));
+        return (ciFold(c1) != ciFold(c2));
     }
 
     /**
      * Less-than of two characters ignoring their case.
      */
-    static bool lt(char c1, char c2)
+    static constexpr bool lt(char c1, char c2)
     {
-        return (toupper(c1) < toupper(c2));
+        return (ciFold(c1) < ciFold(c2));
     }
 
     /**
      * Returns the 1-based index of the first different char. This index is
      * multiplied by -1, if s1 \< s2 and 0 if s1==s2 up to n-th char or if
      * the first character == '\0'
+     * Runs of eight characters without '\0' that fold to the same word are
+     * skipped at once.
      */
     static int compare(const char *s1, const char *s2, size_t n)
     {
@@ -382,8 +707,24 @@ struct ci_char_traits : public std::char_traits<char>
         if(s1 == nullptr)
             return (s2 == nullptr ? 0 : -1);
 
+        constexpr uint64_t ones  = 0x0101010101010101ULL;
+        constexpr uint64_t highs = 0x8080808080808080ULL;
+
         size_t i = 0;
 
+        for(; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+        {
+            uint64_t w1;
+            uint64_t w2;
+            std::memcpy(&w1, s1, sizeof(w1));
+            std::memcpy(&w2, s2, sizeof(w2));
+            bool hasZero = (((w1 - ones) & ~w1) | ((w2 - ones) & ~w2)) & highs;
+            if(hasZero || ciFoldWord(w1) != ciFoldWord(w2))
+                break;
+            s1 += sizeof(uint64_t);
+            s2 += sizeof(uint64_t);
+        }
+
         while((i < n) && (*s1) && (*s2) && (eq(*s1, *s2)))
         {
             s1++;
@@ -399,16 +740,15 @@ struct ci_char_traits : public std::char_traits<char>
      */
     static const char *find(const char *s, int n, char a)
     {
-        const char *reval = nullptr;
-        while(n-- > 0 && reval == nullptr)
-        {
-            if(toupper(*s) == toupper(a))
-                reval = s;
+        unsigned char folded = ciFold(a);
 
-            ++s;
+        for(; n > 0; --n, ++s)
+        {
+            if(ciFold(*s) == folded)
+                return (s);
         }
 
-        return (reval);
+        return (nullptr);
     }
 };
 
@@ -456,15 +796,36 @@ void replaceChar(ci_string &      v,
                  StripTrimMode    m          = StripTrimMode::ALL);
 
 /**
- * Try to convert a string-representation into a bool-value.
+ * Try to convert a string-representation into a bool-value. Recognised are, in any case,
+ * true/t/yes/y/1/on and false/f/no/n/0/off, plus the tokens registered with addBoolToken().
+ * The built-in tokens are found by a compile-time perfect hash, without allocation.
+ *
+ * @param strVal the string-representation
+ * @param result receives the value, false if strVal is not a boolean token
+ *
+ * @return true if strVal is a boolean token, false otherwise
  */
-bool scanBoolString(const std::string &strVal, bool &result);
+bool scanBoolString(std::string_view strVal, bool &result);
 
 /**
  * Try to convert a string-representation into a bool-value.
  */
 bool scanBoolString(const ci_string &strVal, bool &result);
 
+/**
+ * Register an additional (case-insensitive) boolean token for scanBoolString(), e.g. "ja"
+ * or "nein". Re-registering a token changes its value. Safe to call concurrently with
+ * scanBoolString().
+ *
+ * @throw std::invalid_argument if the token is empty or a built-in token of the opposite value
+ */
+void addBoolToken(std::string_view token, bool value);
+
+/**
+ * Remove all tokens registered with addBoolToken().
+ */
+void resetBoolTokens();
+
 /**
  * Shortcut to trim only left occurrences of trimChars.
  */
@@ -571,12 +932,74 @@ inline void replaceCharRight(ci_string &v, const ci_string &stripChars = "\t \r\
     replaceChar(v, stripChars, repl, StripTrimMode::RIGHT);
 }
 
+/**
+ * Convert the ASCII letters of a standard string to lower case in place. Bytes outside A-Z are
+ * left alone, independent of the C locale.
+ */
+void toLowerInPlace(std::string &str);
+
+/**
+ * Convert the ASCII letters of a case-insensitive string to lower case in place.
+ */
+void toLowerInPlace(ci_string &str);
+
+/**
+ * Convert the ASCII letters of a standard string to upper case in place. Bytes outside a-z are
+ * left alone, independent of the C locale.
+ */
+void toUpperInPlace(std::string &str);
+
+/**
+ * Convert the ASCII letters of a case-insensitive string to upper case in place.
+ */
+void toUpperInPlace(ci_string &str);
+
+/**
+ * Offset of the first byte of str that is not part of a valid UTF-8 sequence (overlong forms,
+ * surrogates and code points above U+10FFFF are invalid), std::string_view::npos if str is valid.
+ * ASCII runs are skipped 32 bytes at a time.
+ */
+size_t findInvalidUtf8(std::string_view str);
+
+/**
+ * Whether str is valid UTF-8.
+ */
+inline bool isValidUtf8(std::string_view str)
+{
+    return (findInvalidUtf8(str) == std::string_view::npos);
+}
+
+/**
+ * Lower case copy of the UTF-8 string str. ASCII runs are converted in bulk; other letters of
+ * Latin-1, Latin Extended-A and -B (in part), Latin Extended Additional, Greek, Cyrillic,
+ * Armenian and fullwidth Latin are mapped one to one (simple case mapping, so the length in
+ * bytes may change). Invalid bytes are copied unchanged.
+ */
+std::string utf8ToLower(std::string_view str);
+
+/**
+ * Upper case copy of the UTF-8 string str, see utf8ToLower(). Letters without a single upper
+ * case letter, like sharp s, are left alone.
+ */
+std::string utf8ToUpper(std::string_view str);
+
+/**
+ * Case folded copy of the UTF-8 string str for case-insensitive comparison: the lower case of
+ * the upper case, so that e.g. final sigma and sigma, or long s and s, fold alike.
+ */
+std::string utf8FoldCase(std::string_view str);
+
+/**
+ * Whether lhs and rhs are equal after utf8FoldCase(), without creating the folded copies.
+ */
+bool utf8EqualsIgnoreCase(std::string_view lhs, std::string_view rhs);
+
 /**
  * Create an all-lower-case copy of standard string.
  */
 inline std::string toLower(std::string str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](char c) { return (tolower(c)); });
+    toLowerInPlace(str);
 
     return (str);
 }
@@ -586,7 +1009,7 @@ inline std::string toLower(std::string str)
  */
 inline std::string toLower(ci_string str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](char c) { return (tolower(c)); });
+    toLowerInPlace(str);
 
     return (str.c_str());
 }
@@ -596,7 +1019,7 @@ inline std::string toLower(ci_string str)
  */
 inline std::string toUpper(std::string str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](char c) { return (toupper(c)); });
+    toUpperInPlace(str);
 
     return (str);
 }
@@ -606,7 +1029,7 @@ inline std::string toUpper(std::string str)
  */
 inline std::string toUpper(ci_string str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](char c) { return (toupper(c)); });
+    toUpperInPlace(str);
 
     return (str.c_str());
 }
@@ -655,6 +1078,383 @@ std::set<ci_string> splitIntoSet(const ci_string &str, char sep);
  */
 std::set<ci_string> splitIntoSet(const ci_string &str, const ci_string &sep);
 
+/**
+ * Separator for split_view: a single character.
+ */
+struct char_separator
+{
+    explicit char_separator(char sep)
+    : sep_(sep)
+    {
+    }
+
+    size_t find(std::string_view str, size_t from) const
+    {
+        return (str.find(sep_, from));
+    }
+
+    size_t length() const
+    {
+        return (1);
+    }
+
+    private:
+    char sep_;
+};
+
+/**
+ * Separator for split_view: any one of a set of characters, looked up in a 256-entry table.
+ */
+struct any_of_separator
+{
+    explicit any_of_separator(std::string_view seps)
+    {
+        for(auto c: seps)
+            isSep_[static_cast<unsigned char>(c)] = true;
+    }
+
+    size_t find(std::string_view str, size_t from) const
+    {
+        for(size_t i = from; i < str.size(); i++)
+        {
+            if(isSep_[static_cast<unsigned char>(str[i])])
+                return (i);
+        }
+
+        return (std::string_view::npos);
+    }
+
+    size_t length() const
+    {
+        return (1);
+    }
+
+    private:
+    std::array<bool, 256> isSep_{};
+};
+
+/**
+ * Separator for split_view: an exact, non-empty sub-string. An empty separator never matches.
+ */
+struct substring_separator
+{
+    explicit substring_separator(std::string_view sep)
+    : sep_(sep)
+    {
+    }
+
+    size_t find(std::string_view str, size_t from) const
+    {
+        return (sep_.empty() ? std::string_view::npos : str.find(sep_, from));
+    }
+
+    size_t length() const
+    {
+        return (sep_.size());
+    }
+
+    private:
+    std::string_view sep_;
+};
+
+/**
+ * Lazy, allocation-free split of a string into string_view tokens. Tokens are produced with the
+ * same semantics as splitIntoVector(): consecutive separators give empty tokens and an empty
+ * string gives one empty token. The views point into the split string, which must outlive them.
+ */
+template<typename Sep_>
+class split_view
+{
+    public:
+    class iterator
+    {
+        public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::string_view;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const std::string_view *;
+        using reference         = std::string_view;
+
+        iterator() = default;
+
+        explicit iterator(const split_view *view)
+        : view_(view)
+        , next_(view->sep_.find(view->str_, 0))
+        {
+        }
+
+        std::string_view operator*() const
+        {
+            size_t end = next_ == std::string_view::npos ? view_->str_.size() : next_;
+
+            return (view_->str_.substr(start_, end - start_));
+        }
+
+        iterator &operator++()
+        {
+            if(next_ == std::string_view::npos)
+                view_ = nullptr;
+            else
+            {
+                start_ = next_ + view_->sep_.length();
+                next_  = view_->sep_.find(view_->str_, start_);
+            }
+
+            return (*this);
+        }
+
+        iterator operator++(int)
+        {
+            iterator reval = *this;
+            ++*this;
+
+            return (reval);
+        }
+
+        bool operator==(const iterator &rhs) const
+        {
+            return (view_ == rhs.view_ && (view_ == nullptr || start_ == rhs.start_));
+        }
+
+        bool operator==(std::default_sentinel_t) const
+        {
+            return (view_ == nullptr);
+        }
+
+        private:
+        const split_view *view_  = nullptr;
+        size_t            start_ = 0;
+        size_t            next_  = std::string_view::npos;
+    };
+
+    split_view(std::string_view str, Sep_ sep)
+    : str_(str)
+    , sep_(std::move(sep))
+    {
+    }
+
+    iterator begin() const
+    {
+        return (iterator(this));
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return (std::default_sentinel);
+    }
+
+    private:
+    std::string_view str_;
+    Sep_             sep_;
+};
+
+/**
+ * Lazily split str at each occurrence of the character sep.
+ */
+inline split_view<char_separator> splitView(std::string_view str, char sep)
+{
+    return (split_view<char_separator>(str, char_separator(sep)));
+}
+
+/**
+ * Lazily split str at each occurrence of any one of the characters in seps.
+ */
+inline split_view<any_of_separator> splitViewAnyOf(std::string_view str, std::string_view seps)
+{
+    return (split_view<any_of_separator>(str, any_of_separator(seps)));
+}
+
+/**
+ * Lazily split str at each occurrence of the sub-string sep.
+ */
+inline split_view<substring_separator> splitViewExact(std::string_view str, std::string_view sep)
+{
+    return (split_view<substring_separator>(str, substring_separator(sep)));
+}
+
+/**
+ * Split str into tokens stored in out, which is cleared first. Re-using out across calls avoids
+ * all allocations once its capacity suffices.
+ */
+template<typename Sep_>
+inline void splitIntoViews(std::string_view str, const Sep_ &sep, std::vector<std::string_view> &out)
+{
+    out.clear();
+    for(auto token: split_view<Sep_>(str, sep))
+        out.push_back(token);
+}
+
+/**
+ * Split str at each occurrence of the character sep into the re-used vector out.
+ */
+inline void splitIntoViews(std::string_view str, char sep, std::vector<std::string_view> &out)
+{
+    splitIntoViews(str, char_separator(sep), out);
+}
+
+/**
+ * A match found by aho_corasick: index of the pattern and offset of its first character in the
+ * searched text (in the whole stream for aho_corasick::stream).
+ */
+struct substring_match
+{
+    size_t pattern  = 0;
+    size_t position = 0;
+
+    bool operator==(const substring_match &rhs) const = default;
+};
+
+/**
+ * Aho-Corasick automaton: finds all occurrences of a set of patterns in a single pass over the
+ * text, independent of the number of patterns. Overlapping matches are all reported, in the order
+ * of their end position and, for the same end, longest pattern first.
+ * Bytes are mapped to a compact alphabet of the bytes occurring in the patterns, the goto function
+ * is a double-array (state t = base[s] + code is valid if check[t] == s) and failure links resolve
+ * missing transitions. The case-insensitive mode folds as ci_string does.
+ */
+class aho_corasick
+{
+    public:
+    /**
+     * Build the automaton.
+     * @throw std::invalid_argument if a pattern is empty
+     */
+    explicit aho_corasick(const std::vector<std::string> &patterns, bool caseInsensitive = false);
+
+    size_t patternCount() const
+    {
+        return (lengths_.size());
+    }
+
+    bool caseInsensitive() const
+    {
+        return (caseInsensitive_);
+    }
+
+    /**
+     * Size of the double-array: the states plus the slots left free when packing it.
+     */
+    size_t slots() const
+    {
+        return (slots_.size());
+    }
+
+    /**
+     * Call onMatch(substring_match) for every match in text.
+     */
+    template<typename F_>
+    void forEachMatch(std::string_view text, F_ onMatch) const
+    {
+        scan(text, 0, 0, onMatch);
+    }
+
+    /**
+     * All matches in text.
+     */
+    std::vector<substring_match> findAll(std::string_view text) const;
+
+    /**
+     * Whether any pattern occurs in text; stops at the first match.
+     */
+    bool containsAny(std::string_view text) const;
+
+    /**
+     * Matcher for text arriving in consecutive buffers: keeps the automaton state between calls
+     * to feed(), so that matches spanning buffer boundaries are found. Positions are offsets in
+     * the whole stream. The automaton must outlive the stream.
+     */
+    class stream
+    {
+        public:
+        explicit stream(const aho_corasick &automaton)
+        : automaton_(&automaton)
+        {
+        }
+
+        template<typename F_>
+        void feed(std::string_view buffer, F_ onMatch)
+        {
+            state_ = automaton_->scan(buffer, state_, offset_, onMatch);
+            offset_ += buffer.size();
+        }
+
+        /**
+         * Start over at offset 0.
+         */
+        void reset()
+        {
+            state_  = 0;
+            offset_ = 0;
+        }
+
+        /**
+         * Number of bytes fed since construction or the last reset().
+         */
+        size_t offset() const
+        {
+            return (offset_);
+        }
+
+        private:
+        const aho_corasick *automaton_;
+        uint32_t            state_  = 0;
+        size_t              offset_ = 0;
+    };
+
+    private:
+    /**
+     * One cell of the double-array, holding everything a transition into it needs to look at.
+     */
+    struct slot
+    {
+        uint32_t base     = 0;           ///< children of the state are at base + code
+        uint32_t check    = UINT32_MAX;  ///< state owning this slot, UINT32_MAX if free
+        uint32_t fail     = 0;           ///< failure link
+        uint32_t outBegin = 0;           ///< first of the state's outputs in outputs_, 0 if none
+    };
+
+    static constexpr uint32_t endOfOutputs = UINT32_MAX;
+
+    uint32_t next(uint32_t state, unsigned char c) const
+    {
+        uint32_t code = codes_[c];
+
+        if(code == 0)
+            return (0);
+        for(;;)
+        {
+            // the array is padded so that base + code never leaves it
+            uint32_t t = slots_[state].base + code;
+            if(slots_[t].check == state)
+                return (t);
+            if(state == 0)
+                return (0);
+            state = slots_[state].fail;
+        }
+    }
+
+    template<typename F_>
+    uint32_t scan(std::string_view text, uint32_t state, size_t offset, F_ &onMatch) const
+    {
+        for(size_t i = 0; i < text.size(); i++)
+        {
+            state = next(state, static_cast<unsigned char>(text[i]));
+            if(slots_[state].outBegin == 0)
+                continue;
+            for(uint32_t o = slots_[state].outBegin; outputs_[o] != endOfOutputs; o++)
+                onMatch(substring_match{outputs_[o], offset + i + 1 - lengths_[outputs_[o]]});
+        }
+
+        return (state);
+    }
+
+    bool                      caseInsensitive_;
+    std::array<uint16_t, 256> codes_{};  ///< byte -> alphabet code, 0 for bytes in no pattern
+    std::vector<slot>         slots_;    ///< the double-array
+    std::vector<uint32_t>     outputs_;  ///< pattern indices per state, each list ends with endOfOutputs
+    std::vector<size_t>       lengths_;  ///< length of each pattern
+};
+
 /**
  * Classify a string into one of the classes NONE, INT, UINT, FLOAT.
  * invalid strings have class NONE
@@ -670,6 +1470,33 @@ NumberClass classifyNumberString(const std::string &str);
  */
 NumberClass classifyNumberString(const ci_string &str);
 
+/**
+ * Classify and convert a number string in a single pass. Accepted is an optional sign, digits with
+ * an optional decimal point (at least one digit), an optional exponent "e[+-]digits" in any case
+ * and an optional suffix 'l' or 'L'.
+ * Without decimal point and exponent the string is INT if the value fits into int64_t, otherwise
+ * UINT if it is not negative and fits into uint64_t, otherwise FLOAT.
+ * Floats of up to 19 significant digits and a small exponent are converted with a single
+ * floating point operation, others with std::from_chars(); both are correctly rounded.
+ *
+ * @param str the string to scan
+ * @param value receives class and value, reset to NumberValue() for strings of class NONE
+ *
+ * @return the class of str
+ */
+NumberClass scanNumberString(std::string_view str, NumberValue &value);
+
+/**
+ * Scan a column of number strings into values (resized to the size of cells).
+ * The column class is the narrowest class that holds every cell: INT if all cells are INT, UINT
+ * if all are INT or UINT and none is negative, FLOAT if all are numbers, and NONE if any cell
+ * is not a number or the column is empty. Unless NONE, each value additionally carries its number
+ * in the member of the column class, so that the column can be read uniformly.
+ *
+ * @return the class of the column
+ */
+NumberClass scanNumberStrings(std::span<const std::string_view> cells, std::vector<NumberValue> &values);
+
 };
 // namespace util
 
@@ -684,9 +1511,7 @@ struct hash<util::ci_string> : public unary_function<util::ci_string, size_t>
 {
     std::size_t operator()(const util::ci_string &s) const
     {
-        hash<string> hasher;
-
-        return (hasher(util::toLower(s)));
+        return (util::ciHash(s.data(), s.size()));
     }
 };
 };
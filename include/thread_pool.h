@@ -0,0 +1,207 @@
+/*
+ * File:        thread_pool.h
+ * Description: Fixed-size pool of worker threads.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_THREAD_POOL_H_INCLUDED
+#define NS_UTIL_THREAD_POOL_H_INCLUDED
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+/**
+ * Fixed-size pool of worker threads that execute submitted tasks in FIFO order.
+ * Tasks must not wait for other tasks of the same pool: with all workers waiting nothing is left
+ * to run them. parallelFor() and other users that check inWorker() do their work on the calling
+ * worker instead.
+ */
+class thread_pool
+{
+    public:
+    explicit thread_pool(size_t threads = defaultSize())
+    {
+        for(size_t i = 0; i < std::max(size_t(1), threads); i++)
+            workers_.emplace_back([this] { work(); });
+    }
+
+    thread_pool(const thread_pool &)            = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for(auto &w: workers_)
+            w.join();
+    }
+
+    /**
+     * Number of worker threads.
+     */
+    size_t size() const
+    {
+        return (workers_.size());
+    }
+
+    /**
+     * Whether the calling thread is one of the workers of this pool.
+     */
+    bool inWorker() const
+    {
+        return (currentPool() == this);
+    }
+
+    /**
+     * Queue f for execution; the future delivers its result or exception.
+     */
+    template<typename F_>
+    std::future<std::invoke_result_t<F_>> submit(F_ f)
+    {
+        using result_type = std::invoke_result_t<F_>;
+
+        auto task  = std::make_shared<std::packaged_task<result_type()>>(std::move(f));
+        auto reval = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([task] { (*task)(); });
+        }
+        wakeUp_.notify_one();
+
+        return (reval);
+    }
+
+    /**
+     * Call f(begin, end) for consecutive sub-ranges of [0, n) of at least grain elements, using the
+     * workers and the calling thread, and return when all are done. The first exception thrown by
+     * f is re-thrown. Small n, and calls from a worker of this pool, are processed on the calling
+     * thread only.
+     */
+    template<typename F_>
+    void parallelFor(size_t n, size_t grain, F_ f)
+    {
+        size_t chunks = std::min(size() + 1, (n + std::max(size_t(1), grain) - 1) / std::max(size_t(1), grain));
+
+        if(chunks <= 1 || inWorker())
+        {
+            if(n > 0)
+                f(size_t(0), n);
+            return;
+        }
+
+        size_t                         chunkSize = (n + chunks - 1) / chunks;
+        std::vector<std::future<void>> pending;
+        for(size_t begin = chunkSize; begin < n; begin += chunkSize)
+        {
+            size_t end = std::min(n, begin + chunkSize);
+            pending.push_back(submit([&f, begin, end] { f(begin, end); }));
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            f(size_t(0), std::min(n, chunkSize));
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        for(auto &p: pending)
+        {
+            try
+            {
+                p.get();
+            }
+            catch(...)
+            {
+                if(!error)
+                    error = std::current_exception();
+            }
+        }
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    /**
+     * Process-wide pool with one worker per hardware thread.
+     */
+    static thread_pool &shared()
+    {
+        static thread_pool pool;
+
+        return (pool);
+    }
+
+    static size_t defaultSize()
+    {
+        return (std::max(1U, std::thread::hardware_concurrency()));
+    }
+
+    private:
+    static const thread_pool *&currentPool()
+    {
+        thread_local const thread_pool *reval = nullptr;
+
+        return (reval);
+    }
+
+    void work()
+    {
+        currentPool() = this;
+        for(;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeUp_.wait(lock, [this] { return (stopping_ || !tasks_.empty()); });
+                if(tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    std::mutex                        mutex_;
+    std::condition_variable           wakeUp_;
+    std::queue<std::function<void()>> tasks_;
+    bool                              stopping_ = false;
+    std::vector<std::thread>          workers_;
+};
+};
+// namespace util
+
+#endif  // NS_UTIL_THREAD_POOL_H_INCLUDED
@@ -28,12 +28,15 @@
 
 namespace util
 {
+/**
+ * Wall-clock stop watch; see profiling.h for cheap timing of scopes.
+ */
 class timer
 {
     private:
-    using clock_t      = std::chrono::high_resolution_clock;
+    using clock_t      = std::chrono::steady_clock;
     using second_t     = std::chrono::duration<double, std::ratio<1>>;
-    using nanosecond_t = std::chrono::duration<double, std::ratio<1>>;
+    using nanosecond_t = std::chrono::duration<double, std::nano>;
 
     std::chrono::time_point<clock_t> start_;
 
@@ -43,7 +46,18 @@ class timer
         start_ = clock_t::now();
     }
 
+    /**
+     * Seconds since start().
+     */
     double elapsed() const
+    {
+        return (std::chrono::duration_cast<second_t>(clock_t::now() - start_).count());
+    }
+
+    /**
+     * Nanoseconds since start().
+     */
+    double elapsedNanoseconds() const
     {
         return (std::chrono::duration_cast<nanosecond_t>(clock_t::now() - start_).count());
     }
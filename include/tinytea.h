@@ -28,13 +28,22 @@
 #ifndef TINYTEA_H_INCLUDED
 #define TINYTEA_H_INCLUDED
 
+#include <cstddef>
 #include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
 namespace util
 {
 #define multiTea x9E3779BA
 #define tinyTea  x9E3779B9
 #define encrypt  x9E3779B8
 #define decrypt  x9E3779B7
+#define tinyXtea x9E3779B6
+#define tea_ctr  x9E3779B5
+#define tea_file_cipher x9E3779B4
 
 /**
  * TEA takes 64 bits of data in v[0] and v[1], and 128 bits of key in k[0] - k[3].
@@ -133,7 +142,7 @@ union multiTea
 
     my_tt& operator[](unsigned char index)
     {
-        return (tt_[index % 2]);
+        return (tt_[index % num_tts]);
     }
 
     static multiTea encrypt(multiTea val, my_tt key1, my_tt key2)
@@ -160,6 +169,225 @@ union multiTea
         return (reval);
     }
 };
+
+/**
+ * XTEA, the successor of TEA with a stronger key schedule, on the same 64-bit blocks and
+ * 128-bit keys: key1 holds key words 0 and 1, key2 words 2 and 3, in their low and high halves.
+ */
+template<uint32_t delta = 0x9E3779B9>
+struct tinyXtea
+{
+    static constexpr uint32_t setupSum = (delta << 5);  // setupSum is 32*delta
+
+    static uint64_t encrypt(uint64_t val, uint64_t key1, uint64_t key2)
+    {
+        const uint32_t key[4] = {uint32_t(key1), uint32_t(key1 >> 32), uint32_t(key2), uint32_t(key2 >> 32)};
+        uint32_t       v0     = uint32_t(val);
+        uint32_t       v1     = uint32_t(val >> 32);
+
+        for(uint32_t i = 0, sum = 0U; i < 32; i++)
+        {
+            v0 += (((v1 << 4) ^ (v1 >> 5)) + v1) ^ (sum + key[sum & 3]);
+            sum += delta;
+            v1 += (((v0 << 4) ^ (v0 >> 5)) + v0) ^ (sum + key[(sum >> 11) & 3]);
+        }
+
+        return (uint64_t(v1) << 32 | v0);
+    }
+
+    static uint64_t decrypt(uint64_t val, uint64_t key1, uint64_t key2)
+    {
+        const uint32_t key[4] = {uint32_t(key1), uint32_t(key1 >> 32), uint32_t(key2), uint32_t(key2 >> 32)};
+        uint32_t       v0     = uint32_t(val);
+        uint32_t       v1     = uint32_t(val >> 32);
+
+        for(uint32_t i = 0, sum = setupSum; i < 32; i++)
+        {
+            v1 -= (((v0 << 4) ^ (v0 >> 5)) + v0) ^ (sum + key[(sum >> 11) & 3]);
+            sum -= delta;
+            v0 -= (((v1 << 4) ^ (v1 >> 5)) + v1) ^ (sum + key[sum & 3]);
+        }
+
+        return (uint64_t(v1) << 32 | v0);
+    }
+};
+
+enum class TeaVariant
+{
+    TEA,
+    XTEA
+};
+
+/**
+ * Implementations of the bulk functions: one block at a time, 16 blocks in SSE2 registers of
+ * four blocks each (generic 128-bit vectors on other processors), or 16 blocks in AVX2
+ * registers of eight.
+ */
+enum class TeaKernel
+{
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+/**
+ * Whether the processor can run kernel.
+ */
+bool teaKernelSupported(TeaKernel kernel);
+
+/**
+ * The fastest kernel the processor supports.
+ */
+TeaKernel bestTeaKernel();
+
+/**
+ * En-/decrypt each block in place, as tinyTea<>::encrypt()/decrypt() or tinyXtea<> would
+ * (electronic code book mode).
+ * @throw std::invalid_argument if the processor does not support kernel
+ */
+void teaEncryptBlocks(std::span<uint64_t> blocks,
+                      uint64_t            key1,
+                      uint64_t            key2,
+                      TeaVariant          variant = TeaVariant::TEA,
+                      TeaKernel           kernel  = bestTeaKernel());
+void teaDecryptBlocks(std::span<uint64_t> blocks,
+                      uint64_t            key1,
+                      uint64_t            key2,
+                      TeaVariant          variant = TeaVariant::TEA,
+                      TeaKernel           kernel  = bestTeaKernel());
+
+/**
+ * TEA or XTEA in counter (CTR) mode: the data is XOR-ed with the encrypted blocks nonce,
+ * nonce + 1, ..., taken as little-endian bytes. Encryption and decryption are the same
+ * operation, any length is allowed without padding, and any part of a stream can be processed
+ * on its own given its offset.
+ * The nonce must be unique per key and the counter ranges of two streams must not overlap, so
+ * use random 64-bit nonces or leave enough room between them.
+ * The blocks agree with tinyTea<> and tinyXtea<> on little-endian machines.
+ */
+class tea_ctr
+{
+    public:
+    tea_ctr(uint64_t   key1,
+            uint64_t   key2,
+            uint64_t   nonce,
+            TeaVariant variant = TeaVariant::TEA,
+            TeaKernel  kernel  = bestTeaKernel())
+    : key_{uint32_t(key1), uint32_t(key1 >> 32), uint32_t(key2), uint32_t(key2 >> 32)}
+    , nonce_(nonce)
+    , variant_(variant)
+    , kernel_(kernel)
+    {
+        if(!teaKernelSupported(kernel))
+            throw std::invalid_argument("tea_ctr: kernel not supported by this processor");
+    }
+
+    /**
+     * En- or decrypt data in place; streamOffset is the position of data[0] in the stream.
+     * The key stream is computed 64 blocks at a time with the kernel given on construction.
+     * Large buffers are processed on the shared thread_pool.
+     */
+    void apply(std::span<std::byte> data, uint64_t streamOffset = 0) const;
+
+    /**
+     * En- or decrypt in into out, which must have the same size.
+     * @throw std::invalid_argument if the sizes differ
+     */
+    void apply(std::span<const std::byte> in, std::span<std::byte> out, uint64_t streamOffset = 0) const;
+
+    /**
+     * As apply(), but always on the calling thread, e.g. for tasks of the shared thread_pool.
+     */
+    void applySequential(std::span<std::byte> data, uint64_t streamOffset = 0) const;
+
+    /**
+     * The key stream blocks firstBlock, firstBlock + 1, ... (counted from the nonce).
+     */
+    void keyStream(uint64_t firstBlock, std::span<uint64_t> out) const;
+
+    uint64_t nonce() const
+    {
+        return (nonce_);
+    }
+
+    TeaVariant variant() const
+    {
+        return (variant_);
+    }
+
+    private:
+    void applyRange(const std::byte *in, std::byte *out, size_t size, uint64_t streamOffset) const;
+
+    uint32_t   key_[4];
+    uint64_t   nonce_;
+    TeaVariant variant_;
+    TeaKernel  kernel_;
+};
+
+/**
+ * Streaming file encryption with tea_ctr: chunks are read into a bounded set of buffers,
+ * en-/decrypted in parallel on the shared thread_pool and written back in order, so memory use
+ * does not depend on the size of the data. Called from a task of the shared thread_pool, the
+ * chunks are en-/decrypted on the calling thread instead.
+ * The output starts with a 20 byte header, all numbers little-endian:
+ * <pre>
+ *   0  "UTEA"        magic
+ *   4  uint8_t       format version (1)
+ *   5  uint8_t       TeaVariant
+ *   6  uint16_t      reserved (0)
+ *   8  uint32_t      chunk size used for encryption (informational only)
+ *  12  uint64_t      nonce
+ * </pre>
+ * followed by the cipher text, which is as long as the plain text. There is no authentication:
+ * decrypting with the wrong key yields garbage rather than an error.
+ */
+class tea_file_cipher
+{
+    public:
+    static constexpr size_t headerSize       = 20;
+    static constexpr size_t defaultChunkSize = 1 << 20;
+
+    /**
+     * @throw std::invalid_argument if chunkSize is 0 or does not fit into 32 bits
+     */
+    tea_file_cipher(uint64_t   key1,
+                    uint64_t   key2,
+                    TeaVariant variant   = TeaVariant::TEA,
+                    size_t     chunkSize = defaultChunkSize);
+
+    /**
+     * Write the header and the encryption of all of in to out; returns the number of bytes
+     * encrypted.
+     * @throw std::runtime_error if out fails
+     */
+    uint64_t encryptStream(std::istream &in, std::ostream &out, uint64_t nonce) const;
+
+    /**
+     * Read the header from in and write the decryption of the rest to out; returns the number of
+     * bytes decrypted. The variant is taken from the header, the chunk size is that of this
+     * cipher whatever the header says.
+     * @throw std::runtime_error if the header is missing or invalid, or if out fails
+     */
+    uint64_t decryptStream(std::istream &in, std::ostream &out) const;
+
+    /**
+     * Encrypt the file inPath to outPath with a random nonce.
+     * @throw std::runtime_error if a file cannot be opened or written
+     */
+    uint64_t encryptFile(const std::string &inPath, const std::string &outPath) const;
+    uint64_t decryptFile(const std::string &inPath, const std::string &outPath) const;
+
+    size_t chunkSize() const
+    {
+        return (chunkSize_);
+    }
+
+    private:
+    uint64_t key1_;
+    uint64_t key2_;
+    TeaVariant variant_;
+    size_t     chunkSize_;
+};
 };
 // namespace util
 
@@ -0,0 +1,240 @@
+/*
+ * File:        trace_backend.h
+ * Description: Asynchronous tracing into per-thread ring buffers.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+
+#ifndef NS_UTIL_TRACE_BACKEND_H_INCLUDED
+#define NS_UTIL_TRACE_BACKEND_H_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <profiling.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace util
+{
+/**
+ * Levels are prefixed because DEBUG and ERROR are commonly defined as macros (-DDEBUG,
+ * <windows.h>).
+ */
+enum class TraceLevel : uint8_t
+{
+    TRACE_DEBUG,
+    TRACE_INFO,
+    TRACE_WARNING,
+    TRACE_ERROR,
+    TRACE_OFF
+};
+
+/**
+ * Records of a lower level are discarded at the call site, before their arguments are encoded.
+ */
+void       setTraceLevel(TraceLevel level);
+TraceLevel traceLevel();
+
+/**
+ * Write the trace to the file path (truncated), or to std::cout if path is empty. Records are
+ * collected in a ring buffer of bytesPerThread bytes per thread and written by a background
+ * thread; records that do not fit into a full buffer are dropped and counted, so that tracing
+ * never blocks. Tracing starts to std::cout on the first record if it has not been started.
+ * @throw std::runtime_error if the file cannot be opened
+ */
+void startTracing(const std::string &path = "", size_t bytesPerThread = size_t(1) << 16);
+
+/**
+ * Write out all pending records and stop the background thread.
+ */
+void stopTracing();
+
+/**
+ * Return once all records made before the call are written.
+ */
+void flushTracing();
+
+/**
+ * Number of records dropped because a ring buffer was full.
+ */
+uint64_t droppedTraceRecords();
+
+/**
+ * Number a trace statement; names are the comma-separated names of its arguments.
+ */
+uint32_t registerTraceSite(const char *file, int line, const char *function, const char *names, TraceLevel level);
+
+namespace trace_detail
+{
+    extern std::atomic<uint8_t> threshold;
+
+    /**
+     * Type tags of encoded arguments.
+     */
+    enum class ArgType : uint8_t
+    {
+        INT,
+        UINT,
+        FLOAT,
+        BOOL,
+        CHAR,
+        STRING,
+        POINTER
+    };
+
+    /**
+     * Binary record: uint16_t size, uint64_t ticks, uint32_t site, then per argument a type tag
+     * and its value; strings as uint16_t length and bytes. Arguments that do not fit are cut off.
+     */
+    class record_builder
+    {
+        public:
+        static constexpr size_t maxBytes    = 1024;
+        static constexpr size_t headerBytes = sizeof(uint16_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+        explicit record_builder(uint32_t site)
+        {
+            uint64_t ticks = profileTicks();
+            std::memcpy(bytes_ + sizeof(uint16_t), &ticks, sizeof(ticks));
+            std::memcpy(bytes_ + sizeof(uint16_t) + sizeof(ticks), &site, sizeof(site));
+        }
+
+        template<typename T_>
+        void put(ArgType type, T_ value)
+        {
+            if(size_ + 1 + sizeof(value) > maxBytes)
+                return;
+            bytes_[size_++] = char(type);
+            std::memcpy(bytes_ + size_, &value, sizeof(value));
+            size_ += sizeof(value);
+        }
+
+        void putString(std::string_view text)
+        {
+            constexpr size_t prefix = 1 + sizeof(uint16_t);
+            if(size_ + prefix > maxBytes)
+                return;
+            uint16_t length = uint16_t(std::min(text.size(), maxBytes - size_ - prefix));
+            bytes_[size_++] = char(ArgType::STRING);
+            std::memcpy(bytes_ + size_, &length, sizeof(length));
+            std::memcpy(bytes_ + size_ + sizeof(length), text.data(), length);
+            size_ += sizeof(length) + length;
+        }
+
+        /**
+         * The finished record, with its size filled in.
+         */
+        std::string_view finish()
+        {
+            uint16_t size = uint16_t(size_);
+            std::memcpy(bytes_, &size, sizeof(size));
+
+            return (std::string_view(bytes_, size_));
+        }
+
+        private:
+        char   bytes_[maxBytes];
+        size_t size_ = headerBytes;
+    };
+
+    template<typename T_>
+    void encode(record_builder &record, const T_ &value)
+    {
+        if constexpr(std::is_same_v<T_, bool>)
+            record.put(ArgType::BOOL, uint8_t(value));
+        else if constexpr(std::is_same_v<T_, char> || std::is_same_v<T_, signed char> ||
+                          std::is_same_v<T_, unsigned char>)
+            record.put(ArgType::CHAR, char(value));  // characters, as streamed
+        else if constexpr(std::is_integral_v<T_> && std::is_signed_v<T_>)
+            record.put(ArgType::INT, int64_t(value));
+        else if constexpr(std::is_integral_v<T_>)
+            record.put(ArgType::UINT, uint64_t(value));
+        else if constexpr(std::is_enum_v<T_>)
+            encode(record, +std::underlying_type_t<T_>(value));  // a number, even if the type is char
+        else if constexpr(std::is_floating_point_v<T_>)
+            record.put(ArgType::FLOAT, double(value));
+        else if constexpr(std::is_convertible_v<const T_ &, std::string_view>)
+        {
+            if constexpr(std::is_pointer_v<T_>)
+            {
+                if(value == nullptr)
+                {
+                    record.putString("(null)");
+                    return;
+                }
+            }
+            record.putString(std::string_view(value));
+        }
+        else if constexpr(std::is_pointer_v<T_>)
+            record.put(ArgType::POINTER, reinterpret_cast<uintptr_t>(value));
+        else
+        {
+            // anything else that can be streamed is formatted at the call site
+            std::ostringstream os;
+            os << value;
+            record.putString(os.str());
+        }
+    }
+
+    /**
+     * Append the record to the ring buffer of the calling thread.
+     */
+    void submit(std::string_view record);
+
+    template<typename... Args_>
+    void emit(uint32_t site, const Args_ &...args)
+    {
+        record_builder record(site);
+        (encode(record, args), ...);
+        submit(record.finish());
+    }
+};
+// namespace trace_detail
+
+inline bool traceEnabled(TraceLevel level)
+{
+    return (uint8_t(level) >= trace_detail::threshold.load(std::memory_order_relaxed));
+}
+};
+// namespace util
+
+/**
+ * Trace the location, resp. the location and the values of the arguments with their names.
+ */
+#define UTIL_TRACE_NAMED_(level_, names_, ...)                                          \
+    do                                                                                  \
+    {                                                                                   \
+        if(util::traceEnabled(level_))                                                  \
+        {                                                                               \
+            static const uint32_t utilTraceSite_ =                                      \
+             util::registerTraceSite(__FILE__, __LINE__, __FUNCTION__, names_, level_); \
+            util::trace_detail::emit(utilTraceSite_ __VA_OPT__(, ) __VA_ARGS__);        \
+        }                                                                               \
+    } while(false)
+
+#define UTIL_TRACE(level_)              UTIL_TRACE_NAMED_(level_, "")
+#define UTIL_TRACE_VALUES(level_, ...)  UTIL_TRACE_NAMED_(level_, #__VA_ARGS__, __VA_ARGS__)
+
+#endif  // NS_UTIL_TRACE_BACKEND_H_INCLUDED
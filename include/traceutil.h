@@ -29,23 +29,26 @@
 
 #if defined DO_TRACE_
 
-    #define TRACE0                                                                        \
-        {                                                                                 \
-            std::cout << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << std::endl; \
+    #include <trace_backend.h>
+    #include <unistd.h>
+
+    // records are written asynchronously, see trace_backend.h
+    #define TRACE0                               \
+        {                                        \
+            UTIL_TRACE(util::TraceLevel::TRACE_DEBUG); \
         }
-    #define TRACE1(v1)                                                                                               \
-        {                                                                                                            \
-            std::cout << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << " " << #v1 << "=" << v1 << std::endl; \
+    #define TRACE1(v1)                                      \
+        {                                                   \
+            UTIL_TRACE_VALUES(util::TraceLevel::TRACE_DEBUG, v1); \
         }
     // multi process versions for forked processes
-    #define PTRACE0                                                                                              \
-        {                                                                                                        \
-            std::cout << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << " PID=" << getpid() << std::endl; \
+    #define PTRACE0                                                      \
+        {                                                                \
+            UTIL_TRACE_NAMED_(util::TraceLevel::TRACE_DEBUG, "PID", getpid()); \
         }
-    #define PTRACE1(v1)                                                                                          \
-        {                                                                                                        \
-            std::cout << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << " PID=" << getpid() << " " << #v1 \
-                      << "=" << v1 << std::endl;                                                                 \
+    #define PTRACE1(v1)                                                           \
+        {                                                                         \
+            UTIL_TRACE_NAMED_(util::TraceLevel::TRACE_DEBUG, "PID," #v1, getpid(), v1); \
         }
 
 #else
@@ -172,7 +172,8 @@ bool Node::makeUniform(const VALUERANGES_TYPE &conditionValueRanges)
             throw distribution_error(distribution_error::empty_uniform);
 
         eventValueRanges[name()] = range();
-        pDistribution_           = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution            = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution_           = pDistribution;
 
         if(pDistribution == nullptr)
             throw bad_alloc();
@@ -196,7 +197,8 @@ bool Node::normalise(const VALUERANGES_TYPE &conditionValueRanges)
             throw distribution_error(distribution_error::empty_normalise);
 
         eventValueRanges[name()] = range();
-        pDistribution_           = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution            = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution_           = pDistribution;
 
         if(pDistribution == nullptr)
             throw bad_alloc();
@@ -222,7 +224,8 @@ bool Node::canonise(const VALUERANGES_TYPE &conditionValueRanges)
             throw distribution_error(distribution_error::empty_canonise);
 
         eventValueRanges[name()] = range();
-        pDistribution_           = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution            = new DiscreteProbability(eventValueRanges, conditionValueRanges);
+        pDistribution_           = pDistribution;
 
         if(pDistribution == nullptr)
             throw bad_alloc();
@@ -0,0 +1,340 @@
+/*
+ * File:        bit_stream.cc
+ * Description: Bulk packing and unpacking of N-bit fields.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "cpu_features.h"
+
+#include <bit_converter.h>
+#include <bit_stream.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <immintrin.h>
+#endif
+
+namespace util
+{
+using namespace std;
+
+namespace
+{
+    void checkArguments(const char *function, size_t bytes, size_t count, unsigned bits, unsigned elementBits)
+    {
+        if(bits == 0 || bits > elementBits)
+            throw invalid_argument(string(function) + ": field width " + to_string(bits) + " is not in 1.." +
+                                   to_string(elementBits));
+        if(bytes < packedSize(count, bits))
+            throw out_of_range(string(function) + ": " + to_string(count) + " fields of " + to_string(bits) +
+                               " bits need " + to_string(packedSize(count, bits)) + " bytes but only " +
+                               to_string(bytes) + " are given");
+    }
+
+    inline uint64_t fieldMask(unsigned bits)
+    {
+        return (bits >= 64 ? ~0ULL : (1ULL << bits) - 1);
+    }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    /**
+     * Eight fields of up to 16 bits occupy at most 16 bytes: broadcast them to both halves of a
+     * 256-bit register, gather the (up to three) bytes of each field into a 32-bit lane, in
+     * stream order, and shift and mask all lanes at once. Returns the number of fields unpacked.
+     */
+    __attribute__((target("avx2"))) size_t
+     unpackAvx2(const byte *in, size_t inSize, unsigned bits, uint32_t *out, size_t count, endian order)
+    {
+        alignas(32) uint8_t  shuffle[32];
+        alignas(32) uint32_t shifts[8];
+        for(unsigned lane = 0; lane < 8; lane++)
+        {
+            unsigned first = lane * bits / 8;
+            unsigned last  = (lane * bits + bits - 1) / 8;
+            unsigned shift = lane * bits % 8;
+            for(unsigned k = 0; k < 4; k++)
+            {
+                uint8_t source = first + k <= last ? uint8_t(first + k) : uint8_t(0x80);
+                shuffle[4 * lane + (order == endian::little ? k : 3 - k)] = source;
+            }
+            shifts[lane] = order == endian::little ? shift : 32 - shift - bits;
+        }
+
+        __m256i selectBytes = _mm256_load_si256(reinterpret_cast<const __m256i *>(shuffle));
+        __m256i shiftLanes  = _mm256_load_si256(reinterpret_cast<const __m256i *>(shifts));
+        __m256i mask        = _mm256_set1_epi32(int(fieldMask(bits)));
+
+        size_t i = 0;
+        for(; i + 8 <= count && i / 8 * bits + 16 <= inSize; i += 8)
+        {
+            __m128i block  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i / 8 * bits));
+            __m256i fields = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(block), selectBytes);
+            fields         = _mm256_and_si256(_mm256_srlv_epi32(fields, shiftLanes), mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), fields);
+        }
+
+        return (i);
+    }
+#endif
+
+    /**
+     * Unpack fields first.. one 64-bit load each; fields that do not fit into one load, and
+     * those at the very end of in, go through peekBits().
+     */
+    template<typename T_>
+    void unpackWords(span<const byte> in, unsigned bits, span<T_> out, endian order, size_t first)
+    {
+        size_t lastWord = in.size() >= sizeof(uint64_t) ? in.size() - sizeof(uint64_t) : 0;
+        bool   inWords  = in.size() >= sizeof(uint64_t);
+
+        for(size_t i = first; i < out.size(); i++)
+        {
+            size_t   position = i * bits;
+            unsigned shift    = position % 8;
+            if(inWords && position / 8 <= lastWord && shift + bits <= 64)
+            {
+                bit_converter<uint64_t> window;
+                memcpy(window.byte, in.data() + position / 8, sizeof(uint64_t));
+                if(order == endian::little)
+                {
+                    out[i] = T_(window.getBits(shift, bits));
+                }
+                else
+                {
+                    window.swapBytes();
+                    out[i] = T_(window.getBits(64 - shift - bits, bits));
+                }
+            }
+            else
+            {
+                out[i] = T_(peekBits(in, position, bits, order));
+            }
+        }
+    }
+
+    template<typename T_>
+    void unpackAll(span<const byte> in, unsigned bits, span<T_> out, endian order)
+    {
+        checkArguments("unpackBits()", in.size(), out.size(), bits, sizeof(T_) * 8);
+
+        size_t done = 0;
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr(is_same_v<T_, uint32_t>)
+        {
+            if(bits <= 16 && out.size() >= 8 && hasAvx2())
+                done = unpackAvx2(in.data(), in.size(), bits, out.data(), out.size(), order);
+        }
+#endif
+        unpackWords(in, bits, out, order, done);
+    }
+
+    /**
+     * Collects fields in a 64-bit accumulator and stores whole bytes, eight at a time where out
+     * has room for them.
+     */
+    class field_packer
+    {
+        public:
+        field_packer(span<byte> out, size_t packedBytes, endian order)
+        : out_(out.data())
+        , wordEnd_(packedBytes >= sizeof(uint64_t) ? packedBytes - sizeof(uint64_t) : 0)
+        , inWords_(packedBytes >= sizeof(uint64_t))
+        , order_(order)
+        {
+        }
+
+        void add(uint64_t value, unsigned bits)
+        {
+            if(bits > 56)
+            {
+                // does not fit next to the up to seven pending bits
+                if(order_ == endian::little)
+                {
+                    add(value, 32);
+                    add(value >> 32, bits - 32);
+                }
+                else
+                {
+                    add(value >> 32, bits - 32);
+                    add(value, 32);
+                }
+                return;
+            }
+
+            value &= fieldMask(bits);
+            if(order_ == endian::little)
+                pending_ |= value << pendingBits_;
+            else
+                pending_ |= value << (64 - pendingBits_ - bits);
+            pendingBits_ += bits;
+            storeBytes(pendingBits_ / 8);
+        }
+
+        /**
+         * Store the last, partial byte.
+         */
+        void finish()
+        {
+            if(pendingBits_ > 0)
+                storeBytes(1);
+        }
+
+        private:
+        /**
+         * Store the n complete bytes of the accumulator (n < 8); inside out the whole word is
+         * stored whether or not n is 0, as that is cheaper than the branch.
+         */
+        void storeBytes(unsigned n)
+        {
+            bit_converter<uint64_t> window;
+            window.setWord(pending_);
+            if(order_ == endian::big)
+                window.swapBytes();
+            if(inWords_ && written_ <= wordEnd_)
+                memcpy(out_ + written_, window.byte, sizeof(uint64_t));
+            else
+                memcpy(out_ + written_, window.byte, n);
+            written_ += n;
+
+            if(order_ == endian::little)
+                pending_ >>= 8 * n;
+            else
+                pending_ <<= 8 * n;
+            pendingBits_ -= min(pendingBits_, 8 * n);
+        }
+
+        byte    *out_;
+        size_t   wordEnd_;
+        bool     inWords_;
+        endian   order_;
+        size_t   written_     = 0;
+        uint64_t pending_     = 0ULL;
+        unsigned pendingBits_ = 0;
+    };
+
+    /**
+     * Pack groups of eight fields of up to 16 bits independently of each other: each group fills
+     * exactly bits bytes, assembled in a 128-bit integer. Returns the number of fields packed.
+     */
+    template<typename T_>
+    size_t packGroups(span<const T_> in, unsigned bits, span<byte> out, endian order)
+    {
+        size_t   packedBytes = packedSize(in.size(), bits);
+        uint64_t mask        = fieldMask(bits);
+
+        size_t i = 0;
+        for(; i + 8 <= in.size(); i += 8)
+        {
+            __uint128_t group = 0;
+            for(unsigned j = 0; j < 8; j++)
+            {
+                unsigned shift = order == endian::little ? j * bits : (7 - j) * bits;
+                group |= __uint128_t(uint64_t(in[i + j]) & mask) << shift;
+            }
+
+            bit_converter<uint64_t> words[2];
+            if(order == endian::little)
+            {
+                words[0].setWord(uint64_t(group));
+                words[1].setWord(uint64_t(group >> 64));
+            }
+            else
+            {
+                // most significant byte of the group first
+                group <<= 128 - 8 * bits;
+                words[0].setWord(uint64_t(group >> 64));
+                words[1].setWord(uint64_t(group));
+                words[0].swapBytes();
+                words[1].swapBytes();
+            }
+
+            size_t at = i / 8 * bits;
+            if(at + 2 * sizeof(uint64_t) <= packedBytes)
+            {
+                memcpy(out.data() + at, words[0].byte, sizeof(uint64_t));
+                memcpy(out.data() + at + sizeof(uint64_t), words[1].byte, sizeof(uint64_t));
+            }
+            else
+            {
+                memcpy(out.data() + at, words[0].byte, min(size_t(bits), sizeof(uint64_t)));
+                if(bits > sizeof(uint64_t))
+                    memcpy(out.data() + at + sizeof(uint64_t), words[1].byte, bits - sizeof(uint64_t));
+            }
+        }
+
+        return (i);
+    }
+
+    template<typename T_>
+    void packAll(span<const T_> in, unsigned bits, span<byte> out, endian order)
+    {
+        checkArguments("packBits()", out.size(), in.size(), bits, 64);
+
+        size_t done = bits <= 16 ? packGroups(in, bits, out, order) : 0;
+        field_packer packer(out.subspan(done / 8 * bits), packedSize(in.size() - done, bits), order);
+        for(auto v: in.subspan(done))
+            packer.add(uint64_t(v), bits);
+        packer.finish();
+    }
+};
+// namespace
+
+void unpackBits(span<const byte> in, unsigned bits, span<uint8_t> out, endian order)
+{
+    unpackAll(in, bits, out, order);
+}
+
+void unpackBits(span<const byte> in, unsigned bits, span<uint16_t> out, endian order)
+{
+    unpackAll(in, bits, out, order);
+}
+
+void unpackBits(span<const byte> in, unsigned bits, span<uint32_t> out, endian order)
+{
+    unpackAll(in, bits, out, order);
+}
+
+void unpackBits(span<const byte> in, unsigned bits, span<uint64_t> out, endian order)
+{
+    unpackAll(in, bits, out, order);
+}
+
+void packBits(span<const uint8_t> in, unsigned bits, span<byte> out, endian order)
+{
+    packAll(in, bits, out, order);
+}
+
+void packBits(span<const uint16_t> in, unsigned bits, span<byte> out, endian order)
+{
+    packAll(in, bits, out, order);
+}
+
+void packBits(span<const uint32_t> in, unsigned bits, span<byte> out, endian order)
+{
+    packAll(in, bits, out, order);
+}
+
+void packBits(span<const uint64_t> in, unsigned bits, span<byte> out, endian order)
+{
+    packAll(in, bits, out, order);
+}
+};
+// namespace util
@@ -0,0 +1,44 @@
+/*
+ * File:        cpu_features.h
+ * Description: Run-time checks of instruction set extensions, for the library sources only.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef NS_UTIL_CPU_FEATURES_H_INCLUDED
+#define NS_UTIL_CPU_FEATURES_H_INCLUDED
+
+namespace util
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+/**
+ * Whether the CPU executes AVX2, asked once. Kernels using it are compiled with
+ * __attribute__((target("avx2"))) and chosen at run time, so the library runs on any x86-64.
+ */
+inline bool hasAvx2()
+{
+    static const bool reval = __builtin_cpu_supports("avx2");
+
+    return (reval);
+}
+#endif
+};
+// namespace util
+
+#endif  // NS_UTIL_CPU_FEATURES_H_INCLUDED
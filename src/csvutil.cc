@@ -23,6 +23,7 @@
  */
 
 #include <csvutil.h>
+#include <type_traits>
 #include <utility>
 
 using namespace std;
@@ -177,8 +178,70 @@ bool CSVAnalyzer::setTypes(const string &typeString, const string &inSeparator)
     return (true);
 }
 
+namespace
+{
+/*
+ * Convert a cell of a numeric column from its number as found by scanNumberString(); strings the
+ * lexer does not accept for the column type keep the stream conversion of scanAs().
+ */
+template<typename T_>
+Var numberAs(const string &stringVal, const NumberValue &number)
+{
+    NumberClass numClass = number.numberClass;
+
+    if constexpr(is_same_v<T_, VAR_INT>)
+    {
+        if(numClass == util::INT)
+            return (Var(VAR_INT(number.intValue)));
+    }
+    else if constexpr(is_same_v<T_, VAR_UINT>)
+    {
+        if(numClass == util::UINT)
+            return (Var(VAR_UINT(number.uintValue)));
+        if(numClass == util::INT)
+            return (Var(VAR_UINT(number.intValue)));
+    }
+    else
+    {
+        if(numClass == util::FLOAT)
+            return (Var(VAR_FLOAT(number.floatValue)));
+        if(numClass == util::UINT)
+            return (Var(VAR_FLOAT(number.uintValue)));
+        if(numClass == util::INT)
+            return (Var(VAR_FLOAT(number.intValue)));
+    }
+
+    return (Var(scanAs<T_>(stringVal)));
+}
+
+template<typename T_>
+Var scanNumberAs(const string &stringVal)
+{
+    NumberValue number;
+    scanNumberString(stringVal, number);
+
+    return (numberAs<T_>(stringVal, number));
+}
+
+bool isNumberType(const string &tp)
+{
+    return (tp == CSV_COLUMN_TYPE_INT || tp == CSV_COLUMN_TYPE_UINT || tp == CSV_COLUMN_TYPE_FLOAT ||
+            tp == CSV_COLUMN_TYPE_GAUSSIAN || tp == CSV_COLUMN_TYPE_EXPONENTIAL);
+}
+};
+// namespace
+
 string CSVAnalyzer::guessType(const string &stringVal)
 {
+    NumberValue number;
+
+    return (guessType(stringVal, number));
+}
+
+string CSVAnalyzer::guessType(const string &stringVal, NumberValue &number)
+{
+    NumberClass numClass = scanNumberString(stringVal, number);
+
     // treat 0 or 1 always as integers
     if(stringVal == "0" || stringVal == "1")
         return (CSV_COLUMN_TYPE_INT);
@@ -189,8 +252,6 @@ string CSVAnalyzer::guessType(const string &stringVal)
     // default to string/char
     string reval = stringVal.size() == 1 ? CSV_COLUMN_TYPE_CHAR : CSV_COLUMN_TYPE_STRING;
 
-    NumberClass numClass = classifyNumberString(stringVal);
-
     if(!stringVal.empty())
     {
         bool dummy;
@@ -221,11 +282,19 @@ bool CSVAnalyzer::createDefaultHeader(const vector<string> &values)
 }
 
 bool CSVAnalyzer::createTypesFromValues(const vector<string> &values)
+{
+    vector<NumberValue> numbers;
+
+    return (createTypesFromValues(values, numbers));
+}
+
+bool CSVAnalyzer::createTypesFromValues(const vector<string> &values, vector<NumberValue> &numbers)
 {
     string types = "";
 
+    numbers.resize(values.size());
     for(size_t i = 0; i < values.size(); i++)
-        types += guessType(values[i]) + (i == values.size() - 1 ? "" : ",");
+        types += guessType(values[i], numbers[i]) + (i == values.size() - 1 ? "" : ",");
 
     return (setTypes(types));
 }
@@ -246,9 +315,12 @@ bool CSVAnalyzer::setValues(const string &valueString, bool preserveRows, const
         createDefaultHeader(values);
     }
 
-    if(!typesPresent())
+    // the numbers of the cells, scanned once: while guessing the types or before converting
+    vector<NumberValue> numbers(values.size());
+    bool                scanned = !typesPresent();
+    if(scanned)
     {
-        createTypesFromValues(values);
+        createTypesFromValues(values, numbers);
     }
 
     if(!preserveRows)
@@ -274,16 +346,19 @@ bool CSVAnalyzer::setValues(const string &valueString, bool preserveRows, const
     for(size_t i = 0; i < values.size(); i++)
     {
         string tp = asString(data_[i][1]);
+        if(!scanned && isNumberType(tp))
+            scanNumberString(values[i], numbers[i]);
+
         if(tp == CSV_COLUMN_TYPE_BOOL)
             data_[i].push_back(scanAs<VAR_BOOL>(values[i]));
         else if(tp == CSV_COLUMN_TYPE_CHAR)
             data_[i].push_back(scanAs<VAR_CHAR>(values[i]));
         else if(tp == CSV_COLUMN_TYPE_INT)
-            data_[i].push_back(scanAs<VAR_INT>(values[i]));
+            data_[i].push_back(numberAs<VAR_INT>(values[i], numbers[i]));
         else if(tp == CSV_COLUMN_TYPE_UINT)
-            data_[i].push_back(scanAs<VAR_UINT>(values[i]));
+            data_[i].push_back(numberAs<VAR_UINT>(values[i], numbers[i]));
         else if(tp == CSV_COLUMN_TYPE_FLOAT || tp == CSV_COLUMN_TYPE_GAUSSIAN || tp == CSV_COLUMN_TYPE_EXPONENTIAL)
-            data_[i].push_back(scanAs<VAR_FLOAT>(values[i]));
+            data_[i].push_back(numberAs<VAR_FLOAT>(values[i], numbers[i]));
         else if(tp == CSV_COLUMN_TYPE_STRING)
             data_[i].push_back(scanAs<VAR_STRING>(values[i]));
         else if(tp == CSV_COLUMN_TYPE_DATE)
@@ -612,11 +687,11 @@ void CSVAnalyzer::convert(size_t i, size_t row, const string &tp)
     else if(tp == CSV_COLUMN_TYPE_CHAR)
         data_[i][row + 2] = scanAs<VAR_CHAR>(value);
     else if(tp == CSV_COLUMN_TYPE_INT)
-        data_[i][row + 2] = scanAs<VAR_INT>(value);
+        data_[i][row + 2] = scanNumberAs<VAR_INT>(value);
     else if(tp == CSV_COLUMN_TYPE_UINT)
-        data_[i][row + 2] = scanAs<VAR_UINT>(value);
+        data_[i][row + 2] = scanNumberAs<VAR_UINT>(value);
     else if(tp == CSV_COLUMN_TYPE_FLOAT || tp == CSV_COLUMN_TYPE_GAUSSIAN || tp == CSV_COLUMN_TYPE_EXPONENTIAL)
-        data_[i][row + 2] = scanAs<VAR_FLOAT>(value);
+        data_[i][row + 2] = scanNumberAs<VAR_FLOAT>(value);
     else if(tp == CSV_COLUMN_TYPE_STRING)
         data_[i][row + 2] = scanAs<VAR_STRING>(value);
     else if(tp == CSV_COLUMN_TYPE_DATE)
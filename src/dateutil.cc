@@ -35,7 +35,123 @@ namespace datescan
     using namespace std;
     using namespace boost::posix_time;
     using namespace boost::gregorian;
-    vector<locale> formats = initDateFormats();
+
+    namespace
+    {
+        /*
+         * the global formats: an immutable snapshot that is replaced atomically
+         * and a version-counter that allows parse-contexts to detect a new
+         * snapshot without touching the shared pointer
+         */
+        struct FormatRegistry
+        {
+            FormatRegistry()
+            {
+                DateFormats fmts;
+
+                initDateFormats(DateFormatPreference::European, fmts);
+                formats_.store(make_shared<const DateFormats>(std::move(fmts)));
+            }
+
+            void publish(DateFormatsPtr fmts)
+            {
+                formats_.store(std::move(fmts));
+                version_.fetch_add(1, memory_order_release);
+            }
+
+            atomic<DateFormatsPtr> formats_;
+            atomic<unsigned long>  version_{1};
+        };
+
+        FormatRegistry &registry()
+        {
+            static FormatRegistry reg;
+
+            return (reg);
+        }
+    };
+    // namespace
+
+    DateFormatsPtr currentDateFormats()
+    {
+        return (registry().formats_.load());
+    }
+
+    void setDateFormats(DateFormats fmts)
+    {
+        registry().publish(make_shared<const DateFormats>(std::move(fmts)));
+    }
+
+    DateParseContext::DateParseContext(DateFormatsPtr fmts) : followGlobal_(false), formats_(std::move(fmts))
+    {
+        imbueStreams();
+    }
+
+    void DateParseContext::refresh()
+    {
+        if(!followGlobal_)
+            return;
+
+        FormatRegistry &reg     = registry();
+        unsigned long   version = reg.version_.load(memory_order_acquire);
+
+        if(version == version_)
+            return;
+
+        formats_ = reg.formats_.load();
+        version_ = version;
+        imbueStreams();
+    }
+
+    void DateParseContext::imbueStreams()
+    {
+        streams_.clear();
+
+        if(!formats_)
+            return;
+
+        for(auto &format: *formats_)
+        {
+            streams_.push_back(make_unique<istringstream>());
+            streams_.back()->imbue(format);
+        }
+    }
+
+    /*
+     *  scans a string into a posix time representation using the
+     * formats of this context
+     */
+    ptime DateParseContext::scan(const string &s)
+    {
+        refresh();
+
+        ptime  reval;
+        string withZeros = addLeadingZeros(s);
+
+        for(auto &is: streams_)
+        {
+            is->clear();
+            is->str(withZeros);
+            *is >> reval;
+            if(!reval.is_not_a_date_time())
+            {
+                if(isTimeOnly(s))
+                {
+                    // if we have a "time-only-format" then we need to explicitly
+                    // set the day to the current day, as the stream conversion sets the
+                    // day to the 1st Jan 1400
+                    tm now      = to_tm(second_clock::local_time());
+                    tm reval_tm = to_tm(reval);
+                    reval =
+                     ptime(date(now.tm_year + 1900, now.tm_mon + 1, now.tm_mday),  // @suppress("Avoid magic numbers")
+                           time_duration(reval_tm.tm_hour, reval_tm.tm_min, reval_tm.tm_sec));
+                }
+                break;
+            }
+        }
+
+        return (reval);
+    }
 
     /*
      *  boost POSIX library cannot scan string representations with single-digit
@@ -99,33 +215,9 @@ namespace datescan
      */
     ptime scanDate(const string &s)
     {
-        ptime        reval;
-        static ptime nullTime;
-        string       withZeros = addLeadingZeros(s);
-
-        for(auto &format: formats)
-        {
-            istringstream is(withZeros);
-            is.imbue(format);
-            is >> reval;
-            if(reval != nullTime)
-            {
-                if(isTimeOnly(s))
-                {
-                    // if we have a "time-only-format" then we need to explicitly
-                    // set the day to the current day, as the stream conversion sets the
-                    // day to the 1st Jan 1400
-                    tm now      = to_tm(second_clock::local_time());
-                    tm reval_tm = to_tm(reval);
-                    reval =
-                     ptime(date(now.tm_year + 1900, now.tm_mon + 1, now.tm_mday),  // @suppress("Avoid magic numbers")
-                           time_duration(reval_tm.tm_hour, reval_tm.tm_min, reval_tm.tm_sec));
-                }
-                break;
-            }
-        }
+        thread_local DateParseContext context;
 
-        return (reval);
+        return (context.scan(s));
     }
 
     // seconds elapsed since epoch to the time described by the string
@@ -138,8 +230,8 @@ namespace datescan
     /*
      * iteration function: changes the case of all occurrences
      * of the given format flag, if flag == 'b', all occurrences
-     * of %b in the format-string fmt are changed to %B, but
-     * occurrences of %B are unchanged
+     * of %b in the format-string fmt are changed to %B and vice versa,
+     * occurrences of the other case are unchanged
      */
     string changeCaseOfFormatFlag(const string &fmt, char flag)
     {
@@ -164,18 +256,36 @@ namespace datescan
                 if(islower(reval[pos + 1]))
                     reval[pos + 1] = static_cast<char>(toupper(reval[pos + 1]));
                 else
-                    reval[pos + 1] = static_cast<char>(reval[pos + 1]);
+                    reval[pos + 1] = static_cast<char>(tolower(reval[pos + 1]));
             }
         } while(pos != string::npos);
 
         return (reval);
     }
 
-    void addDateFormat(const string &fmt, vector<locale> &formatVec)
+    void addDateFormat(const string &fmt, DateFormats &formatVec)
     {
         formatVec.push_back(locale(locale::classic(), new time_input_facet(fmt)));
     }
 
+    void addDateFormat(const string &fmt)
+    {
+        FormatRegistry &reg      = registry();
+        DateFormatsPtr  expected = reg.formats_.load();
+        DateFormatsPtr  desired;
+
+        // copy-update until no other writer published in between
+        do
+        {
+            auto updated = make_shared<DateFormats>(*expected);
+
+            addDateFormat(fmt, *updated);
+            desired = std::move(updated);
+        } while(!reg.formats_.compare_exchange_weak(expected, desired));
+
+        reg.version_.fetch_add(1, memory_order_release);
+    }
+
     /*
      * create all the facets for the different date-formats we might come
      * across this is a subset of the actually possible formats starting
@@ -187,7 +297,7 @@ namespace datescan
      * to the 5th February in US and the 2nd May in Europe the parameter
      * pref defaults to European
      */
-    vector<locale> initDateFormats(DateFormatPreference pref, vector<locale> &fmts)
+    DateFormats initDateFormats(DateFormatPreference pref, DateFormats &fmts)
     {
         resetDateFormats(fmts);
 
@@ -282,11 +392,26 @@ namespace datescan
         return (fmts);
     }
 
-    void resetDateFormats(vector<locale> &fmts)
+    DateFormats initDateFormats(DateFormatPreference pref)
+    {
+        DateFormats fmts;
+
+        initDateFormats(pref, fmts);
+        setDateFormats(fmts);
+
+        return (fmts);
+    }
+
+    void resetDateFormats(DateFormats &fmts)
     {
         fmts.resize(0);
     }
 
+    void resetDateFormats()
+    {
+        setDateFormats(DateFormats());
+    }
+
     void imbueDateFormat(ostream &os, const string &fmt)
     {
         auto *facet = new time_facet(fmt.c_str());
@@ -325,5 +450,102 @@ namespace datescan
 
 };
 // namespace datescan
+
+namespace datecalc
+{
+    using namespace std;
+
+    namespace
+    {
+        void checkColumnSizes(size_t inSize, size_t outSize)
+        {
+            if(outSize < inSize)
+            {
+                stringstream ss;
+
+                ss << "date column of size " << inSize << " does not fit into output of size " << outSize;
+                throw out_of_range(ss.str());
+            }
+        }
+
+        // the unit is a template parameter, so that the loop-body is free of the unit-dispatch
+        template<DateUnit unit_>
+        void truncateColumn(span<const epoch_date> in, span<epoch_date> out)
+        {
+            const size_t n = in.size();
+
+            for(size_t i = 0; i < n; i++)
+                out[i] = truncate(in[i], unit_);
+        }
+
+        // seconds since the epoch truncated toward zero, as pt_to_time_t()
+        time_t truncatedSeconds(epoch_date d)
+        {
+            return (static_cast<time_t>(d.ticks() / epoch_date::ticks_per_second));
+        }
+    };
+    // namespace
+
+    void truncate(span<const epoch_date> in, span<epoch_date> out, DateUnit unit)
+    {
+        checkColumnSizes(in.size(), out.size());
+
+        switch(unit)
+        {
+            case DateUnit::Day:
+                truncateColumn<DateUnit::Day>(in, out);
+                break;
+            case DateUnit::Week:
+                truncateColumn<DateUnit::Week>(in, out);
+                break;
+            case DateUnit::Month:
+                truncateColumn<DateUnit::Month>(in, out);
+                break;
+            case DateUnit::Year:
+                truncateColumn<DateUnit::Year>(in, out);
+                break;
+        }
+    }
+
+    void dayOfWeek(span<const epoch_date> in, span<unsigned char> out)
+    {
+        checkColumnSizes(in.size(), out.size());
+
+        const size_t n = in.size();
+
+        for(size_t i = 0; i < n; i++)
+            out[i] = static_cast<unsigned char>(dayOfWeek(in[i]));
+    }
+
+    void difference(span<const epoch_date> lhs, span<const epoch_date> rhs, span<epoch_date::rep_type> out)
+    {
+        checkColumnSizes(lhs.size(), rhs.size());
+        checkColumnSizes(lhs.size(), out.size());
+
+        const size_t n = lhs.size();
+
+        for(size_t i = 0; i < n; i++)
+            out[i] = epoch_date::tickDifference(lhs[i].ticks(), rhs[i].ticks());
+    }
+
+    void toTimeT(span<const epoch_date> in, span<time_t> out)
+    {
+        checkColumnSizes(in.size(), out.size());
+
+        const size_t n = in.size();
+
+        for(size_t i = 0; i < n; i++)
+            out[i] = truncatedSeconds(in[i]);
+    }
+
+    void secondsFromEpoch(const vector<string> &in, span<time_t> out)
+    {
+        checkColumnSizes(in.size(), out.size());
+
+        for(size_t i = 0; i < in.size(); i++)
+            out[i] = truncatedSeconds(epoch_date(datescan::scanDate(in[i])));
+    }
+};
+// namespace datecalc
 };
 // namespace util
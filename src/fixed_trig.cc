@@ -0,0 +1,275 @@
+/*
+ * File:        fixed_trig.cc
+ * Description: Fixed-point sine, cosine and atan2 for integer angle types.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <fixed_trig.h>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+
+namespace util
+{
+using namespace std;
+
+namespace
+{
+    /**
+     * Angles are reduced to binary angles: a full turn is 2^32 units, so that wrapping is free.
+     */
+    constexpr unsigned sinTableBits  = 12;
+    constexpr size_t   sinTableSize  = size_t(1) << sinTableBits;
+    constexpr unsigned atanTableBits = 10;
+    constexpr size_t   atanTableSize = size_t(1) << atanTableBits;
+
+    /**
+     * 2^64 / (2 pi 10^6): micro-radians to binary angles, shifted right by 32 after multiplying.
+     */
+    constexpr uint64_t microRadToBinary =
+     uint64_t(18446744073709551616.0L / (2.0L * numbers::pi_v<long double> * 1e6L) + 0.5L);
+
+    /**
+     * 2 pi 10^6 * 2^32: binary angles to micro-radians in the upper half of the 128-bit product.
+     */
+    constexpr uint64_t binaryToMicroRad = uint64_t(2.0L * numbers::pi_v<long double> * 1e6L * 4294967296.0L + 0.5L);
+
+    /**
+     * pi / 2 * 2^32: binary angle units to Q30 radians in the upper half of the product.
+     */
+    constexpr int64_t binaryToQ30Rad = int64_t(numbers::pi_v<long double> / 2.0L * 4294967296.0L + 0.5L);
+
+    struct trig_tables
+    {
+        trig_tables()
+        {
+            const long double pi = numbers::pi_v<long double>;
+            for(size_t i = 0; i < sizeof(sinTurn) / sizeof(sinTurn[0]); i++)
+                sinTurn[i] = q30_t(lrintl(sinl(2.0L * pi * i / sinTableSize) * Q30_ONE));
+            for(size_t i = 0; i < sizeof(sinDegree) / sizeof(sinDegree[0]); i++)
+                sinDegree[i] = q30_t(lrintl(sinl(pi * i / 180.0L) * Q30_ONE));
+            for(size_t i = 0; i < sizeof(atanTurn) / sizeof(atanTurn[0]); i++)
+                atanTurn[i] = uint32_t(llrintl(atanl((long double)i / atanTableSize) / (2.0L * pi) * 4294967296.0L));
+        }
+
+        /**
+         * sin(2 pi i / sinTableSize) over one and a quarter turns: cos is a quarter turn on.
+         */
+        q30_t    sinTurn[sinTableSize + sinTableSize / 4];
+        q30_t    sinDegree[360 + 90];
+        uint32_t atanTurn[atanTableSize + 2];  ///< atan(i / atanTableSize) as binary angle
+    };
+
+    const trig_tables &tables()
+    {
+        static const trig_tables reval;
+
+        return (reval);
+    }
+
+    inline size_t degreeIndex(int64_t degrees)
+    {
+        return (size_t(degrees + 360) % 360);
+    }
+
+    inline q30_t sinDegrees(const trig_tables &t, int64_t degrees)
+    {
+        return (t.sinDegree[degreeIndex(degrees)]);
+    }
+
+    inline q30_t cosDegrees(const trig_tables &t, int64_t degrees)
+    {
+        return (t.sinDegree[degreeIndex(degrees) + 90]);
+    }
+
+    inline uint32_t binaryAngle(Rad2Pi angle)
+    {
+        return (uint32_t((__uint128_t(uint64_t(angle.val())) * microRadToBinary) >> 32));
+    }
+
+    /**
+     * sin(a + b) = sin(a) + cos(a) b - sin(a) b^2 / 2 for the table angle a nearest to the binary
+     * angle and the remainder |b| <= pi / sinTableSize; the omitted terms are below 2^-33.
+     */
+    inline q30_t sinBinary(const trig_tables &t, uint32_t angle)
+    {
+        constexpr unsigned fractionBits = 32 - sinTableBits;
+
+        uint32_t index     = (angle + (uint32_t(1) << (fractionBits - 1))) >> fractionBits;
+        int64_t  remainder = int32_t(angle - (index << fractionBits));
+        int64_t  b         = (remainder * binaryToQ30Rad) >> 32;
+        int64_t  halfB2    = (b * b) >> (Q30_BITS + 1);
+        int64_t  sinA      = t.sinTurn[index % sinTableSize];
+        int64_t  cosA      = t.sinTurn[index % sinTableSize + sinTableSize / 4];
+
+        return (q30_t(sinA + ((cosA * b) >> Q30_BITS) - ((sinA * halfB2) >> Q30_BITS)));
+    }
+
+    inline q30_t sinOf(const trig_tables &t, Deg180 angle)
+    {
+        return (sinDegrees(t, angle.val()));
+    }
+
+    inline q30_t sinOf(const trig_tables &t, Deg360 angle)
+    {
+        return (sinDegrees(t, angle.val()));
+    }
+
+    inline q30_t sinOf(const trig_tables &t, Rad2Pi angle)
+    {
+        return (sinBinary(t, binaryAngle(angle)));
+    }
+
+    inline q30_t cosOf(const trig_tables &t, Deg180 angle)
+    {
+        return (cosDegrees(t, angle.val()));
+    }
+
+    inline q30_t cosOf(const trig_tables &t, Deg360 angle)
+    {
+        return (cosDegrees(t, angle.val()));
+    }
+
+    inline q30_t cosOf(const trig_tables &t, Rad2Pi angle)
+    {
+        return (sinBinary(t, binaryAngle(angle) + (uint32_t(1) << 30)));
+    }
+
+    /**
+     * atan2 as binary angle: atan(min / max) of the absolute values from the interpolated
+     * table, mapped to the octant of (x, y).
+     */
+    inline uint32_t atan2Binary(const trig_tables &t, int32_t y, int32_t x)
+    {
+        constexpr unsigned fractionBits = 32 - atanTableBits;
+
+        uint64_t ax = x < 0 ? uint64_t(-int64_t(x)) : uint64_t(x);
+        uint64_t ay = y < 0 ? uint64_t(-int64_t(y)) : uint64_t(y);
+        uint64_t lo = min(ax, ay);
+        uint64_t hi = max(ax, ay);
+        if(hi == 0)
+            return (0U);
+
+        uint64_t ratio    = (lo << 32) / hi;  // Q32 in [0, 1]
+        size_t   index    = ratio >> fractionBits;
+        int64_t  fraction = ratio & ((uint64_t(1) << fractionBits) - 1);
+        int64_t  step     = int64_t(t.atanTurn[index + 1]) - int64_t(t.atanTurn[index]);
+        uint32_t reval    = t.atanTurn[index] + uint32_t((step * fraction) >> fractionBits);
+
+        if(ay > ax)
+            reval = (uint32_t(1) << 30) - reval;
+        if(x < 0)
+            reval = (uint32_t(1) << 31) - reval;
+        if(y < 0)
+            reval = uint32_t(0) - reval;
+
+        return (reval);
+    }
+
+    /**
+     * Round a binary angle to the nearest unit of the angle type; the constructor wraps a full
+     * turn to 0.
+     */
+    template<typename Angle_>
+    Angle_ fromBinary(uint32_t angle)
+    {
+        if constexpr(is_same_v<Angle_, Rad2Pi>)
+            return (Angle_(int64_t((__uint128_t(angle) * binaryToMicroRad + (__uint128_t(1) << 63)) >> 64)));
+        else
+            return (Angle_(int64_t((uint64_t(angle) * 360 + (uint64_t(1) << 31)) >> 32)));
+    }
+
+    void checkSizes(const char *function, size_t inSize, size_t outSize)
+    {
+        if(inSize != outSize)
+            throw invalid_argument(string(function) + ": " + to_string(inSize) + " inputs but " + to_string(outSize) +
+                                   " outputs");
+    }
+};
+// namespace
+
+template<typename Angle_>
+q30_t fixedSin(Angle_ angle)
+{
+    return (sinOf(tables(), angle));
+}
+
+template<typename Angle_>
+q30_t fixedCos(Angle_ angle)
+{
+    return (cosOf(tables(), angle));
+}
+
+template<typename Angle_>
+void fixedSin(span<const Angle_> angles, span<q30_t> out)
+{
+    checkSizes("fixedSin()", angles.size(), out.size());
+    const trig_tables &t = tables();
+    for(size_t i = 0; i < angles.size(); i++)
+        out[i] = sinOf(t, angles[i]);
+}
+
+template<typename Angle_>
+void fixedCos(span<const Angle_> angles, span<q30_t> out)
+{
+    checkSizes("fixedCos()", angles.size(), out.size());
+    const trig_tables &t = tables();
+    for(size_t i = 0; i < angles.size(); i++)
+        out[i] = cosOf(t, angles[i]);
+}
+
+template<typename Angle_>
+Angle_ fixedAtan2(int32_t y, int32_t x)
+{
+    return (fromBinary<Angle_>(atan2Binary(tables(), y, x)));
+}
+
+template<typename Angle_>
+void fixedAtan2(span<const int32_t> y, span<const int32_t> x, span<Angle_> out)
+{
+    checkSizes("fixedAtan2()", y.size(), x.size());
+    checkSizes("fixedAtan2()", y.size(), out.size());
+    const trig_tables &t = tables();
+    for(size_t i = 0; i < y.size(); i++)
+        out[i] = fromBinary<Angle_>(atan2Binary(t, y[i], x[i]));
+}
+
+template q30_t fixedSin<Deg180>(Deg180);
+template q30_t fixedSin<Deg360>(Deg360);
+template q30_t fixedSin<Rad2Pi>(Rad2Pi);
+template q30_t fixedCos<Deg180>(Deg180);
+template q30_t fixedCos<Deg360>(Deg360);
+template q30_t fixedCos<Rad2Pi>(Rad2Pi);
+template void  fixedSin<Deg180>(span<const Deg180>, span<q30_t>);
+template void  fixedSin<Deg360>(span<const Deg360>, span<q30_t>);
+template void  fixedSin<Rad2Pi>(span<const Rad2Pi>, span<q30_t>);
+template void  fixedCos<Deg180>(span<const Deg180>, span<q30_t>);
+template void  fixedCos<Deg360>(span<const Deg360>, span<q30_t>);
+template void  fixedCos<Rad2Pi>(span<const Rad2Pi>, span<q30_t>);
+template Deg180 fixedAtan2<Deg180>(int32_t, int32_t);
+template Deg360 fixedAtan2<Deg360>(int32_t, int32_t);
+template Rad2Pi fixedAtan2<Rad2Pi>(int32_t, int32_t);
+template void   fixedAtan2<Deg180>(span<const int32_t>, span<const int32_t>, span<Deg180>);
+template void   fixedAtan2<Deg360>(span<const int32_t>, span<const int32_t>, span<Deg360>);
+template void   fixedAtan2<Rad2Pi>(span<const int32_t>, span<const int32_t>, span<Rad2Pi>);
+};
+// namespace util
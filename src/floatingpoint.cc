@@ -22,7 +22,14 @@
  * @author: Dieter J Kybelksties
  */
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <floatingpoint.h>
 #include <gmp.h>
 #include <gmpxx.h>
@@ -31,8 +38,12 @@
 #include <map>
 #include <mpfr.h>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <stringutil.h>
+#include <thread_pool.h>
+#include <vector>
 
 namespace util
 {
@@ -485,5 +496,695 @@ void decimal_to_quadruple(quadruple *px, decimal_mode *pm, decimal_record *pd, f
     }
 }
 
+
+//
+// Shortest round-trip conversion.
+//
+// The digits are generated with Grisu3 (F. Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers", PLDI 2010) on 128-bit "do-it-yourself" floating points, so the whole
+// common case runs in fixed-width integer arithmetic. Grisu3 detects the rare inputs for which it
+// cannot prove that its result is the shortest correctly rounded one; only those fall back to the
+// exact (multi-precision) conversion of the C library. GMP is needed once to compute the cached
+// powers of ten.
+//
+namespace
+{
+using uint128 = unsigned __int128;
+
+constexpr int significandBits   = 128;
+constexpr int minTargetExponent = -124;  // scaled values keep 4 bits head-room for the *10 below
+constexpr int maxTargetExponent = -96;   // ... and at most 32 integral bits
+constexpr int cachedPowerStep   = 8;
+constexpr int cachedPowerMin    = -5000;
+constexpr int cachedPowerMax    = 5000;
+constexpr int maxDigits         = 64;
+
+struct diy_fp
+{
+    uint128 f;
+    int     e;
+};
+
+struct cached_power
+{
+    diy_fp p;  ///< normalised, correctly rounded 10^k
+    int    k;
+};
+
+int leadingZeros(uint128 v)
+{
+    uint64_t hi = uint64_t(v >> 64);
+
+    return (hi != 0 ? __builtin_clzll(hi) : 64 + __builtin_clzll(uint64_t(v)));
+}
+
+diy_fp normalize(const diy_fp &v)
+{
+    int shift = leadingZeros(v.f);
+
+    return (diy_fp{v.f << shift, v.e - shift});
+}
+
+// upper half of the 256-bit product, rounded to nearest
+diy_fp times(const diy_fp &a, const diy_fp &b)
+{
+    const uint128 mask = 0xFFFFFFFFFFFFFFFFULL;
+    uint128       a1   = a.f >> 64;
+    uint128       a0   = a.f & mask;
+    uint128       b1   = b.f >> 64;
+    uint128       b0   = b.f & mask;
+    uint128       hh   = a1 * b1;
+    uint128       hl   = a1 * b0;
+    uint128       lh   = a0 * b1;
+    uint128       ll   = a0 * b0;
+    uint128       mid  = (ll >> 64) + (hl & mask) + (lh & mask) + (uint128(1) << 63);
+
+    return (diy_fp{hh + (hl >> 64) + (lh >> 64) + (mid >> 64), a.e + b.e + significandBits});
+}
+
+uint128 toUint128(const mpz_class &z)
+{
+    uint64_t words[2] = {0, 0};
+    size_t   count    = 0;
+    mpz_export(words, &count, -1, sizeof(uint64_t), 0, 0, z.get_mpz_t());
+
+    return ((uint128(words[1]) << 64) | words[0]);
+}
+
+const vector<cached_power> &cachedPowers()
+{
+    static const vector<cached_power> powers = []() {
+        vector<cached_power> reval;
+        for(int k = cachedPowerMin; k <= cachedPowerMax; k += cachedPowerStep)
+        {
+            mpz_class p10;
+            mpz_ui_pow_ui(p10.get_mpz_t(), 10, abs(k));
+            int       bits = int(mpz_sizeinbase(p10.get_mpz_t(), 2));
+            mpz_class f;
+            int       e;
+
+            if(k >= 0 && bits <= significandBits)
+            {
+                f = p10 << (significandBits - bits);
+                e = bits - significandBits;
+            }
+            else if(k >= 0)
+            {
+                int shift = bits - significandBits;
+                f         = (p10 + (mpz_class(1) << (shift - 1))) >> shift;
+                e         = shift;
+            }
+            else
+            {
+                int shift = bits + significandBits - 1;
+                f         = ((mpz_class(1) << shift) + p10 / 2) / p10;
+                e         = -shift;
+            }
+            if(int(mpz_sizeinbase(f.get_mpz_t(), 2)) > significandBits)
+            {
+                f >>= 1;
+                e += 1;
+            }
+            reval.push_back(cached_power{diy_fp{toUint128(f), e}, k});
+        }
+        return (reval);
+    }();
+
+    return (powers);
+}
+
+// cached power c such that the binary exponent of w*c is in [minTargetExponent, maxTargetExponent]
+const cached_power *cachedPowerFor(int wExponent)
+{
+    const auto &powers = cachedPowers();
+    int         lo     = minTargetExponent - (wExponent + significandBits);
+    int         hi     = maxTargetExponent - (wExponent + significandBits);
+    long        guess  = lround(((lo + hi) / 2.0 + significandBits - 1) * 0.30102999566398120 - cachedPowerMin)
+                  / cachedPowerStep;
+    long        idx    = max(0L, min(long(powers.size()) - 1, guess));
+
+    while(idx > 0 && powers[idx].p.e > hi)
+        --idx;
+    while(idx + 1 < long(powers.size()) && powers[idx].p.e < lo)
+        ++idx;
+
+    return (powers[idx].p.e < lo || powers[idx].p.e > hi ? nullptr : &powers[idx]);
+}
+
+bool roundWeed(char   *buffer,
+               int     length,
+               uint128 distanceTooHighW,
+               uint128 unsafeInterval,
+               uint128 rest,
+               uint128 tenKappa,
+               uint128 unit)
+{
+    uint128 smallDistance = distanceTooHighW - unit;
+    uint128 bigDistance   = distanceTooHighW + unit;
+
+    while(rest < smallDistance && unsafeInterval - rest >= tenKappa
+          && (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+    {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+    if(rest < bigDistance && unsafeInterval - rest >= tenKappa
+       && (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+        return (false);
+
+    return ((2 * unit <= rest) && (rest <= unsafeInterval - 4 * unit));
+}
+
+bool digitGen(const diy_fp &low, const diy_fp &w, const diy_fp &high, char *buffer, int &length, int &kappa)
+{
+    if(low.f == 0 || ~high.f == 0)
+        return (false);
+
+    uint128  unit           = 1;
+    uint128  tooLow         = low.f - unit;
+    uint128  tooHigh        = high.f + unit;
+    uint128  unsafeInterval = tooHigh - tooLow;
+    int      shift          = -w.e;
+    uint128  oneF           = uint128(1) << shift;
+    uint32_t integrals      = uint32_t(tooHigh >> shift);
+    uint128  fractionals    = tooHigh & (oneF - 1);
+    uint32_t divisor        = 0;
+
+    kappa  = 0;
+    length = 0;
+    for(uint32_t p = 1; p <= integrals; p *= 10)
+    {
+        divisor = p;
+        ++kappa;
+        if(p > 0xFFFFFFFFU / 10)
+            break;
+    }
+
+    while(kappa > 0)
+    {
+        buffer[length++] = char('0' + integrals / divisor);
+        integrals %= divisor;
+        --kappa;
+        uint128 rest = (uint128(integrals) << shift) + fractionals;
+        if(rest < unsafeInterval)
+            return (roundWeed(buffer, length, tooHigh - w.f, unsafeInterval, rest, uint128(divisor) << shift, unit));
+        divisor /= 10;
+    }
+
+    while(length < maxDigits)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval *= 10;
+        buffer[length++] = char('0' + int(fractionals >> shift));
+        fractionals &= oneF - 1;
+        --kappa;
+        if(fractionals < unsafeInterval)
+            return (roundWeed(buffer, length, (tooHigh - w.f) * unit, unsafeInterval, fractionals, oneF, unit));
+    }
+
+    return (false);
+}
+
+// v must be finite and positive
+bool grisu3(quadruple v, char *buffer, int &length, int &decimalExponent)
+{
+    constexpr int denormalExponent = LDBL_MIN_EXP - LDBL_MANT_DIG;
+
+    int       exp2 = 0;
+    quadruple frac = frexpl(v, &exp2);
+    uint128   f    = uint128(ldexpl(frac, LDBL_MANT_DIG));
+    int       e    = exp2 - LDBL_MANT_DIG;
+
+    if(e < denormalExponent)
+    {
+        f >>= (denormalExponent - e);
+        e = denormalExponent;
+    }
+
+    bool   lowerIsCloser = (f == (uint128(1) << (LDBL_MANT_DIG - 1))) && e > denormalExponent;
+    diy_fp w             = normalize(diy_fp{f, e});
+    diy_fp plus          = normalize(diy_fp{(f << 1) + 1, e - 1});
+    diy_fp minus         = lowerIsCloser ? diy_fp{(f << 2) - 1, e - 2} : diy_fp{(f << 1) - 1, e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    const cached_power *c = cachedPowerFor(w.e);
+    if(c == nullptr)
+        return (false);
+
+    int  kappa  = 0;
+    bool reval  = digitGen(times(minus, c->p), times(w, c->p), times(plus, c->p), buffer, length, kappa);
+    decimalExponent = kappa - c->k;
+
+    return (reval);
+}
+
+// exact, but slow: the C library converts with its own multi-precision arithmetic
+void exactShortest(quadruple v, char *buffer, int &length, int &decimalExponent)
+{
+    char text[maxDigits];
+
+    for(int precision = 1; precision <= LDBL_DECIMAL_DIG; ++precision)
+    {
+        snprintf(text, sizeof(text), "%.*Le", precision - 1, v);
+        if(strtold(text, nullptr) == v)
+            break;
+    }
+
+    const char *p = text;
+    length        = 0;
+    for(; *p != 'e' && *p != 'E'; ++p)
+    {
+        if(isdigit(*p))
+            buffer[length++] = *p;
+    }
+    decimalExponent = atoi(p + 1) - (length - 1);
+    while(length > 1 && buffer[length - 1] == '0')
+    {
+        --length;
+        ++decimalExponent;
+    }
+}
+
+// Clinger's fast path: if both the integer significand and the power of ten are exact quadruples, a
+// single (correctly rounded) multiplication or division gives the correctly rounded result
+constexpr int maxExactDigits     = LDBL_MANT_DIG >= 64 ? 19 : 15;
+constexpr int maxExactPowerOfTen = int(LDBL_MANT_DIG * 0.43067655807339306);  // 5^n < 2^LDBL_MANT_DIG
+
+constexpr array<quadruple, maxExactPowerOfTen + 1> exactPowersOfTen = []() {
+    array<quadruple, maxExactPowerOfTen + 1> reval{};
+    reval[0] = 1.0L;
+    for(size_t i = 1; i < reval.size(); ++i)
+        reval[i] = reval[i - 1] * 10.0L;
+    return (reval);
+}();
+
+quadruple nearestQuadruple(string_view ds, int exponent, bool more)
+{
+    while(!ds.empty() && ds.front() == '0')
+        ds.remove_prefix(1);
+
+    if(ds.empty())
+        return (0.0L);
+
+    if(!more && ds.size() <= size_t(maxExactDigits) && abs(exponent) <= maxExactPowerOfTen)
+    {
+        uint64_t m = 0;
+        for(auto c: ds)
+            m = m * 10 + uint64_t(c - '0');
+        quadruple x = quadruple(m);
+
+        return (exponent < 0 ? x / exactPowersOfTen[-exponent] : x * exactPowersOfTen[exponent]);
+    }
+
+    string text(ds);
+    if(more)
+    {
+        // m + delta: a trailing 1 far below the last representable digit only ever breaks ties
+        constexpr int delta = LDBL_DECIMAL_DIG + 2;
+        text += string(delta, '0') + '1';
+        exponent -= delta + 1;
+    }
+    text += 'e' + to_string(exponent);
+
+    return (strtold(text.c_str(), nullptr));
+}
+
+// v must be finite and positive
+void shortestDigits(quadruple v, char *buffer, int &length, int &decimalExponent)
+{
+    if(!grisu3(v, buffer, length, decimalExponent))
+        exactShortest(v, buffer, length, decimalExponent);
+}
+
+// sign, up to 21 integral zeros or 5 leading fractional zeros, the digits, point and exponent
+constexpr size_t maxFormattedLength = maxDigits + 32;
+
+// shortest round-trip text of x, "%g"-like: plain notation for 1e-6 <= |x| < 1e21, otherwise scientific
+size_t formatShortest(quadruple x, char *out)
+{
+    char *p = out;
+
+    if(isnan(x))
+    {
+        memcpy(p, "nan", 3);
+        return (3);
+    }
+    if(signbit(x))
+        *p++ = '-';
+    if(isinf(x))
+    {
+        memcpy(p, "inf", 3);
+        return (p + 3 - out);
+    }
+    if(x == 0.0L)
+    {
+        *p++ = '0';
+        return (p - out);
+    }
+
+    char digits[maxDigits];
+    int  n = 0;
+    int  e = 0;
+    shortestDigits(fabsl(x), digits, n, e);
+    int k = n + e;  // position of the decimal point relative to the first digit
+
+    if(e >= 0 && k <= 21)
+    {
+        memcpy(p, digits, n);
+        memset(p + n, '0', e);
+        p += k;
+    }
+    else if(k > 0 && k <= 21)
+    {
+        memcpy(p, digits, k);
+        p[k] = '.';
+        memcpy(p + k + 1, digits + k, n - k);
+        p += n + 1;
+    }
+    else if(k > -6 && k <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -k);
+        memcpy(p - k, digits, n);
+        p += n - k;
+    }
+    else
+    {
+        *p++ = digits[0];
+        if(n > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, n - 1);
+            p += n - 1;
+        }
+        *p++    = 'e';
+        int exp = k - 1;
+        if(exp < 0)
+        {
+            *p++ = '-';
+            exp  = -exp;
+        }
+        char reversed[8];
+        int  r = 0;
+        do
+        {
+            reversed[r++] = char('0' + exp % 10);
+            exp /= 10;
+        } while(exp != 0);
+        while(r > 0)
+            *p++ = reversed[--r];
+    }
+
+    return (p - out);
+}
+
+// beyond this any decimal exponent gives 0 or infinity; keeps the arithmetic below from overflowing
+constexpr long maxDecimalExponent = 100000000L;
+
+// validate text and split it into sign, significant digits (no leading or trailing zeros) and exponent
+fp_class_type parseDecimal(string_view text, string &digits, int &exponent, bool &negative)
+{
+    auto invalid = [&text]() {
+        return (invalid_argument("'" + string(text) + "' is not a decimal number"));
+    };
+
+    size_t i = 0;
+    negative = false;
+    if(i < text.size() && (text[i] == '+' || text[i] == '-'))
+        negative = text[i++] == '-';
+
+    string_view word = text.substr(i);
+    auto        is   = [&word](string_view lower) {
+        return (word.size() == lower.size()
+                && equal(word.begin(), word.end(), lower.begin(), [](char c, char l) { return (tolower(c) == l); }));
+    };
+    if(is("inf") || is("infinity"))
+        return (fp_infinity);
+    if(is("nan"))
+        return (fp_quiet);
+
+    digits.clear();
+    long exp10    = 0;
+    bool sawDigit = false;
+    for(; i < text.size() && isdigit(text[i]); ++i)
+    {
+        sawDigit = true;
+        if(!digits.empty() || text[i] != '0')
+            digits += text[i];
+    }
+    if(i < text.size() && text[i] == '.')
+    {
+        for(++i; i < text.size() && isdigit(text[i]); ++i)
+        {
+            sawDigit = true;
+            --exp10;
+            if(!digits.empty() || text[i] != '0')
+                digits += text[i];
+        }
+    }
+    if(!sawDigit)
+        throw invalid();
+
+    if(i < text.size() && (text[i] == 'e' || text[i] == 'E'))
+    {
+        bool negativeExponent = false;
+        if(++i < text.size() && (text[i] == '+' || text[i] == '-'))
+            negativeExponent = text[i++] == '-';
+        if(i == text.size() || !isdigit(text[i]))
+            throw invalid();
+
+        long e = 0;
+        for(; i < text.size() && isdigit(text[i]); ++i)
+            e = min(maxDecimalExponent, e * 10 + (text[i] - '0'));
+        exp10 += negativeExponent ? -e : e;
+    }
+    if(i != text.size())
+        throw invalid();
+
+    while(!digits.empty() && digits.back() == '0')
+    {
+        digits.pop_back();
+        ++exp10;
+    }
+    exponent = int(clamp(exp10, -2 * maxDecimalExponent, 2 * maxDecimalExponent));
+
+    return (digits.empty() ? fp_zero : fp_normal);
+}
+
+quadruple textToQuadruple(string_view text, string &digits)
+{
+    int       exponent = 0;
+    bool      negative = false;
+    quadruple reval    = 0.0L;
+
+    switch(parseDecimal(text, digits, exponent, negative))
+    {
+        case fp_quiet:
+            return (numeric_limits<quadruple>::quiet_NaN());
+        case fp_infinity:
+            reval = numeric_limits<quadruple>::infinity();
+            break;
+        case fp_normal:
+            reval = nearestQuadruple(digits, exponent, false);
+            break;
+        default:
+            break;
+    }
+
+    return (negative ? -reval : reval);
+}
+
+// columns shorter than this are not worth handing to the thread pool
+constexpr size_t parallelGrain = 1UL << 15;
+
+// the arena grows geometrically with the text actually written, not by the worst case per value
+void formatRange(span<const quadruple> values, string &arena, vector<size_t> &ends)
+{
+    char buffer[maxFormattedLength];
+    for(auto x: values)
+    {
+        arena.append(buffer, formatShortest(x, buffer));
+        ends.push_back(arena.size());
+    }
+}
+
+template<typename Column_>
+void parseColumn(const Column_ &in, span<quadruple> out)
+{
+    if(out.size() != in.size())
+        throw out_of_range("decimals_to_quadruples: " + to_string(in.size()) + " decimals but "
+                           + to_string(out.size()) + " quadruples");
+
+    thread_pool::shared().parallelFor(in.size(),
+                                      parallelGrain,
+                                      [&in, &out](size_t begin, size_t end)
+                                      {
+                                          string digits;
+                                          for(size_t i = begin; i < end; i++)
+                                              out[i] = textToQuadruple(in[i], digits);
+                                      });
+}
+};
+// namespace
+
+void quadruple_to_shortest_decimal(const quadruple *px, decimal_record *pd)
+{
+    if(px == nullptr || pd == nullptr)
+        return;
+
+    quadruple x = *px;
+    pd->sign    = signbit(x) ? 1 : 0;
+    pd->more    = 0;
+
+    switch(fpclassify(x))
+    {
+        case FP_NAN:
+            pd->fpclass = fp_quiet;
+            break;
+        case FP_INFINITE:
+            pd->fpclass = fp_infinity;
+            break;
+        case FP_ZERO:
+            pd->fpclass = fp_zero;
+            break;
+        case FP_SUBNORMAL:
+            pd->fpclass = fp_subnormal;
+            break;
+        default:
+            pd->fpclass = fp_normal;
+            break;
+    }
+
+    if(pd->fpclass != fp_normal && pd->fpclass != fp_subnormal)
+    {
+        strcpy(pd->ds, pd->fpclass == fp_zero ? "0" : "");
+        pd->exponent = 0;
+        pd->ndigits  = int(strlen(pd->ds));
+        return;
+    }
+
+    int length   = 0;
+    int exponent = 0;
+    shortestDigits(fabsl(x), pd->ds, length, exponent);
+    pd->ds[length] = 0;
+    pd->ndigits    = length;
+    pd->exponent   = exponent;
+}
+
+void decimal_to_nearest_quadruple(quadruple *px, const decimal_record *pd)
+{
+    if(px == nullptr || pd == nullptr)
+        return;
+
+    quadruple reval = 0.0L;
+    switch(pd->fpclass)
+    {
+        case fp_zero:
+            break;
+        case fp_infinity:
+            reval = numeric_limits<quadruple>::infinity();
+            break;
+        case fp_quiet:
+            *px = numeric_limits<quadruple>::quiet_NaN();
+            return;
+        case fp_signaling:
+            *px = numeric_limits<quadruple>::signaling_NaN();
+            return;
+        default:
+            reval = nearestQuadruple(pd->ds, pd->exponent, pd->more != 0);
+            break;
+    }
+    *px = pd->sign != 0 ? -reval : reval;
+}
+
+size_t decimal_column::size() const
+{
+    return (ends_.size());
+}
+
+bool decimal_column::empty() const
+{
+    return (ends_.empty());
+}
+
+string_view decimal_column::operator[](size_t i) const
+{
+    size_t begin = i == 0 ? 0 : ends_[i - 1];
+
+    return (string_view(arena_.data() + begin, ends_[i] - begin));
+}
+
+const string &decimal_column::arena() const
+{
+    return (arena_);
+}
+
+void decimal_column::clear()
+{
+    arena_.clear();
+    ends_.clear();
+}
+
+void decimal_column::append(string_view text)
+{
+    arena_.append(text);
+    ends_.push_back(arena_.size());
+}
+
+void quadruples_to_decimals(span<const quadruple> values, decimal_column &out)
+{
+    out.clear();
+    out.ends_.reserve(values.size());
+
+    auto  &pool   = thread_pool::shared();
+    size_t chunks = min(pool.size() + 1, (values.size() + parallelGrain - 1) / parallelGrain);
+    if(chunks <= 1)
+    {
+        formatRange(values, out.arena_, out.ends_);
+        return;
+    }
+
+    // each chunk formats into its own arena, which are then concatenated in order
+    size_t                 chunkSize = (values.size() + chunks - 1) / chunks;
+    vector<decimal_column> parts(chunks);
+    pool.parallelFor(chunks,
+                     1,
+                     [&](size_t begin, size_t end)
+                     {
+                         for(size_t c = begin; c < end; c++)
+                         {
+                             size_t first = c * chunkSize;
+                             formatRange(values.subspan(first, min(chunkSize, values.size() - first)),
+                                         parts[c].arena_,
+                                         parts[c].ends_);
+                         }
+                     });
+
+    size_t total = 0;
+    for(const auto &part: parts)
+        total += part.arena_.size();
+    out.arena_.reserve(total);
+    for(const auto &part: parts)
+    {
+        size_t offset = out.arena_.size();
+        out.arena_ += part.arena_;
+        for(auto end: part.ends_)
+            out.ends_.push_back(offset + end);
+    }
+}
+
+void decimals_to_quadruples(const decimal_column &in, span<quadruple> out)
+{
+    parseColumn(in, out);
+}
+
+void decimals_to_quadruples(span<const string_view> in, span<quadruple> out)
+{
+    parseColumn(in, out);
+}
+
 };
 // namespace util
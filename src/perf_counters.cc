@@ -0,0 +1,207 @@
+/*
+ * File:        perf_counters.cc
+ * Description: Hardware performance counters through Linux perf_event_open.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <perf_counters.h>
+#include <string>
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace util
+{
+using namespace std;
+
+namespace
+{
+#if defined(__linux__)
+    /**
+     * Set type and configuration of the event for perf_event_open.
+     */
+    void setEventConfig(perf_event_attr &attr, PerfEvent event)
+    {
+        constexpr uint64_t loadMiss = uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8 |
+                                      uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16;
+        switch(event)
+        {
+            case PerfEvent::CYCLES:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfEvent::INSTRUCTIONS:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfEvent::L1D_MISSES:
+                attr.type   = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | loadMiss;
+                break;
+            case PerfEvent::LLC_MISSES:
+                attr.type   = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | loadMiss;
+                break;
+            case PerfEvent::BRANCH_MISSES:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            default:
+                attr.type   = PERF_TYPE_SOFTWARE;
+                attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                break;
+        }
+    }
+#endif
+
+    /**
+     * A group of all events, counting from its construction.
+     */
+    struct running_group
+    {
+        running_group()
+        {
+            group.start();
+        }
+
+        perf_counter_group group;
+    };
+};
+// namespace
+
+const char *perfEventName(PerfEvent event)
+{
+    switch(event)
+    {
+        case PerfEvent::CYCLES:
+            return ("cycles");
+        case PerfEvent::INSTRUCTIONS:
+            return ("instructions");
+        case PerfEvent::L1D_MISSES:
+            return ("L1-dcache-load-misses");
+        case PerfEvent::LLC_MISSES:
+            return ("LLC-load-misses");
+        case PerfEvent::BRANCH_MISSES:
+            return ("branch-misses");
+        default:
+            return ("task-clock");
+    }
+}
+
+perf_counter_group::perf_counter_group(uint32_t events)
+{
+    fds_.fill(-1);
+#if defined(__linux__)
+    for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+    {
+        auto event = PerfEvent(e);
+        if((events & perfEventBit(event)) == 0)
+            continue;
+
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        setEventConfig(attr, event);
+        attr.disabled       = leader_ < 0 ? 1 : 0;  // the group follows its leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, leader_, PERF_FLAG_FD_CLOEXEC));
+        if(fd < 0)
+        {
+            if(status_.empty())
+                status_ = string(perfEventName(event)) + ": " + strerror(errno);
+            continue;
+        }
+        if(leader_ < 0)
+            leader_ = fd;
+        fds_[e]           = fd;
+        order_[opened_++] = event;
+        events_ |= perfEventBit(event);
+    }
+#else
+    if(events != 0)
+        status_ = "performance counters are only supported on Linux";
+#endif
+}
+
+perf_counter_group::~perf_counter_group()
+{
+#if defined(__linux__)
+    for(int fd: fds_)
+        if(fd >= 0)
+            close(fd);
+#endif
+}
+
+void perf_counter_group::start()
+{
+#if defined(__linux__)
+    if(leader_ < 0)
+        return;
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void perf_counter_group::stop()
+{
+#if defined(__linux__)
+    if(leader_ >= 0)
+        ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+perf_sample perf_counter_group::read() const
+{
+    perf_sample reval;
+#if defined(__linux__)
+    if(leader_ < 0)
+        return (reval);
+
+    // number of values, time enabled, time running, values
+    uint64_t buffer[3 + PERF_EVENT_COUNT];
+    ssize_t  bytes = ::read(leader_, buffer, sizeof(buffer));
+    if(bytes < ssize_t(3 * sizeof(uint64_t)) || buffer[0] != opened_)
+        return (reval);
+
+    double scale = buffer[2] > 0 && buffer[2] < buffer[1] ? double(buffer[1]) / double(buffer[2]) : 1.0;
+    for(size_t i = 0; i < opened_; i++)
+        reval.values[size_t(order_[i])] = scale == 1.0 ? buffer[3 + i] : uint64_t(double(buffer[3 + i]) * scale);
+    reval.events = events_;
+#endif
+
+    return (reval);
+}
+
+perf_counter_group &threadPerfCounters()
+{
+    thread_local running_group reval;
+
+    return (reval.group);
+}
+};
+// namespace util
@@ -0,0 +1,422 @@
+/*
+ * File:        profiling.cc
+ * Description: Low-overhead scoped timers with per-thread aggregation.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <profiling.h>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace util
+{
+using namespace std;
+
+namespace profiling_detail
+{
+    thread_local constinit atomic<profile_counters *> *threadSites = nullptr;
+};
+// namespace profiling_detail
+
+namespace
+{
+    /**
+     * The counters of one thread; the table is read by reports under the registry mutex.
+     */
+    struct thread_profile
+    {
+        atomic<profile_counters *>           sites[MAX_PROFILE_SITES] = {};
+        vector<unique_ptr<profile_counters>> owned;
+    };
+
+    /**
+     * Plain sums of the counters of one site.
+     */
+    struct site_totals
+    {
+        uint64_t         count       = 0;
+        uint64_t         totalTicks  = 0;
+        uint64_t         minTicks    = UINT64_MAX;
+        uint64_t         maxTicks    = 0;
+        vector<uint64_t> histogram   = vector<uint64_t>(latency_histogram::bucketCount, 0);
+        uint64_t         eventScopes = 0;
+        perf_sample      events;
+
+        void add(const profile_counters &c)
+        {
+            count += c.count.load(memory_order_relaxed);
+            totalTicks += c.totalTicks.load(memory_order_relaxed);
+            minTicks = min(minTicks, c.minTicks.load(memory_order_relaxed));
+            maxTicks = max(maxTicks, c.maxTicks.load(memory_order_relaxed));
+            for(size_t b = 0; b < histogram.size(); b++)
+                histogram[b] += c.histogram[b].load(memory_order_relaxed);
+            eventScopes += c.eventScopes.load(memory_order_relaxed);
+            for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+                events.values[e] += c.events[e].load(memory_order_relaxed);
+            events.events |= c.eventMask.load(memory_order_relaxed);
+        }
+
+        void add(const site_totals &t)
+        {
+            count += t.count;
+            totalTicks += t.totalTicks;
+            minTicks = min(minTicks, t.minTicks);
+            maxTicks = max(maxTicks, t.maxTicks);
+            for(size_t b = 0; b < histogram.size(); b++)
+                histogram[b] += t.histogram[b];
+            eventScopes += t.eventScopes;
+            events += t.events;
+        }
+
+        /**
+         * Upper bound of the bucket holding the q-quantile, but no more than the maximum.
+         */
+        uint64_t quantile(double q) const
+        {
+            uint64_t rank = uint64_t(q * double(count - 1)) + 1;
+            uint64_t seen = 0;
+            for(size_t b = 0; b < histogram.size(); b++)
+            {
+                seen += histogram[b];
+                if(seen >= rank)
+                    return (min(latency_histogram::upperBound(b), maxTicks));
+            }
+
+            return (maxTicks);
+        }
+    };
+
+    struct profile_registry
+    {
+        mutex                           lock;
+        vector<string>                  labels;
+        unordered_map<string, uint32_t> sites;
+        vector<thread_profile *>        threads;
+        vector<site_totals>             retired;  ///< counters of threads that have finished
+    };
+
+    profile_registry &registry()
+    {
+        static profile_registry reval;
+
+        return (reval);
+    }
+
+    /**
+     * Set once the table of the thread is gone; scopes that end later, in the destructors of
+     * other thread_local objects, are not counted.
+     */
+    thread_local constinit bool ownerDestroyed = false;
+
+    /**
+     * Creates the table of the thread on its first scope, and folds it into the retired totals
+     * when the thread ends.
+     */
+    struct thread_owner
+    {
+        thread_owner() : profile(new thread_profile)
+        {
+            auto             &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            r.threads.push_back(profile);
+            profiling_detail::threadSites = profile->sites;
+        }
+
+        ~thread_owner()
+        {
+            auto             &r = registry();
+            lock_guard<mutex> guard(r.lock);
+            for(size_t s = 0; s < MAX_PROFILE_SITES; s++)
+            {
+                const profile_counters *c = profile->sites[s].load(memory_order_relaxed);
+                if(c != nullptr)
+                {
+                    r.retired.resize(max(r.retired.size(), s + 1));
+                    r.retired[s].add(*c);
+                }
+            }
+            r.threads.erase(find(r.threads.begin(), r.threads.end(), profile));
+            profiling_detail::threadSites = nullptr;
+            ownerDestroyed                = true;
+            delete profile;
+        }
+
+        thread_profile *profile;
+    };
+
+    /**
+     * Restores the formatting flags, precision and fill of the caller's stream, which the reports
+     * change.
+     */
+    struct stream_format_saver
+    {
+        explicit stream_format_saver(ostream &os)
+        : os(os)
+        , flags(os.flags())
+        , precision(os.precision())
+        , fill(os.fill())
+        {
+        }
+
+        ~stream_format_saver()
+        {
+            os.flags(flags);
+            os.precision(precision);
+            os.fill(fill);
+        }
+
+        ostream           &os;
+        ios_base::fmtflags flags;
+        streamsize         precision;
+        char               fill;
+    };
+
+    double toNanoseconds(uint64_t ticks)
+    {
+        return (double(ticks) / ticksPerNanosecond());
+    }
+
+    string jsonEscaped(const string &text)
+    {
+        string reval;
+        for(char c: text)
+        {
+            if(c == '"' || c == '\\')
+                reval += '\\';
+            reval += c;
+        }
+
+        return (reval);
+    }
+};
+// namespace
+
+double ticksPerNanosecond()
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    static const double reval = []
+    {
+        using clock_t = chrono::steady_clock;
+
+        auto     start      = clock_t::now();
+        uint64_t startTicks = profileTicks();
+        while(clock_t::now() - start < chrono::milliseconds(20))
+            ;
+        uint64_t ticks = profileTicks() - startTicks;
+        double   nanos = double(chrono::duration_cast<chrono::nanoseconds>(clock_t::now() - start).count());
+
+        return (double(ticks) / nanos);
+    }();
+
+    return (reval);
+#else
+    return (1.0);
+#endif
+}
+
+uint32_t registerProfileSite(const string &label)
+{
+    auto             &r = registry();
+    lock_guard<mutex> guard(r.lock);
+
+    auto found = r.sites.find(label);
+    if(found != r.sites.end())
+        return (found->second);
+    if(r.labels.size() >= MAX_PROFILE_SITES)
+        throw length_error("registerProfileSite(" + label + "): more than " + to_string(MAX_PROFILE_SITES) +
+                           " profiling labels");
+
+    uint32_t reval = uint32_t(r.labels.size());
+    r.labels.push_back(label);
+    r.sites.emplace(label, reval);
+
+    return (reval);
+}
+
+profile_counters &threadProfileCounters(uint32_t site)
+{
+    if(ownerDestroyed)
+    {
+        static profile_counters discarded;
+
+        return (discarded);
+    }
+    thread_local thread_owner owner;
+
+    profile_counters *reval = owner.profile->sites[site].load(memory_order_relaxed);
+    if(reval == nullptr)
+    {
+        auto             &r = registry();
+        lock_guard<mutex> guard(r.lock);
+        owner.profile->owned.push_back(make_unique<profile_counters>());
+        reval = owner.profile->owned.back().get();
+        owner.profile->sites[site].store(reval, memory_order_release);
+    }
+
+    return (*reval);
+}
+
+vector<profile_entry> profileReport()
+{
+    auto                 &r = registry();
+    vector<profile_entry> reval;
+    {
+        lock_guard<mutex> guard(r.lock);
+        for(size_t s = 0; s < r.labels.size(); s++)
+        {
+            site_totals totals;
+            if(s < r.retired.size())
+                totals.add(r.retired[s]);
+            for(auto *t: r.threads)
+            {
+                const profile_counters *c = t->sites[s].load(memory_order_acquire);
+                if(c != nullptr)
+                    totals.add(*c);
+            }
+            if(totals.count == 0)
+                continue;
+
+            profile_entry entry;
+            entry.label       = r.labels[s];
+            entry.count       = totals.count;
+            entry.totalNs     = toNanoseconds(totals.totalTicks);
+            entry.minNs       = toNanoseconds(totals.minTicks);
+            entry.maxNs       = toNanoseconds(totals.maxTicks);
+            entry.meanNs      = entry.totalNs / double(totals.count);
+            entry.p50Ns       = toNanoseconds(totals.quantile(0.5));
+            entry.p90Ns       = toNanoseconds(totals.quantile(0.9));
+            entry.p99Ns       = toNanoseconds(totals.quantile(0.99));
+            entry.p999Ns      = toNanoseconds(totals.quantile(0.999));
+            entry.eventScopes = totals.eventScopes;
+            entry.events      = totals.events;
+            reval.push_back(entry);
+        }
+    }
+    sort(reval.begin(),
+         reval.end(),
+         [](const profile_entry &lhs, const profile_entry &rhs) { return (lhs.totalNs > rhs.totalNs); });
+
+    return (reval);
+}
+
+void printProfileReport(ostream &os)
+{
+    stream_format_saver saver(os);
+    os << left << setw(32) << "label" << right << setw(12) << "count" << setw(14) << "total ms" << setw(12)
+       << "mean ns" << setw(12) << "min ns" << setw(12) << "p50 ns" << setw(12) << "p99 ns" << setw(12) << "max ns"
+       << endl;
+    auto entries = profileReport();
+    for(const auto &e: entries)
+        os << left << setw(32) << e.label << right << setw(12) << e.count << fixed << setprecision(3) << setw(14)
+           << e.totalNs / 1e6 << setprecision(1) << setw(12) << e.meanNs << setw(12) << e.minNs << setw(12) << e.p50Ns
+           << setw(12) << e.p99Ns << setw(12) << e.maxNs << endl;
+
+    vector<profile_entry> counted;
+    for(const auto &e: entries)
+        if(e.eventScopes > 0)
+            counted.push_back(e);
+    if(counted.empty())
+        return;
+
+    os << endl << left << setw(32) << "label (per scope)" << right << setw(12) << "scopes";
+    for(size_t ev = 0; ev < PERF_EVENT_COUNT; ev++)
+        os << setw(22) << perfEventName(PerfEvent(ev));
+    os << endl;
+    for(const auto &e: counted)
+    {
+        os << left << setw(32) << e.label << right << setw(12) << e.eventScopes << fixed << setprecision(1);
+        for(size_t ev = 0; ev < PERF_EVENT_COUNT; ev++)
+        {
+            if(e.events.has(PerfEvent(ev)))
+                os << setw(22) << double(e.events.values[ev]) / double(e.eventScopes);
+            else
+                os << setw(22) << "-";
+        }
+        os << endl;
+    }
+}
+
+void printProfileReportJson(ostream &os)
+{
+    stream_format_saver saver(os);
+    os << "[";
+    bool first = true;
+    for(const auto &e: profileReport())
+    {
+        os << (first ? "\n" : ",\n") << "  {\"label\": \"" << jsonEscaped(e.label) << "\", \"count\": " << e.count
+           << fixed << setprecision(1) << ", \"total_ns\": " << e.totalNs << ", \"mean_ns\": " << e.meanNs
+           << ", \"min_ns\": " << e.minNs << ", \"p50_ns\": " << e.p50Ns << ", \"p90_ns\": " << e.p90Ns
+           << ", \"p99_ns\": " << e.p99Ns << ", \"p999_ns\": " << e.p999Ns << ", \"max_ns\": " << e.maxNs;
+        if(e.eventScopes > 0)
+        {
+            // mean counts per scope
+            os << ", \"event_scopes\": " << e.eventScopes << ", \"events\": {";
+            const char *separator = "";
+            for(size_t ev = 0; ev < PERF_EVENT_COUNT; ev++)
+            {
+                if(!e.events.has(PerfEvent(ev)))
+                    continue;
+                os << separator << "\"" << perfEventName(PerfEvent(ev))
+                   << "\": " << double(e.events.values[ev]) / double(e.eventScopes);
+                separator = ", ";
+            }
+            os << "}";
+        }
+        os << "}";
+        first = false;
+    }
+    os << "\n]" << endl;
+}
+
+void resetProfile()
+{
+    auto             &r = registry();
+    lock_guard<mutex> guard(r.lock);
+
+    r.retired.clear();
+    for(auto *t: r.threads)
+    {
+        for(auto &site: t->sites)
+        {
+            profile_counters *c = site.load(memory_order_relaxed);
+            if(c == nullptr)
+                continue;
+            c->count.store(0, memory_order_relaxed);
+            c->totalTicks.store(0, memory_order_relaxed);
+            c->minTicks.store(UINT64_MAX, memory_order_relaxed);
+            c->maxTicks.store(0, memory_order_relaxed);
+            for(auto &b: c->histogram)
+                b.store(0, memory_order_relaxed);
+            c->eventScopes.store(0, memory_order_relaxed);
+            for(auto &v: c->events)
+                v.store(0, memory_order_relaxed);
+            c->eventMask.store(0, memory_order_relaxed);
+        }
+    }
+}
+};
+// namespace util
@@ -22,95 +22,431 @@
  * @author: Dieter J Kybelksties
  */
 
+#include "cpu_features.h"
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <stringutil.h>
+#include <type_traits>
+#include <utility>
+
+#if defined (__x86_64__) && defined (__GNUC__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 using namespace util;
 
 namespace util
 {
-    /**
-     * try to classify a string into one of the classes NONE, INT, UINT, FLOAT
-     * invalid strings have class NONE
-     * integral types INT or UINT
-     * and valid floating point strings are FLOAT
-     * this function is template'd to allow for case-(in-)sensitive strings
-     */
-    template<typename T_>
-        NumberClass classifyNumberStringT (const T_ &str)
+    namespace
+    {
+        // 10^0 .. 10^27 are exact in a long double (5^27 < 2^64)
+        constexpr int maxExactPowerOfTen = 27;
+
+        constexpr array<long double, maxExactPowerOfTen + 1> exactPowersOfTen = [] ()
         {
-            static size_t maxIntLen = asString (numeric_limits<int64_t>::max ()).size ();
-            static size_t maxUintLen = asString (numeric_limits<uint64_t>::max ()).size ();
+            array<long double, maxExactPowerOfTen + 1> reval{};
+            long double p = 1.0L;
+            for (auto &r : reval)
+            {
+                r = p;
+                p *= 10.0L;
+            }
+            return (reval);
+        } ();
 
-            if (str.empty () || str.find_first_not_of ("0123456789+-.eElL") != T_::npos)
-                return (NONE);
+        inline bool isDigit (char c)
+        {
+            return (static_cast<unsigned char> (c - '0') < 10);
+        }
+    };
+    // namespace
+
+    NumberClass scanNumberString (string_view str, NumberValue &value)
+    {
+        value = NumberValue ();
 
-            if (str.find_first_of (".e") != T_::npos)
-                return (FLOAT);
+        const char *p = str.data ();
+        const char *end = p + str.size ();
 
-            bool isNegative = (str[0] == '-');
-            bool isSigned = (str[0] == '-' || str[0] == '+');
+        if (p != end && (*p == 'l' || *p == 'L'))
+            return (NONE);
+        if (p != end && (end[-1] == 'l' || end[-1] == 'L'))
+            end--;
 
-            bool reval = ((isdigit (str[0])) || ((str.size () > 1) && isSigned));
-            if (str.size () - (isSigned ? 1 : 0) > maxUintLen)
-                return (FLOAT);
+        bool isNegative = (p != end && *p == '-');
+        if (p != end && (*p == '-' || *p == '+'))
+            p++;
+        const char *numberBegin = p;
+
+        // integers accumulate into magnitude, floats keep the first 19 significant digits in
+        // mantissa and only count the following ones
+        uint64_t magnitude = 0;
+        bool overflow = false;
+        uint64_t mantissa = 0;
+        int significant = 0;
+        int droppedExponent = 0;
+        bool truncated = false;
+        size_t digits = 0;
+
+        for (; p != end && isDigit (*p); p++, digits++)
+        {
+            unsigned digit = *p - '0';
+            overflow |= __builtin_mul_overflow (magnitude, 10, &magnitude);
+            overflow |= __builtin_add_overflow (magnitude, digit, &magnitude);
+            if (significant < 19)
+            {
+                mantissa = mantissa * 10 + digit;
+                significant += (mantissa != 0);
+            }
             else
             {
-                if (str.size () - (isSigned ? 1 : 0) >= maxIntLen)
-                    return (isNegative ? FLOAT : UINT);
+                droppedExponent++;
+                truncated |= (digit != 0);
+            }
+        }
+
+        bool isFloat = false;
+        if (p != end && *p == '.')
+        {
+            isFloat = true;
+            for (p++; p != end && isDigit (*p); p++, digits++)
+            {
+                if (significant < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    significant += (mantissa != 0);
+                    droppedExponent--;
+                }
                 else
-                    return (INT);
+                    truncated |= (*p != '0');
+            }
+        }
+        if (digits == 0)
+            return (NONE);
+
+        int exponent = 0;
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            isFloat = true;
+            p++;
+            bool negativeExponent = (p != end && *p == '-');
+            if (p != end && (*p == '-' || *p == '+'))
+                p++;
+            if (p == end)
+                return (NONE);
+            for (; p != end && isDigit (*p); p++)
+                exponent = min (exponent * 10 + (*p - '0'), 100000);
+            if (negativeExponent)
+                exponent = -exponent;
+        }
+        if (p != end)
+            return (NONE);
+
+        if (!isFloat && !overflow)
+        {
+            constexpr uint64_t int64Limit = uint64_t (numeric_limits<int64_t>::max ());
+
+            if (magnitude <= int64Limit + isNegative)
+            {
+                value.numberClass = INT;
+                value.intValue = int64_t (isNegative ? 0 - magnitude : magnitude);
+                return (INT);
+            }
+            if (!isNegative)
+            {
+                value.numberClass = UINT;
+                value.uintValue = magnitude;
+                return (UINT);
             }
         }
 
+        value.numberClass = FLOAT;
+        int scale = exponent + droppedExponent;
+        if (!truncated && scale >= -maxExactPowerOfTen && scale <= maxExactPowerOfTen)
+        {
+            // mantissa (at most 19 digits) and power are exact: a single rounding
+            long double v = static_cast<long double> (mantissa);
+            v = scale < 0 ? v / exactPowersOfTen[-scale] : v * exactPowersOfTen[scale];
+            value.floatValue = isNegative ? -v : v;
+        }
+        else
+        {
+            long double v = 0.0L;
+            auto result = from_chars (numberBegin, end, v, chars_format::general);
+            // the leading digit of mantissa * 10^scale is at decimal position significant + scale
+            if (result.ec == errc::result_out_of_range)
+                v = significant + scale > 0 ? numeric_limits<long double>::infinity () : 0.0L;
+            value.floatValue = isNegative ? -v : v;
+        }
+
+        return (FLOAT);
+    }
+
+    NumberClass scanNumberStrings (span<const string_view> cells, vector<NumberValue> &values)
+    {
+        values.resize (cells.size ());
+        if (cells.empty ())
+            return (NONE);
+
+        bool allInt = true;
+        bool anyUint = false;
+        bool anyNegative = false;
+        for (size_t i = 0; i < cells.size (); i++)
+        {
+            switch (scanNumberString (cells[i], values[i]))
+            {
+                case NONE:
+                    return (NONE);
+                case INT:
+                    anyNegative |= (values[i].intValue < 0);
+                    break;
+                case UINT:
+                    anyUint = true;
+                    break;
+                case FLOAT:
+                    allInt = false;
+                    break;
+            }
+        }
+
+        NumberClass reval = !allInt || (anyUint && anyNegative) ? FLOAT : anyUint ? UINT : INT;
+        for (auto &v : values)
+        {
+            if (reval == UINT && v.numberClass == INT)
+                v.uintValue = uint64_t (v.intValue);
+            else if (reval == FLOAT && v.numberClass == INT)
+                v.floatValue = v.intValue;
+            else if (reval == FLOAT && v.numberClass == UINT)
+                v.floatValue = v.uintValue;
+        }
+
+        return (reval);
+    }
+
     NumberClass classifyNumberString (const string &str)
     {
-        return (classifyNumberStringT (str));
+        NumberValue value;
+
+        return (scanNumberString (str, value));
     }
 
     NumberClass classifyNumberString (const ci_string &str)
     {
-        return (classifyNumberStringT (str));
+        NumberValue value;
+
+        return (scanNumberString (string_view (str.data (), str.size ()), value));
     }
 
-    /**
-     * ry to scan a string representation of a boolean by most common values
-     * like True, on/Off/...
-     */
-    template<typename T_>
-        bool scanBoolStringT (const T_ &strVal, bool &result)
+    namespace
+    {
+        /**
+         * Built-in boolean tokens, packed case-folded into the low bytes of a word.
+         */
+        struct BoolToken
+        {
+            uint64_t key = 0;
+            size_t length = 0;
+            bool value = false;
+        };
+
+        constexpr size_t maxBoolTokenLength = sizeof (uint64_t);
+
+        constexpr uint64_t foldedKey (string_view token)
+        {
+            uint64_t reval = 0;
+            for (size_t i = 0; i < token.size (); i++)
+                reval |= uint64_t (ciFold (token[i])) << (8 * i);
+
+            return (reval);
+        }
+
+        constexpr BoolToken builtinBoolTokens[] = {
+            { foldedKey ("true"), 4, true },
+            { foldedKey ("t"), 1, true },
+            { foldedKey ("yes"), 3, true },
+            { foldedKey ("y"), 1, true },
+            { foldedKey ("1"), 1, true },
+            { foldedKey ("on"), 2, true },
+            { foldedKey ("false"), 5, false },
+            { foldedKey ("f"), 1, false },
+            { foldedKey ("no"), 2, false },
+            { foldedKey ("n"), 1, false },
+            { foldedKey ("0"), 1, false },
+            { foldedKey ("off"), 3, false }
+        };
+
+        /**
+         * Perfect hash of the built-in tokens: multiply-shift into 32 slots with the first
+         * multiplier (searched at compile time) that maps no two tokens into the same slot.
+         */
+        constexpr unsigned boolTableBits = 5;
+
+        constexpr size_t boolSlot (uint64_t key, uint64_t multiplier)
+        {
+            return (size_t ((key * multiplier) >> (64 - boolTableBits)));
+        }
+
+        constexpr uint64_t boolHashMultiplier = [] ()
+        {
+            for (uint64_t multiplier = 0x9E3779B97F4A7C15ULL;; multiplier += 0x5851F42D4C957F2EULL)
+            {
+                bool used[1U << boolTableBits] = {};
+                bool perfect = true;
+                for (const auto &token : builtinBoolTokens)
+                {
+                    size_t slot = boolSlot (token.key, multiplier | 1);
+                    perfect &= !used[slot];
+                    used[slot] = true;
+                }
+                if (perfect)
+                    return (multiplier | 1);
+            }
+        } ();
+
+        constexpr array<BoolToken, 1U << boolTableBits> boolTable = [] ()
         {
-            const static map<ci_string, bool> VALID_BOOL =
+            array<BoolToken, 1U << boolTableBits> reval{};
+            for (const auto &token : builtinBoolTokens)
+                reval[boolSlot (token.key, boolHashMultiplier)] = token;
+
+            return (reval);
+        } ();
+
+        bool findBuiltinBoolToken (string_view strVal, bool &result)
+        {
+            if (strVal.empty () || strVal.size () > maxBoolTokenLength)
+                return (false);
+
+            uint64_t key = foldedKey (strVal);
+            const BoolToken &token = boolTable[boolSlot (key, boolHashMultiplier)];
+            if (token.length != strVal.size () || token.key != key)
+                return (false);
+            result = token.value;
+
+            return (true);
+        }
+
+        /**
+         * User-registered tokens: an immutable snapshot, sorted by case-folded token, that is
+         * replaced atomically. Writers are serialised by the mutex and bump the version; readers
+         * do not lock but keep a thread-local copy of the snapshot pointer that they only renew
+         * when the version has changed (version 0: no tokens registered).
+         */
+        using BoolTokens = vector<pair<string, bool>>;
+
+        bool ciLess (string_view lhs, string_view rhs)
+        {
+            return (lexicographical_compare (lhs.begin (),
+                                             lhs.end (),
+                                             rhs.begin (),
+                                             rhs.end (),
+                                             [] (char l, char r) { return (ciFold (l) < ciFold (r)); }));
+        }
+
+        struct BoolTokenRegistry
+        {
+            void publish (shared_ptr<const BoolTokens> tokens, bool empty)
             {
-            { "true", true },
-            { "t", true },
-            { "yes", true },
-            { "y", true },
-            { "1", true },
-            { "on", true },
-            { "false", false },
-            { "f", false },
-            { "no", false },
-            { "n", false },
-            { "0", false },
-            { "off", false } };
+                tokens_.store (std::move (tokens));
+                version_.store (empty ? 0 : nextVersion_++, memory_order_release);
+            }
 
-            auto found = VALID_BOOL.find (ci_string (strVal.c_str ()));
+            mutex writeMutex_;
+            unsigned long nextVersion_ = 1;
+            atomic<unsigned long> version_{0};
+            atomic<shared_ptr<const BoolTokens>> tokens_{make_shared<const BoolTokens> ()};
+        };
 
-            result = found != VALID_BOOL.end () ? found->second : false;
+        BoolTokenRegistry &boolTokenRegistry ()
+        {
+            static BoolTokenRegistry reg;
 
-            return (found != VALID_BOOL.end ());
+            return (reg);
         }
 
-    bool scanBoolString (const string &strVal, bool &result)
+        bool findUserBoolToken (string_view strVal, bool &result)
+        {
+            thread_local unsigned long version = 0;
+            thread_local shared_ptr<const BoolTokens> tokens;
+
+            BoolTokenRegistry &reg = boolTokenRegistry ();
+            unsigned long current = reg.version_.load (memory_order_acquire);
+            if (current == 0)
+                return (false);
+            if (current != version)
+            {
+                tokens = reg.tokens_.load ();
+                version = current;
+            }
+
+            auto found = lower_bound (tokens->begin (),
+                                      tokens->end (),
+                                      strVal,
+                                      [] (const auto &token, string_view v) { return (ciLess (token.first, v)); });
+            if (found == tokens->end () || ciLess (strVal, found->first))
+                return (false);
+            result = found->second;
+
+            return (true);
+        }
+    };
+    // namespace
+
+    bool scanBoolString (string_view strVal, bool &result)
     {
-        return (scanBoolStringT (strVal, result));
+        if (findBuiltinBoolToken (strVal, result) || findUserBoolToken (strVal, result))
+            return (true);
+        result = false;
+
+        return (false);
     }
 
     bool scanBoolString (const util::ci_string &strVal, bool &result)
     {
-        return (scanBoolStringT (strVal, result));
+        return (scanBoolString (string_view (strVal.data (), strVal.size ()), result));
+    }
+
+    void addBoolToken (string_view token, bool value)
+    {
+        bool existing = false;
+        if (token.empty ())
+            throw invalid_argument ("addBoolToken: empty token");
+        if (findBuiltinBoolToken (token, existing) && existing != value)
+            throw invalid_argument ("addBoolToken: '" + string (token) + "' is a built-in token of the opposite value");
+        if (findBuiltinBoolToken (token, existing))
+            return;
+
+        BoolTokenRegistry &reg = boolTokenRegistry ();
+        lock_guard<mutex> lock (reg.writeMutex_);
+
+        auto tokens = make_shared<BoolTokens> (*reg.tokens_.load ());
+        auto found = lower_bound (tokens->begin (),
+                                  tokens->end (),
+                                  token,
+                                  [] (const auto &t, string_view v) { return (ciLess (t.first, v)); });
+        if (found != tokens->end () && !ciLess (token, found->first))
+            found->second = value;
+        else
+            tokens->emplace (found, string (token), value);
+
+        reg.publish (std::move (tokens), false);
+    }
+
+    void resetBoolTokens ()
+    {
+        BoolTokenRegistry &reg = boolTokenRegistry ();
+        lock_guard<mutex> lock (reg.writeMutex_);
+
+        reg.publish (make_shared<const BoolTokens> (), true);
     }
 
     StripTrimMode operator& (const StripTrimMode lhs, const StripTrimMode &rhs)
@@ -123,6 +459,776 @@ namespace util
         return (static_cast<StripTrimMode> (static_cast<unsigned char> (lhs) | static_cast<unsigned char> (rhs)));
     }
 
+    namespace
+    {
+        /**
+         * 256-bit character class. The bitmap serves the scalar code, the nibble tables the
+         * AVX2 kernels: a byte c is a member iff
+         * lowTable[c & 0xF] & highBit[c >> 4] != 0, with one table pair for c < 0x80 and one for
+         * c >= 0x80 (a byte only has 8 bits to mark the 16 possible high nibbles).
+         */
+        class CharClass
+        {
+            public:
+            template<typename T_>
+                explicit CharClass (const T_ &chars)
+                {
+                    for (auto c : chars)
+                    {
+                        add (static_cast<unsigned char> (c));
+                        if (isCaseInsensitive<T_> () && ciFold (c) != static_cast<unsigned char> (c))
+                            add (ciFold (c));
+                        else if (isCaseInsensitive<T_> () && c >= 'A' && c <= 'Z')
+                            add (static_cast<unsigned char> (c - 'A' + 'a'));
+                    }
+                }
+
+            bool contains (unsigned char c) const
+            {
+                return ((bits_[c >> 6] >> (c & 63)) & 1);
+            }
+
+            bool hasHighChars () const
+            {
+                return (hasHighChars_);
+            }
+
+            const unsigned char *lowTable (bool high) const
+            {
+                return (high ? lowTableHigh_ : lowTableLow_);
+            }
+
+            private:
+            template<typename T_>
+                static constexpr bool isCaseInsensitive ()
+                {
+                    return (is_same_v<typename T_::traits_type, ci_char_traits>);
+                }
+
+            void add (unsigned char c)
+            {
+                bits_[c >> 6] |= uint64_t (1) << (c & 63);
+                if (c < 0x80)
+                    lowTableLow_[c & 0xF] |= 1 << (c >> 4);
+                else
+                {
+                    lowTableHigh_[c & 0xF] |= 1 << ((c >> 4) - 8);
+                    hasHighChars_ = true;
+                }
+            }
+
+            uint64_t bits_[4] = { 0, 0, 0, 0 };
+            alignas (16) unsigned char lowTableLow_[16] = { };
+            alignas (16) unsigned char lowTableHigh_[16] = { };
+            bool hasHighChars_ = false;
+        };
+
+        size_t findFirstNotInScalar (const char *p, size_t n, const CharClass &cls)
+        {
+            for (size_t i = 0; i < n; i++)
+                if (!cls.contains (static_cast<unsigned char> (p[i])))
+                    return (i);
+
+            return (string::npos);
+        }
+
+        size_t findLastNotInScalar (const char *p, size_t n, const CharClass &cls)
+        {
+            for (size_t i = n; i > 0; i--)
+                if (!cls.contains (static_cast<unsigned char> (p[i - 1])))
+                    return (i - 1);
+
+            return (string::npos);
+        }
+
+        size_t removeInScalar (char *p, size_t n, const CharClass &cls)
+        {
+            size_t out = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                p[out] = p[i];
+                out += !cls.contains (static_cast<unsigned char> (p[i]));
+            }
+
+            return (out);
+        }
+
+        void replaceInScalar (char *p, size_t n, const CharClass &cls, char repl)
+        {
+            for (size_t i = 0; i < n; i++)
+                if (cls.contains (static_cast<unsigned char> (p[i])))
+                    p[i] = repl;
+        }
+
+#if defined (__x86_64__) && defined (__GNUC__)
+        constexpr size_t avx2Width = 32;
+
+        /**
+         * Nibble tables of a CharClass broadcast into both 128-bit lanes (vpshufb is per lane).
+         */
+        struct Avx2Class
+        {
+            __attribute__ ((target ("avx2")))
+            explicit Avx2Class (const CharClass &cls)
+            : high (cls.hasHighChars ())
+            {
+                const __m128i highBitsLow = _mm_setr_epi8 (1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+                const __m128i highBitsHigh = _mm_setr_epi8 (0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+
+                lowLow = _mm256_broadcastsi128_si256 (_mm_load_si128 (reinterpret_cast<const __m128i *> (cls.lowTable (false))));
+                lowHigh = _mm256_broadcastsi128_si256 (_mm_load_si128 (reinterpret_cast<const __m128i *> (cls.lowTable (true))));
+                highLow = _mm256_broadcastsi128_si256 (highBitsLow);
+                highHigh = _mm256_broadcastsi128_si256 (highBitsHigh);
+            }
+
+            /**
+             * 0xFF in each byte of v that is NOT a member, 0 otherwise.
+             */
+            __attribute__ ((target ("avx2")))
+            __m256i nonMemberBytes (__m256i v) const
+            {
+                const __m256i nibble = _mm256_set1_epi8 (0x0F);
+                __m256i lo = _mm256_and_si256 (v, nibble);
+                __m256i hi = _mm256_and_si256 (_mm256_srli_epi16 (v, 4), nibble);
+                __m256i m = _mm256_and_si256 (_mm256_shuffle_epi8 (lowLow, lo), _mm256_shuffle_epi8 (highLow, hi));
+
+                if (high)
+                    m = _mm256_or_si256 (m, _mm256_and_si256 (_mm256_shuffle_epi8 (lowHigh, lo),
+                                                              _mm256_shuffle_epi8 (highHigh, hi)));
+
+                return (_mm256_cmpeq_epi8 (m, _mm256_setzero_si256 ()));
+            }
+
+            /**
+             * Bit i set iff byte i of v is NOT a member.
+             */
+            __attribute__ ((target ("avx2")))
+            uint32_t nonMembers (__m256i v) const
+            {
+                return (static_cast<uint32_t> (_mm256_movemask_epi8 (nonMemberBytes (v))));
+            }
+
+            __m256i lowLow;
+            __m256i lowHigh;
+            __m256i highLow;
+            __m256i highHigh;
+            bool high;
+        };
+
+        __attribute__ ((target ("avx2")))
+        size_t findFirstNotInAvx2 (const char *p, size_t n, const CharClass &cls)
+        {
+            Avx2Class avx (cls);
+            size_t i = 0;
+
+            for (; i + avx2Width <= n; i += avx2Width)
+            {
+                uint32_t nonMembers = avx.nonMembers (_mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p + i)));
+                if (nonMembers != 0)
+                    return (i + __builtin_ctz (nonMembers));
+            }
+            size_t reval = findFirstNotInScalar (p + i, n - i, cls);
+
+            return (reval == string::npos ? reval : i + reval);
+        }
+
+        __attribute__ ((target ("avx2")))
+        size_t findLastNotInAvx2 (const char *p, size_t n, const CharClass &cls)
+        {
+            Avx2Class avx (cls);
+            size_t i = n;
+
+            for (; i >= avx2Width; i -= avx2Width)
+            {
+                uint32_t nonMembers = avx.nonMembers (_mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p + i - avx2Width)));
+                if (nonMembers != 0)
+                    return (i - 1 - __builtin_clz (nonMembers));
+            }
+
+            return (findLastNotInScalar (p, i, cls));
+        }
+
+        __attribute__ ((target ("avx2")))
+        size_t removeInAvx2 (char *p, size_t n, const CharClass &cls)
+        {
+            Avx2Class avx (cls);
+            size_t out = 0;
+            size_t i = 0;
+
+            for (; i + avx2Width <= n; i += avx2Width)
+            {
+                __m256i v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p + i));
+                uint32_t keep = avx.nonMembers (v);
+
+                if (keep == 0xFFFFFFFFU)
+                {
+                    // out <= i, so this only overwrites bytes that are already loaded
+                    _mm256_storeu_si256 (reinterpret_cast<__m256i *> (p + out), v);
+                    out += avx2Width;
+                }
+                else
+                {
+                    alignas (32) char block[avx2Width];
+                    _mm256_store_si256 (reinterpret_cast<__m256i *> (block), v);
+                    for (; keep != 0; keep &= keep - 1)
+                        p[out++] = block[__builtin_ctz (keep)];
+                }
+            }
+
+            for (; i < n; i++)
+            {
+                p[out] = p[i];
+                out += !cls.contains (static_cast<unsigned char> (p[i]));
+            }
+
+            return (out);
+        }
+
+        __attribute__ ((target ("avx2")))
+        void replaceInAvx2 (char *p, size_t n, const CharClass &cls, char repl)
+        {
+            Avx2Class avx (cls);
+            const __m256i replacement = _mm256_set1_epi8 (repl);
+            size_t i = 0;
+
+            for (; i + avx2Width <= n; i += avx2Width)
+            {
+                __m256i v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p + i));
+                _mm256_storeu_si256 (reinterpret_cast<__m256i *> (p + i),
+                                     _mm256_blendv_epi8 (replacement, v, avx.nonMemberBytes (v)));
+            }
+            replaceInScalar (p + i, n - i, cls, repl);
+        }
+#endif
+
+        size_t findFirstNotIn (const char *p, size_t n, const CharClass &cls)
+        {
+#if defined (__x86_64__) && defined (__GNUC__)
+            if (n >= avx2Width && hasAvx2 ())
+                return (findFirstNotInAvx2 (p, n, cls));
+#endif
+            return (findFirstNotInScalar (p, n, cls));
+        }
+
+        size_t findLastNotIn (const char *p, size_t n, const CharClass &cls)
+        {
+#if defined (__x86_64__) && defined (__GNUC__)
+            if (n >= avx2Width && hasAvx2 ())
+                return (findLastNotInAvx2 (p, n, cls));
+#endif
+            return (findLastNotInScalar (p, n, cls));
+        }
+
+        size_t removeIn (char *p, size_t n, const CharClass &cls)
+        {
+#if defined (__x86_64__) && defined (__GNUC__)
+            if (n >= avx2Width && hasAvx2 ())
+                return (removeInAvx2 (p, n, cls));
+#endif
+            return (removeInScalar (p, n, cls));
+        }
+
+        void replaceIn (char *p, size_t n, const CharClass &cls, char repl)
+        {
+#if defined (__x86_64__) && defined (__GNUC__)
+            if (n >= avx2Width && hasAvx2 ())
+            {
+                replaceInAvx2 (p, n, cls, repl);
+                return;
+            }
+#endif
+            replaceInScalar (p, n, cls, repl);
+        }
+    };
+    // namespace
+
+    /**
+     * ASCII case conversion; written branch-free so that the compiler vectorises it, cloned for
+     * AVX2 and selected at load time.
+     */
+#if defined (__x86_64__) && defined (__GNUC__)
+    __attribute__ ((target_clones ("avx2", "default")))
+#endif
+    static void asciiToLower (char *p, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            unsigned char c = static_cast<unsigned char> (p[i]);
+            p[i] = static_cast<char> (c + (static_cast<unsigned char> (c - 'A') < 26 ? 0x20 : 0));
+        }
+    }
+
+#if defined (__x86_64__) && defined (__GNUC__)
+    __attribute__ ((target_clones ("avx2", "default")))
+#endif
+    static void asciiToUpper (char *p, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            unsigned char c = static_cast<unsigned char> (p[i]);
+            p[i] = static_cast<char> (c - (static_cast<unsigned char> (c - 'a') < 26 ? 0x20 : 0));
+        }
+    }
+
+    void toLowerInPlace (string &str)
+    {
+        asciiToLower (str.data (), str.size ());
+    }
+
+    void toLowerInPlace (ci_string &str)
+    {
+        asciiToLower (str.data (), str.size ());
+    }
+
+    void toUpperInPlace (string &str)
+    {
+        asciiToUpper (str.data (), str.size ());
+    }
+
+    void toUpperInPlace (ci_string &str)
+    {
+        asciiToUpper (str.data (), str.size ());
+    }
+
+    namespace
+    {
+        /**
+         * Lead bytes of UTF-8 sequences (Unicode table 3-7): the length of the sequence and the
+         * range of its second byte, which excludes overlong forms, surrogates and code points
+         * above U+10FFFF. Further bytes are in 80..BF. Length 0 marks bytes that cannot start a
+         * sequence.
+         */
+        struct Utf8Lead
+        {
+            uint8_t length = 0;
+            uint8_t low = 0x80;
+            uint8_t high = 0xBF;
+        };
+
+        constexpr array<Utf8Lead, 256> utf8Leads = [] ()
+        {
+            array<Utf8Lead, 256> reval{};
+            for (unsigned c = 0; c < 0x80; c++)
+                reval[c].length = 1;
+            for (unsigned c = 0xC2; c <= 0xDF; c++)
+                reval[c].length = 2;
+            for (unsigned c = 0xE0; c <= 0xEF; c++)
+                reval[c].length = 3;
+            for (unsigned c = 0xF0; c <= 0xF4; c++)
+                reval[c].length = 4;
+            reval[0xE0].low = 0xA0;
+            reval[0xED].high = 0x9F;
+            reval[0xF0].low = 0x90;
+            reval[0xF4].high = 0x8F;
+            return (reval);
+        } ();
+
+        /**
+         * Decode the sequence at p into cp; returns its length, or 0 if it is not valid UTF-8.
+         */
+        size_t decodeUtf8 (const char *p, size_t n, char32_t &cp)
+        {
+            const Utf8Lead &lead = utf8Leads[static_cast<unsigned char> (p[0])];
+            if (lead.length == 0 || lead.length > n)
+                return (0);
+            if (lead.length == 1)
+            {
+                cp = static_cast<unsigned char> (p[0]);
+                return (1);
+            }
+
+            unsigned char second = static_cast<unsigned char> (p[1]);
+            if (second < lead.low || second > lead.high)
+                return (0);
+            cp = static_cast<unsigned char> (p[0]) & (0x7F >> lead.length);
+            for (size_t i = 1; i < lead.length; i++)
+            {
+                unsigned char c = static_cast<unsigned char> (p[i]);
+                if ((c & 0xC0) != 0x80)
+                    return (0);
+                cp = (cp << 6) | (c & 0x3F);
+            }
+
+            return (lead.length);
+        }
+
+        void appendUtf8 (string &out, char32_t cp)
+        {
+            if (cp < 0x80)
+                out.push_back (static_cast<char> (cp));
+            else if (cp < 0x800)
+            {
+                out.push_back (static_cast<char> (0xC0 | (cp >> 6)));
+                out.push_back (static_cast<char> (0x80 | (cp & 0x3F)));
+            }
+            else if (cp < 0x10000)
+            {
+                out.push_back (static_cast<char> (0xE0 | (cp >> 12)));
+                out.push_back (static_cast<char> (0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back (static_cast<char> (0x80 | (cp & 0x3F)));
+            }
+            else
+            {
+                out.push_back (static_cast<char> (0xF0 | (cp >> 18)));
+                out.push_back (static_cast<char> (0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back (static_cast<char> (0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back (static_cast<char> (0x80 | (cp & 0x3F)));
+            }
+        }
+
+        /**
+         * Length of the ASCII prefix of p, 32 bytes at a time where AVX2 is available and eight
+         * bytes at a time otherwise.
+         */
+        size_t asciiPrefixScalar (const char *p, size_t n)
+        {
+            size_t i = 0;
+            for (; i + sizeof (uint64_t) <= n; i += sizeof (uint64_t))
+            {
+                uint64_t w;
+                memcpy (&w, p + i, sizeof (w));
+                if ((w & 0x8080808080808080ULL) != 0)
+                    break;
+            }
+            while (i < n && static_cast<unsigned char> (p[i]) < 0x80)
+                i++;
+
+            return (i);
+        }
+
+#if defined (__x86_64__) && defined (__GNUC__)
+        __attribute__ ((target ("avx2")))
+        size_t asciiPrefixAvx2 (const char *p, size_t n)
+        {
+            size_t i = 0;
+            for (; i + avx2Width <= n; i += avx2Width)
+            {
+                uint32_t highBits = _mm256_movemask_epi8 (_mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p + i)));
+                if (highBits != 0)
+                    return (i + __builtin_ctz (highBits));
+            }
+
+            return (i + asciiPrefixScalar (p + i, n - i));
+        }
+#endif
+
+        size_t asciiPrefix (const char *p, size_t n)
+        {
+#if defined (__x86_64__) && defined (__GNUC__)
+            if (n >= avx2Width && hasAvx2 ())
+                return (asciiPrefixAvx2 (p, n));
+#endif
+            return (asciiPrefixScalar (p, n));
+        }
+
+        /**
+         * Simple (one to one) case mapping of the non-ASCII letters of Latin-1, Latin Extended-A,
+         * the common part of Latin Extended-B, Greek, Cyrillic, Armenian, Latin Extended
+         * Additional and the fullwidth Latin letters, as ranges sorted by first code point.
+         * DELTA ranges map c to c + delta; in PAIRS ranges upper and lower case alternate, the
+         * upper case letter on the code points of parity delta.
+         */
+        enum class CaseRule : uint8_t
+        {
+            DELTA,
+            PAIRS
+        };
+
+        struct CaseRange
+        {
+            char32_t first;
+            char32_t last;
+            CaseRule rule;
+            int32_t delta;
+        };
+
+        constexpr CaseRange toLowerRanges[] = {
+            { 0x00C0, 0x00D6, CaseRule::DELTA, 0x20 },
+            { 0x00D8, 0x00DE, CaseRule::DELTA, 0x20 },
+            { 0x0100, 0x012F, CaseRule::PAIRS, 0 },
+            { 0x0130, 0x0130, CaseRule::DELTA, 0x0069 - 0x0130 },
+            { 0x0132, 0x0137, CaseRule::PAIRS, 0 },
+            { 0x0139, 0x0148, CaseRule::PAIRS, 1 },
+            { 0x014A, 0x0177, CaseRule::PAIRS, 0 },
+            { 0x0178, 0x0178, CaseRule::DELTA, 0x00FF - 0x0178 },
+            { 0x0179, 0x017E, CaseRule::PAIRS, 1 },
+            { 0x01CD, 0x01DC, CaseRule::PAIRS, 1 },
+            { 0x01DE, 0x01EF, CaseRule::PAIRS, 0 },
+            { 0x01F4, 0x01F5, CaseRule::PAIRS, 0 },
+            { 0x01F8, 0x021F, CaseRule::PAIRS, 0 },
+            { 0x0222, 0x0233, CaseRule::PAIRS, 0 },
+            { 0x0370, 0x0373, CaseRule::PAIRS, 0 },
+            { 0x0376, 0x0377, CaseRule::PAIRS, 0 },
+            { 0x0386, 0x0386, CaseRule::DELTA, 0x26 },
+            { 0x0388, 0x038A, CaseRule::DELTA, 0x25 },
+            { 0x038C, 0x038C, CaseRule::DELTA, 0x40 },
+            { 0x038E, 0x038F, CaseRule::DELTA, 0x3F },
+            { 0x0391, 0x03A1, CaseRule::DELTA, 0x20 },
+            { 0x03A3, 0x03AB, CaseRule::DELTA, 0x20 },
+            { 0x03CF, 0x03CF, CaseRule::DELTA, 0x08 },
+            { 0x03D8, 0x03EF, CaseRule::PAIRS, 0 },
+            { 0x03F7, 0x03F8, CaseRule::PAIRS, 1 },
+            { 0x03FA, 0x03FB, CaseRule::PAIRS, 0 },
+            { 0x0400, 0x040F, CaseRule::DELTA, 0x50 },
+            { 0x0410, 0x042F, CaseRule::DELTA, 0x20 },
+            { 0x0460, 0x0481, CaseRule::PAIRS, 0 },
+            { 0x048A, 0x04BF, CaseRule::PAIRS, 0 },
+            { 0x04C0, 0x04C0, CaseRule::DELTA, 0x0F },
+            { 0x04C1, 0x04CE, CaseRule::PAIRS, 1 },
+            { 0x04D0, 0x052F, CaseRule::PAIRS, 0 },
+            { 0x0531, 0x0556, CaseRule::DELTA, 0x30 },
+            { 0x1E00, 0x1E95, CaseRule::PAIRS, 0 },
+            { 0x1E9E, 0x1E9E, CaseRule::DELTA, 0x00DF - 0x1E9E },
+            { 0x1EA0, 0x1EFF, CaseRule::PAIRS, 0 },
+            { 0xFF21, 0xFF3A, CaseRule::DELTA, 0x20 }
+        };
+
+        constexpr CaseRange toUpperRanges[] = {
+            { 0x00B5, 0x00B5, CaseRule::DELTA, 0x039C - 0x00B5 },
+            { 0x00E0, 0x00F6, CaseRule::DELTA, -0x20 },
+            { 0x00F8, 0x00FE, CaseRule::DELTA, -0x20 },
+            { 0x00FF, 0x00FF, CaseRule::DELTA, 0x0178 - 0x00FF },
+            { 0x0100, 0x012F, CaseRule::PAIRS, 0 },
+            { 0x0131, 0x0131, CaseRule::DELTA, 0x0049 - 0x0131 },
+            { 0x0132, 0x0137, CaseRule::PAIRS, 0 },
+            { 0x0139, 0x0148, CaseRule::PAIRS, 1 },
+            { 0x014A, 0x0177, CaseRule::PAIRS, 0 },
+            { 0x0179, 0x017E, CaseRule::PAIRS, 1 },
+            { 0x017F, 0x017F, CaseRule::DELTA, 0x0053 - 0x017F },
+            { 0x01CD, 0x01DC, CaseRule::PAIRS, 1 },
+            { 0x01DE, 0x01EF, CaseRule::PAIRS, 0 },
+            { 0x01F4, 0x01F5, CaseRule::PAIRS, 0 },
+            { 0x01F8, 0x021F, CaseRule::PAIRS, 0 },
+            { 0x0222, 0x0233, CaseRule::PAIRS, 0 },
+            { 0x0370, 0x0373, CaseRule::PAIRS, 0 },
+            { 0x0376, 0x0377, CaseRule::PAIRS, 0 },
+            { 0x03AC, 0x03AC, CaseRule::DELTA, -0x26 },
+            { 0x03AD, 0x03AF, CaseRule::DELTA, -0x25 },
+            { 0x03B1, 0x03C1, CaseRule::DELTA, -0x20 },
+            { 0x03C2, 0x03C2, CaseRule::DELTA, -0x1F },
+            { 0x03C3, 0x03CB, CaseRule::DELTA, -0x20 },
+            { 0x03CC, 0x03CC, CaseRule::DELTA, -0x40 },
+            { 0x03CD, 0x03CE, CaseRule::DELTA, -0x3F },
+            { 0x03D0, 0x03D0, CaseRule::DELTA, 0x0392 - 0x03D0 },
+            { 0x03D1, 0x03D1, CaseRule::DELTA, 0x0398 - 0x03D1 },
+            { 0x03D5, 0x03D5, CaseRule::DELTA, 0x03A6 - 0x03D5 },
+            { 0x03D6, 0x03D6, CaseRule::DELTA, 0x03A0 - 0x03D6 },
+            { 0x03D7, 0x03D7, CaseRule::DELTA, -0x08 },
+            { 0x03D8, 0x03EF, CaseRule::PAIRS, 0 },
+            { 0x03F0, 0x03F0, CaseRule::DELTA, 0x039A - 0x03F0 },
+            { 0x03F1, 0x03F1, CaseRule::DELTA, 0x03A1 - 0x03F1 },
+            { 0x03F5, 0x03F5, CaseRule::DELTA, 0x0395 - 0x03F5 },
+            { 0x03F7, 0x03F8, CaseRule::PAIRS, 1 },
+            { 0x03FA, 0x03FB, CaseRule::PAIRS, 0 },
+            { 0x0430, 0x044F, CaseRule::DELTA, -0x20 },
+            { 0x0450, 0x045F, CaseRule::DELTA, -0x50 },
+            { 0x0460, 0x0481, CaseRule::PAIRS, 0 },
+            { 0x048A, 0x04BF, CaseRule::PAIRS, 0 },
+            { 0x04C1, 0x04CE, CaseRule::PAIRS, 1 },
+            { 0x04CF, 0x04CF, CaseRule::DELTA, -0x0F },
+            { 0x04D0, 0x052F, CaseRule::PAIRS, 0 },
+            { 0x0561, 0x0586, CaseRule::DELTA, -0x30 },
+            { 0x1E00, 0x1E95, CaseRule::PAIRS, 0 },
+            { 0x1E9B, 0x1E9B, CaseRule::DELTA, 0x1E60 - 0x1E9B },
+            { 0x1EA0, 0x1EFF, CaseRule::PAIRS, 0 },
+            { 0xFF41, 0xFF5A, CaseRule::DELTA, -0x20 }
+        };
+
+        template<size_t N_>
+        constexpr char32_t mapCase (char32_t cp, const CaseRange (&ranges)[N_], bool toLower)
+        {
+            if (cp < 0x80)
+                return (toLower ? (cp - 'A' < 26 ? cp + 0x20 : cp) : (cp - 'a' < 26 ? cp - 0x20 : cp));
+
+            auto found = upper_bound (begin (ranges), end (ranges), cp,
+                                      [] (char32_t c, const CaseRange &r) { return (c < r.first); });
+            if (found == begin (ranges) || cp > (--found)->last)
+                return (cp);
+            if (found->rule == CaseRule::DELTA)
+                return (char32_t (int32_t (cp) + found->delta));
+
+            bool isUpper = (cp & 1) == char32_t (found->delta);
+            if (toLower && isUpper)
+                return (cp + 1);
+            if (!toLower && !isUpper)
+                return (cp - 1);
+
+            return (cp);
+        }
+
+        /**
+         * Most letters that have case are below U+0800 (two bytes in UTF-8), where the mappings
+         * are looked up directly.
+         */
+        constexpr char32_t directCaseLimit = 0x800;
+
+        enum CaseMapping
+        {
+            LOWER,
+            UPPER,
+            FOLD
+        };
+
+        constexpr auto directCaseTable (CaseMapping mapping)
+        {
+            array<char16_t, directCaseLimit> reval{};
+            for (char32_t cp = 0; cp < directCaseLimit; cp++)
+            {
+                char32_t upper = mapCase (cp, toUpperRanges, false);
+                reval[cp] = char16_t (mapping == LOWER ? mapCase (cp, toLowerRanges, true) :
+                                      mapping == UPPER ? upper : mapCase (upper, toLowerRanges, true));
+            }
+            return (reval);
+        }
+
+        constexpr array<char16_t, directCaseLimit> directLower = directCaseTable (LOWER);
+        constexpr array<char16_t, directCaseLimit> directUpper = directCaseTable (UPPER);
+        constexpr array<char16_t, directCaseLimit> directFold = directCaseTable (FOLD);
+
+        char32_t lowerCodePoint (char32_t cp)
+        {
+            return (cp < directCaseLimit ? directLower[cp] : mapCase (cp, toLowerRanges, true));
+        }
+
+        char32_t upperCodePoint (char32_t cp)
+        {
+            return (cp < directCaseLimit ? directUpper[cp] : mapCase (cp, toUpperRanges, false));
+        }
+
+        /**
+         * Simple case folding: the lower case of the upper case, so that e.g. final and medial
+         * sigma or long s and s fold to the same letter.
+         */
+        char32_t foldCodePoint (char32_t cp)
+        {
+            return (cp < directCaseLimit ? directFold[cp] :
+                    mapCase (mapCase (cp, toUpperRanges, false), toLowerRanges, true));
+        }
+
+        /**
+         * Copy ASCII runs in bulk, converted by asciiConvert, and map all other code points
+         * one by one; invalid bytes are copied unchanged.
+         */
+        template<typename Ascii_, typename Map_>
+        string convertUtf8 (string_view str, Ascii_ asciiConvert, Map_ mapCodePoint)
+        {
+            string reval;
+            reval.reserve (str.size ());
+
+            const char *p = str.data ();
+            size_t n = str.size ();
+            for (size_t i = 0; i < n;)
+            {
+                size_t ascii = asciiPrefix (p + i, n - i);
+                if (ascii > 0)
+                {
+                    size_t start = reval.size ();
+                    reval.append (p + i, ascii);
+                    asciiConvert (reval.data () + start, ascii);
+                    i += ascii;
+                    if (i == n)
+                        break;
+                }
+
+                char32_t cp = 0;
+                size_t length = decodeUtf8 (p + i, n - i, cp);
+                if (length == 0)
+                {
+                    reval.push_back (p[i]);
+                    i++;
+                }
+                else
+                {
+                    appendUtf8 (reval, mapCodePoint (cp));
+                    i += length;
+                }
+            }
+
+            return (reval);
+        }
+    };
+    // namespace
+
+    size_t findInvalidUtf8 (string_view str)
+    {
+        const char *p = str.data ();
+        size_t n = str.size ();
+        for (size_t i = 0; i < n;)
+        {
+            i += asciiPrefix (p + i, n - i);
+            if (i == n)
+                break;
+
+            char32_t cp = 0;
+            size_t length = decodeUtf8 (p + i, n - i, cp);
+            if (length == 0)
+                return (i);
+            i += length;
+        }
+
+        return (string_view::npos);
+    }
+
+    string utf8ToLower (string_view str)
+    {
+        return (convertUtf8 (str, asciiToLower, lowerCodePoint));
+    }
+
+    string utf8ToUpper (string_view str)
+    {
+        return (convertUtf8 (str, asciiToUpper, upperCodePoint));
+    }
+
+    string utf8FoldCase (string_view str)
+    {
+        return (convertUtf8 (str, asciiToLower, foldCodePoint));
+    }
+
+    bool utf8EqualsIgnoreCase (string_view lhs, string_view rhs)
+    {
+        constexpr uint64_t highs = 0x8080808080808080ULL;
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < lhs.size () && j < rhs.size ())
+        {
+            // eight ASCII bytes on both sides at once
+            if (i + sizeof (uint64_t) <= lhs.size () && j + sizeof (uint64_t) <= rhs.size ())
+            {
+                uint64_t l;
+                uint64_t r;
+                memcpy (&l, lhs.data () + i, sizeof (l));
+                memcpy (&r, rhs.data () + j, sizeof (r));
+                if (((l | r) & highs) == 0)
+                {
+                    if (ciFoldWord (l) != ciFoldWord (r))
+                        return (false);
+                    i += sizeof (uint64_t);
+                    j += sizeof (uint64_t);
+                    continue;
+                }
+            }
+
+            char32_t l = 0;
+            char32_t r = 0;
+            size_t lLength = decodeUtf8 (lhs.data () + i, lhs.size () - i, l);
+            size_t rLength = decodeUtf8 (rhs.data () + j, rhs.size () - j, r);
+            if (lLength == 0 || rLength == 0)
+            {
+                // invalid bytes only equal themselves
+                if (lLength != rLength || lhs[i] != rhs[j])
+                    return (false);
+                lLength = rLength = 1;
+            }
+            else if (foldCodePoint (l) != foldCodePoint (r))
+                return (false);
+            i += lLength;
+            j += rLength;
+        }
+
+        return (i == lhs.size () && j == rhs.size ());
+    }
+
     /**
      * removes all occurrences of stripChars in a string
      * strip "__<a_><bc>__" of trimChars="_<>" would result in abc
@@ -135,31 +1241,27 @@ namespace util
 
             bool doStripFront = ((m & StripTrimMode::FRONT) == StripTrimMode::FRONT);
             bool doStripBack = ((m & StripTrimMode::BACK) == StripTrimMode::BACK);
+            bool doInside = ((m & StripTrimMode::INSIDE) == StripTrimMode::INSIDE);
 
-            using TT = T_;
-            TT reval = "";
-            typename TT::size_type start = doStripFront ? v.find_first_not_of (stripChars) : 0;
-            typename TT::size_type finish = doStripBack ? v.find_last_not_of (stripChars) + 1 : v.size ();
+            CharClass cls (stripChars);
+            char *data = v.data ();
+            size_t start = doStripFront ? findFirstNotIn (data, v.size (), cls) : 0;
 
-            if (start == TT::npos)
+            if (start == T_::npos)
             {
-                v = "";
+                v.clear ();
                 return;
             }
 
-            bool doInside = ((m & StripTrimMode::INSIDE) == StripTrimMode::INSIDE);
-
-            while (start < finish)
-            {
-                if (!doInside)  // if we did not specify to strip inside-matches
-                    reval.append (&v[start], 1);
-                else if (stripChars.find (v[start]) == TT::npos)
-                    reval.append (&v[start], 1);
+            // npos + 1 == 0: nothing left if only stripping the back of an all-strip-chars string
+            size_t finish = doStripBack ? findLastNotIn (data, v.size (), cls) + 1 : v.size ();
+            size_t len = start < finish ? finish - start : 0;
 
-                start++;
-            }
-
-            v = reval;
+            if (start > 0 && len > 0)
+                memmove (data, data + start, len);
+            if (doInside)
+                len = removeIn (data, len, cls);
+            v.resize (len);
         }
 
     void strip (string &v, const string &stripChars, StripTrimMode m)
@@ -203,47 +1305,24 @@ namespace util
             if (v.empty ())
                 return;
 
-            if (v.find_first_not_of (replChars) == T_::npos)
-            {
-                v = T_ (v.size (), repl);
-                return;
-            }
-
-            size_t firstNonReplChar = 0;
-
-            while (firstNonReplChar < v.size () && replChars.find (v[firstNonReplChar]) != T_::npos)
-            {
-                if ((m & StripTrimMode::FRONT) == StripTrimMode::FRONT)
-                {
-                    v[firstNonReplChar] = repl;
-                }
-
-                firstNonReplChar++;
-            }
-
-            size_t lastNonReplChar = v.size () - 1;
+            CharClass cls (replChars);
+            char *data = v.data ();
+            size_t first = findFirstNotIn (data, v.size (), cls);
 
-            while (replChars.find (v[lastNonReplChar]) != T_::npos)
+            if (first == T_::npos)
             {
-                if ((m & StripTrimMode::BACK) == StripTrimMode::BACK)
-                {
-                    v[lastNonReplChar] = repl;
-                }
-                lastNonReplChar--;
+                memset (data, repl, v.size ());
+                return;
             }
 
-            size_t insideNonReplChar = firstNonReplChar;
-
-            while (insideNonReplChar < lastNonReplChar + 1)
-            {
-                if ((m & StripTrimMode::INSIDE) == StripTrimMode::INSIDE)
-                {
-                    if (replChars.find (v[insideNonReplChar]) != T_::npos)
-                        v[insideNonReplChar] = repl;
-                }
+            size_t last = findLastNotIn (data, v.size (), cls);
 
-                insideNonReplChar++;
-            }
+            if ((m & StripTrimMode::FRONT) == StripTrimMode::FRONT)
+                replaceIn (data, first, cls, repl);
+            if ((m & StripTrimMode::BACK) == StripTrimMode::BACK)
+                replaceIn (data + last + 1, v.size () - last - 1, cls, repl);
+            if ((m & StripTrimMode::INSIDE) == StripTrimMode::INSIDE)
+                replaceIn (data + first, last - first + 1, cls, repl);
         }
 
     void replaceChar (string &v, const string &replChars, char repl, StripTrimMode m)
@@ -414,6 +1493,154 @@ namespace util
         return (splitIntoSetT (str, sep));
     }
 
+    aho_corasick::aho_corasick (const vector<string> &patterns, bool caseInsensitive)
+    : caseInsensitive_ (caseInsensitive)
+    {
+        constexpr uint32_t noState = numeric_limits<uint32_t>::max ();
+
+        // compact alphabet: the (folded) bytes that occur in patterns, in order of appearance
+        uint16_t alphabetSize = 0;
+        auto fold = [caseInsensitive] (char c)
+        {
+            return (caseInsensitive ? ciFold (c) : static_cast<unsigned char> (c));
+        };
+        for (const auto &pattern : patterns)
+        {
+            if (pattern.empty ())
+                throw invalid_argument ("aho_corasick: empty pattern");
+            for (char c : pattern)
+            {
+                if (codes_[fold (c)] == 0)
+                    codes_[fold (c)] = ++alphabetSize;
+            }
+        }
+        if (caseInsensitive)
+        {
+            for (unsigned c = 0; c < codes_.size (); c++)
+                codes_[c] = codes_[ciFold (char (c))];
+        }
+
+        // plain trie first, with sorted children so that the double-array can be packed
+        vector<map<uint16_t, uint32_t>> trie (1);
+        vector<vector<uint32_t>> terminal (1);
+        for (size_t p = 0; p < patterns.size (); p++)
+        {
+            uint32_t node = 0;
+            for (char c : patterns[p])
+            {
+                auto found = trie[node].find (codes_[static_cast<unsigned char> (c)]);
+                if (found == trie[node].end ())
+                {
+                    found = trie[node].emplace (codes_[static_cast<unsigned char> (c)], uint32_t (trie.size ())).first;
+                    trie.emplace_back ();
+                    terminal.emplace_back ();
+                }
+                node = found->second;
+            }
+            terminal[node].push_back (uint32_t (p));
+            lengths_.push_back (patterns[p].size ());
+        }
+
+        // pack the trie into the double-array in breadth-first order, each node's children at the
+        // first base where all their slots are free
+        vector<uint32_t> stateOf (trie.size (), 0);
+        vector<uint32_t> order (1, 0);
+        slots_.assign (1, slot ());
+        slots_[0].check = 0;
+        size_t firstFree = 1;
+        for (size_t i = 0; i < order.size (); i++)
+        {
+            uint32_t node = order[i];
+            if (trie[node].empty ())
+                continue;
+
+            while (firstFree < slots_.size () && slots_[firstFree].check != noState)
+                firstFree++;
+            uint16_t firstCode = trie[node].begin ()->first;
+            uint32_t base = uint32_t (max (firstFree, size_t (firstCode + 1)) - firstCode);
+            for (;; base++)
+            {
+                bool fits = true;
+                for (const auto &child : trie[node])
+                    fits &= (base + child.first >= slots_.size () || slots_[base + child.first].check == noState);
+                if (fits)
+                    break;
+            }
+            slots_[stateOf[node]].base = base;
+            for (const auto &child : trie[node])
+            {
+                uint32_t t = base + child.first;
+                if (t >= slots_.size ())
+                    slots_.resize (t + 1);
+                slots_[t].check = stateOf[node];
+                stateOf[child.second] = t;
+                order.push_back (child.second);
+            }
+        }
+        // base + code of any state, including leaves with base 0, must stay inside the array
+        uint32_t maxBase = 0;
+        for (const auto &cell : slots_)
+            maxBase = max (maxBase, cell.base);
+        slots_.resize (size_t (maxBase) + alphabetSize + 1);
+
+        // failure links and outputs, again breadth-first so that the failure target of a state
+        // (which is shallower) is complete before the state itself; own patterns come first as
+        // they are the longest ending here
+        vector<vector<uint32_t>> outputs (slots_.size ());
+        outputs_.assign (1, endOfOutputs);
+        for (uint32_t node : order)
+        {
+            uint32_t state = stateOf[node];
+            outputs[state] = terminal[node];
+            if (state != 0)
+                outputs[state].insert (outputs[state].end (),
+                                       outputs[slots_[state].fail].begin (),
+                                       outputs[slots_[state].fail].end ());
+            if (!outputs[state].empty ())
+            {
+                slots_[state].outBegin = uint32_t (outputs_.size ());
+                outputs_.insert (outputs_.end (), outputs[state].begin (), outputs[state].end ());
+                outputs_.push_back (endOfOutputs);
+            }
+            for (const auto &child : trie[node])
+            {
+                uint32_t t = stateOf[child.second];
+                for (uint32_t f = slots_[state].fail; state != 0; f = slots_[f].fail)
+                {
+                    uint32_t candidate = slots_[f].base + child.first;
+                    if (slots_[candidate].check == f)
+                    {
+                        slots_[t].fail = candidate;
+                        break;
+                    }
+                    if (f == 0)
+                        break;
+                }
+            }
+        }
+    }
+
+    vector<substring_match> aho_corasick::findAll (string_view text) const
+    {
+        vector<substring_match> reval;
+        forEachMatch (text, [&reval] (const substring_match &match) { reval.push_back (match); });
+
+        return (reval);
+    }
+
+    bool aho_corasick::containsAny (string_view text) const
+    {
+        uint32_t state = 0;
+        for (char c : text)
+        {
+            state = next (state, static_cast<unsigned char> (c));
+            if (slots_[state].outBegin != 0)
+                return (true);
+        }
+
+        return (false);
+    }
+
 }
 ;
 // namespace util
@@ -0,0 +1,534 @@
+/*
+ * File:        tinytea.cc
+ * Description: TEA and XTEA in counter mode over buffers.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <bit>
+#include <bit_converter.h>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread_pool.h>
+#include <tinytea.h>
+
+namespace util
+{
+using namespace std;
+
+namespace
+{
+    constexpr uint32_t teaDelta = 0x9E3779B9;
+
+    /**
+     * Counter blocks encrypted per call of the kernel in counter mode.
+     */
+    constexpr size_t counterBlocks = 64;
+
+    /**
+     * Buffers of at least this many bytes are split across the shared thread_pool.
+     */
+    constexpr size_t parallelBytes = 1 << 20;
+
+    using u32x4 = uint32_t __attribute__((vector_size(16)));
+    using u32x8 = uint32_t __attribute__((vector_size(32)));
+
+    /**
+     * En- or decrypt Groups_ * lanes blocks (lanes = 32-bit elements of V_) at once: the
+     * blocks are split into vectors of their low (v0) and high (v1) halves, every round
+     * works on all lanes, and the Groups_ vectors are independent of each other so that
+     * their instructions overlap. Compiled into the callers with their instruction set.
+     */
+    template<typename V_, size_t Groups_>
+    inline __attribute__((always_inline)) void cryptLanes(const uint32_t   key[4],
+                                                          TeaVariant       variant,
+                                                          bool             decrypting,
+                                                          const uint64_t  *in,
+                                                          uint64_t        *out)
+    {
+        constexpr size_t lanes = sizeof(V_) / sizeof(uint32_t);
+
+        // element-wise instead of with a compiler-specific shuffle builtin (the optimiser emits
+        // the shuffles), and independent of the byte order as the halves are taken by value
+        V_ v0[Groups_];
+        V_ v1[Groups_];
+        for(size_t g = 0; g < Groups_; g++)
+        {
+            for(size_t l = 0; l < lanes; l++)
+            {
+                v0[g][l] = uint32_t(in[g * lanes + l]);
+                v1[g][l] = uint32_t(in[g * lanes + l] >> 32);
+            }
+        }
+
+        if(variant == TeaVariant::TEA && !decrypting)
+        {
+            uint32_t sum = 0U;
+            for(unsigned i = 0; i < 32; i++)
+            {
+                sum += teaDelta;
+                for(size_t g = 0; g < Groups_; g++)
+                    v0[g] += ((v1[g] << 4) + key[0]) ^ (v1[g] + sum) ^ ((v1[g] >> 5) + key[1]);
+                for(size_t g = 0; g < Groups_; g++)
+                    v1[g] += ((v0[g] << 4) + key[2]) ^ (v0[g] + sum) ^ ((v0[g] >> 5) + key[3]);
+            }
+        }
+        else if(variant == TeaVariant::TEA)
+        {
+            uint32_t sum = teaDelta << 5;
+            for(unsigned i = 0; i < 32; i++)
+            {
+                for(size_t g = 0; g < Groups_; g++)
+                    v1[g] -= ((v0[g] << 4) + key[2]) ^ (v0[g] + sum) ^ ((v0[g] >> 5) + key[3]);
+                for(size_t g = 0; g < Groups_; g++)
+                    v0[g] -= ((v1[g] << 4) + key[0]) ^ (v1[g] + sum) ^ ((v1[g] >> 5) + key[1]);
+                sum -= teaDelta;
+            }
+        }
+        else if(!decrypting)
+        {
+            uint32_t sum = 0U;
+            for(unsigned i = 0; i < 32; i++)
+            {
+                uint32_t roundKey = sum + key[sum & 3];
+                for(size_t g = 0; g < Groups_; g++)
+                    v0[g] += (((v1[g] << 4) ^ (v1[g] >> 5)) + v1[g]) ^ roundKey;
+                sum += teaDelta;
+                roundKey = sum + key[(sum >> 11) & 3];
+                for(size_t g = 0; g < Groups_; g++)
+                    v1[g] += (((v0[g] << 4) ^ (v0[g] >> 5)) + v0[g]) ^ roundKey;
+            }
+        }
+        else
+        {
+            uint32_t sum = teaDelta << 5;
+            for(unsigned i = 0; i < 32; i++)
+            {
+                uint32_t roundKey = sum + key[(sum >> 11) & 3];
+                for(size_t g = 0; g < Groups_; g++)
+                    v1[g] -= (((v0[g] << 4) ^ (v0[g] >> 5)) + v0[g]) ^ roundKey;
+                sum -= teaDelta;
+                roundKey = sum + key[sum & 3];
+                for(size_t g = 0; g < Groups_; g++)
+                    v0[g] -= (((v1[g] << 4) ^ (v1[g] >> 5)) + v1[g]) ^ roundKey;
+            }
+        }
+
+        for(size_t g = 0; g < Groups_; g++)
+            for(size_t l = 0; l < lanes; l++)
+                out[g * lanes + l] = uint64_t(v1[g][l]) << 32 | v0[g][l];
+    }
+
+    /**
+     * Kernels: each processes as many blocks of in as fit its stride and returns their number.
+     */
+    size_t cryptScalar(const uint32_t key[4], TeaVariant variant, bool decrypting, const uint64_t *in, uint64_t *out, size_t n)
+    {
+        uint64_t key1 = uint64_t(key[1]) << 32 | key[0];
+        uint64_t key2 = uint64_t(key[3]) << 32 | key[2];
+        for(size_t i = 0; i < n; i++)
+        {
+            if(variant == TeaVariant::TEA)
+                out[i] = decrypting ? tinyTea<teaDelta>::decrypt(in[i], key1, key2) :
+                                      tinyTea<teaDelta>::encrypt(in[i], key1, key2);
+            else
+                out[i] = decrypting ? tinyXtea<teaDelta>::decrypt(in[i], key1, key2) :
+                                      tinyXtea<teaDelta>::encrypt(in[i], key1, key2);
+        }
+
+        return (n);
+    }
+
+    size_t cryptSse2(const uint32_t key[4], TeaVariant variant, bool decrypting, const uint64_t *in, uint64_t *out, size_t n)
+    {
+        constexpr size_t stride = 4 * 4;
+
+        size_t i = 0;
+        for(; i + stride <= n; i += stride)
+            cryptLanes<u32x4, 4>(key, variant, decrypting, in + i, out + i);
+
+        return (i);
+    }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    __attribute__((target("avx2"))) size_t
+     cryptAvx2(const uint32_t key[4], TeaVariant variant, bool decrypting, const uint64_t *in, uint64_t *out, size_t n)
+    {
+        constexpr size_t stride = 2 * 8;
+
+        size_t i = 0;
+        for(; i + stride <= n; i += stride)
+            cryptLanes<u32x8, 2>(key, variant, decrypting, in + i, out + i);
+
+        return (i);
+    }
+#endif
+
+    void cryptBlocks(const uint32_t   key[4],
+                     TeaVariant       variant,
+                     bool             decrypting,
+                     const uint64_t  *in,
+                     uint64_t        *out,
+                     size_t           n,
+                     TeaKernel        kernel)
+    {
+        size_t done = 0;
+#if defined(__x86_64__) && defined(__GNUC__)
+        if(kernel == TeaKernel::AVX2)
+            done = cryptAvx2(key, variant, decrypting, in, out, n);
+#endif
+        if(kernel != TeaKernel::SCALAR)
+            done += cryptSse2(key, variant, decrypting, in + done, out + done, n - done);
+        cryptScalar(key, variant, decrypting, in + done, out + done, n - done);
+    }
+
+    void cryptBlocks(uint64_t     key1,
+                     uint64_t     key2,
+                     TeaVariant   variant,
+                     bool         decrypting,
+                     span<uint64_t> blocks,
+                     TeaKernel    kernel)
+    {
+        if(!teaKernelSupported(kernel))
+            throw invalid_argument("teaEncryptBlocks()/teaDecryptBlocks(): kernel not supported by this processor");
+
+        const uint32_t key[4] = {uint32_t(key1), uint32_t(key1 >> 32), uint32_t(key2), uint32_t(key2 >> 32)};
+        cryptBlocks(key, variant, decrypting, blocks.data(), blocks.data(), blocks.size(), kernel);
+    }
+};
+// namespace
+
+bool teaKernelSupported(TeaKernel kernel)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    if(kernel == TeaKernel::AVX2)
+        return (hasAvx2());
+#else
+    if(kernel == TeaKernel::AVX2)
+        return (false);
+#endif
+
+    return (true);
+}
+
+TeaKernel bestTeaKernel()
+{
+    return (teaKernelSupported(TeaKernel::AVX2) ? TeaKernel::AVX2 : TeaKernel::SSE2);
+}
+
+void teaEncryptBlocks(span<uint64_t> blocks, uint64_t key1, uint64_t key2, TeaVariant variant, TeaKernel kernel)
+{
+    cryptBlocks(key1, key2, variant, false, blocks, kernel);
+}
+
+void teaDecryptBlocks(span<uint64_t> blocks, uint64_t key1, uint64_t key2, TeaVariant variant, TeaKernel kernel)
+{
+    cryptBlocks(key1, key2, variant, true, blocks, kernel);
+}
+
+void tea_ctr::keyStream(uint64_t firstBlock, span<uint64_t> out) const
+{
+    for(size_t i = 0; i < out.size(); i++)
+        out[i] = nonce_ + firstBlock + i;
+    cryptBlocks(key_, variant_, false, out.data(), out.data(), out.size(), kernel_);
+}
+
+void tea_ctr::applyRange(const byte *in, byte *out, size_t size, uint64_t streamOffset) const
+{
+    constexpr size_t windowBytes = counterBlocks * sizeof(uint64_t);
+
+    uint64_t block = streamOffset / sizeof(uint64_t);
+    size_t   skip  = streamOffset % sizeof(uint64_t);
+    for(size_t done = 0; done < size; block += counterBlocks, skip = 0)
+    {
+        size_t   n      = min(size - done, windowBytes - skip);
+        size_t   filled = (skip + n + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        uint64_t keys[counterBlocks];
+        keyStream(block, span<uint64_t>(keys, filled));
+        if constexpr(endian::native == endian::big)
+        {
+            for(size_t k = 0; k < filled; k++)
+                keys[k] = byteSwap(keys[k]);
+        }
+
+        if(n == windowBytes)
+        {
+            uint64_t words[counterBlocks];
+            memcpy(words, in + done, windowBytes);
+            for(size_t l = 0; l < counterBlocks; l++)
+                words[l] ^= keys[l];
+            memcpy(out + done, words, windowBytes);
+        }
+        else
+        {
+            const auto *keyBytes = reinterpret_cast<const byte *>(keys) + skip;
+            for(size_t i = 0; i < n; i++)
+                out[done + i] = in[done + i] ^ keyBytes[i];
+        }
+        done += n;
+    }
+}
+
+void tea_ctr::apply(span<byte> data, uint64_t streamOffset) const
+{
+    apply(data, data, streamOffset);
+}
+
+void tea_ctr::applySequential(span<byte> data, uint64_t streamOffset) const
+{
+    applyRange(data.data(), data.data(), data.size(), streamOffset);
+}
+
+void tea_ctr::apply(span<const byte> in, span<byte> out, uint64_t streamOffset) const
+{
+    if(in.size() != out.size())
+        throw invalid_argument("tea_ctr::apply(): input of " + to_string(in.size()) + " bytes but output of " +
+                               to_string(out.size()) + " bytes");
+
+    if(in.size() < parallelBytes)
+    {
+        applyRange(in.data(), out.data(), in.size(), streamOffset);
+        return;
+    }
+
+    thread_pool::shared().parallelFor(in.size(),
+                                      parallelBytes / 4,
+                                      [&](size_t begin, size_t end)
+                                      {
+                                          applyRange(in.data() + begin,
+                                                     out.data() + begin,
+                                                     end - begin,
+                                                     streamOffset + begin);
+                                      });
+}
+
+namespace
+{
+    constexpr char    fileMagic[4] = {'U', 'T', 'E', 'A'};
+    constexpr uint8_t fileVersion  = 1;
+
+    struct file_header
+    {
+        TeaVariant variant;
+        uint32_t   chunkSize;
+        uint64_t   nonce;
+    };
+
+    void putLittleEndian(byte *at, uint64_t value, size_t bytes)
+    {
+        for(size_t i = 0; i < bytes; i++)
+            at[i] = byte(value >> (8 * i));
+    }
+
+    uint64_t getLittleEndian(const byte *at, size_t bytes)
+    {
+        uint64_t reval = 0ULL;
+        for(size_t i = 0; i < bytes; i++)
+            reval |= uint64_t(at[i]) << (8 * i);
+
+        return (reval);
+    }
+
+    void writeHeader(ostream &out, const file_header &header)
+    {
+        byte buffer[tea_file_cipher::headerSize] = {};
+        memcpy(buffer, fileMagic, sizeof(fileMagic));
+        buffer[4] = byte(fileVersion);
+        buffer[5] = byte(header.variant);
+        putLittleEndian(buffer + 8, header.chunkSize, 4);
+        putLittleEndian(buffer + 12, header.nonce, 8);
+        out.write(reinterpret_cast<const char *>(buffer), sizeof(buffer));
+        if(!out)
+            throw runtime_error("tea_file_cipher: cannot write the header");
+    }
+
+    file_header readHeader(istream &in)
+    {
+        byte buffer[tea_file_cipher::headerSize];
+        in.read(reinterpret_cast<char *>(buffer), sizeof(buffer));
+        if(size_t(in.gcount()) != sizeof(buffer) || memcmp(buffer, fileMagic, sizeof(fileMagic)) != 0)
+            throw runtime_error("tea_file_cipher: input is not encrypted by tea_file_cipher");
+        if(uint8_t(buffer[4]) != fileVersion)
+            throw runtime_error("tea_file_cipher: unsupported format version " + to_string(uint8_t(buffer[4])));
+        if(uint8_t(buffer[5]) > uint8_t(TeaVariant::XTEA))
+            throw runtime_error("tea_file_cipher: unknown TEA variant " + to_string(uint8_t(buffer[5])));
+
+        file_header reval{TeaVariant(buffer[5]),
+                          uint32_t(getLittleEndian(buffer + 8, 4)),
+                          getLittleEndian(buffer + 12, 8)};
+        if(reval.chunkSize == 0)
+            throw runtime_error("tea_file_cipher: invalid chunk size 0");
+
+        return (reval);
+    }
+
+    /**
+     * Read chunks of in into a bounded set of buffers, en-/decrypt them as tasks of the shared
+     * thread_pool and write them to out in order, oldest first, as soon as they are done. While
+     * the oldest chunk is written the workers process the younger ones. Called from a worker of
+     * that pool, which must not wait for other tasks, each chunk is processed on the calling
+     * thread when it is written.
+     */
+    uint64_t cryptStream(istream &in, ostream &out, const tea_ctr &cipher, size_t chunkSize)
+    {
+        struct chunk
+        {
+            vector<byte> data;
+            size_t       size;
+            future<void> done;
+        };
+
+        thread_pool         &pool     = thread_pool::shared();
+        const bool           onWorker = pool.inWorker();
+        const size_t         inFlight = onWorker ? 1 : 2 * pool.size() + 1;
+        deque<chunk>         pending;
+        vector<vector<byte>> spare;
+        uint64_t             offset = 0ULL;
+
+        auto writeOldest = [&]
+        {
+            chunk &oldest = pending.front();
+            oldest.done.get();
+            out.write(reinterpret_cast<const char *>(oldest.data.data()), oldest.size);
+            if(!out)
+                throw runtime_error("tea_file_cipher: cannot write the output");
+            spare.push_back(std::move(oldest.data));
+            pending.pop_front();
+        };
+
+        try
+        {
+            for(bool more = true; more;)
+            {
+                if(pending.size() >= inFlight)
+                    writeOldest();
+
+                vector<byte> buffer;
+                if(spare.empty())
+                {
+                    buffer.resize(chunkSize);
+                }
+                else
+                {
+                    buffer = std::move(spare.back());
+                    spare.pop_back();
+                }
+
+                in.read(reinterpret_cast<char *>(buffer.data()), chunkSize);
+                size_t got = in.gcount();
+                more       = got == chunkSize;
+                if(in.bad())
+                    throw runtime_error("tea_file_cipher: cannot read the input");
+                if(got == 0)
+                    break;
+
+                // the heap block of buffer stays put when the vector is moved into the queue
+                span<byte>   data(buffer.data(), got);
+                auto         task = [&cipher, data, offset] { cipher.applySequential(data, offset); };
+                future<void> done = onWorker ? async(launch::deferred, task) : pool.submit(task);
+                pending.push_back(chunk{std::move(buffer), got, std::move(done)});
+                offset += got;
+            }
+
+            while(!pending.empty())
+                writeOldest();
+        }
+        catch(...)
+        {
+            // the tasks still use the buffers
+            for(auto &c: pending)
+                if(c.done.valid())
+                    c.done.wait();
+            throw;
+        }
+
+        out.flush();
+
+        return (offset);
+    }
+
+    void openFiles(const string &inPath, const string &outPath, ifstream &in, ofstream &out)
+    {
+        in.open(inPath, ios::binary);
+        if(!in)
+            throw runtime_error("tea_file_cipher: cannot open '" + inPath + "' for reading");
+        out.open(outPath, ios::binary | ios::trunc);
+        if(!out)
+            throw runtime_error("tea_file_cipher: cannot open '" + outPath + "' for writing");
+    }
+};
+// namespace
+
+tea_file_cipher::tea_file_cipher(uint64_t key1, uint64_t key2, TeaVariant variant, size_t chunkSize)
+: key1_(key1)
+, key2_(key2)
+, variant_(variant)
+, chunkSize_(chunkSize)
+{
+    if(chunkSize == 0 || chunkSize > numeric_limits<uint32_t>::max())
+        throw invalid_argument("tea_file_cipher: chunk size " + to_string(chunkSize) + " is not in 1..2^32-1");
+}
+
+uint64_t tea_file_cipher::encryptStream(istream &in, ostream &out, uint64_t nonce) const
+{
+    writeHeader(out, file_header{variant_, uint32_t(chunkSize_), nonce});
+
+    return (cryptStream(in, out, tea_ctr(key1_, key2_, nonce, variant_), chunkSize_));
+}
+
+uint64_t tea_file_cipher::decryptStream(istream &in, ostream &out) const
+{
+    file_header header = readHeader(in);
+
+    // counter mode does not depend on the chunks, and the size in the header is not trusted for
+    // allocating buffers
+    return (cryptStream(in, out, tea_ctr(key1_, key2_, header.nonce, header.variant), chunkSize_));
+}
+
+uint64_t tea_file_cipher::encryptFile(const string &inPath, const string &outPath) const
+{
+    ifstream in;
+    ofstream out;
+    openFiles(inPath, outPath, in, out);
+
+    random_device entropy;
+    uint64_t      nonce = uint64_t(entropy()) << 32 | entropy();
+
+    return (encryptStream(in, out, nonce));
+}
+
+uint64_t tea_file_cipher::decryptFile(const string &inPath, const string &outPath) const
+{
+    ifstream in;
+    ofstream out;
+    openFiles(inPath, outPath, in, out);
+
+    return (decryptStream(in, out));
+}
+};
+// namespace util
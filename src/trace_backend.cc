@@ -0,0 +1,598 @@
+/*
+ * File:        trace_backend.cc
+ * Description: Asynchronous tracing into per-thread ring buffers.
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <stdexcept>
+#include <thread>
+#include <trace_backend.h>
+#include <vector>
+
+namespace util
+{
+using namespace std;
+
+namespace trace_detail
+{
+    atomic<uint8_t> threshold{uint8_t(TraceLevel::TRACE_DEBUG)};
+};
+// namespace trace_detail
+
+namespace
+{
+    /**
+     * Single-producer single-consumer byte ring of one thread; head and tail count bytes ever
+     * written and read.
+     */
+    struct trace_ring
+    {
+        trace_ring(size_t bytes, uint32_t id) : buffer(bytes), mask(bytes - 1), thread(id)
+        {
+        }
+
+        bool push(string_view record)
+        {
+            uint64_t h = head.load(memory_order_relaxed);
+            if(record.size() > buffer.size() - (h - tail.load(memory_order_acquire)))
+            {
+                dropped.store(dropped.load(memory_order_relaxed) + 1, memory_order_relaxed);
+                return (false);
+            }
+
+            size_t at    = h & mask;
+            size_t first = min(record.size(), buffer.size() - at);
+            memcpy(buffer.data() + at, record.data(), first);
+            memcpy(buffer.data(), record.data() + first, record.size() - first);
+            head.store(h + record.size(), memory_order_release);
+
+            return (true);
+        }
+
+        void copyOut(uint64_t position, char *out, size_t size) const
+        {
+            size_t at    = position & mask;
+            size_t first = min(size, buffer.size() - at);
+            memcpy(out, buffer.data() + at, first);
+            memcpy(out + first, buffer.data(), size - first);
+        }
+
+        vector<char>     buffer;
+        size_t           mask;
+        uint32_t         thread;
+        atomic<uint64_t> head{0};
+        atomic<uint64_t> tail{0};
+        atomic<uint64_t> dropped{0};
+        atomic<bool>     finished{false};
+        uint64_t         reportedDrops = 0;  ///< drainer only
+    };
+
+    /**
+     * Formatted once, when the site is registered.
+     */
+    struct trace_site
+    {
+        string         prefix;  ///< "LEVEL file:line function"
+        vector<string> labels;  ///< " name=" per argument
+    };
+
+    /**
+     * Text of a record in the arena of the drain cycle.
+     */
+    struct decoded_record
+    {
+        uint64_t ticks;
+        size_t   begin;
+        size_t   end;
+    };
+
+    template<typename T_, typename... Format_>
+    void appendNumber(string &text, T_ value, Format_... format)
+    {
+        char digits[64];
+        auto result = to_chars(digits, digits + sizeof(digits), value, format...);
+        text.append(digits, result.ptr);
+    }
+
+    const char *levelName(TraceLevel level)
+    {
+        switch(level)
+        {
+            case TraceLevel::TRACE_DEBUG:
+                return ("DEBUG");
+            case TraceLevel::TRACE_INFO:
+                return ("INFO");
+            case TraceLevel::TRACE_WARNING:
+                return ("WARNING");
+            case TraceLevel::TRACE_ERROR:
+                return ("ERROR");
+            default:
+                return ("OFF");
+        }
+    }
+
+    /**
+     * Split "a, f(b, c), d" into its top-level parts.
+     */
+    vector<string> splitNames(const string &names)
+    {
+        vector<string> reval;
+        string         current;
+        int            depth  = 0;
+        char           quoted = 0;
+        for(char c: names)
+        {
+            if(quoted != 0)
+            {
+                if(c == quoted)
+                    quoted = 0;
+            }
+            else if(c == '"' || c == '\'')
+            {
+                quoted = c;
+            }
+            else if(c == '(' || c == '[' || c == '{')
+            {
+                depth++;
+            }
+            else if(c == ')' || c == ']' || c == '}')
+            {
+                depth--;
+            }
+            else if(c == ',' && depth == 0)
+            {
+                reval.push_back(current);
+                current.clear();
+                continue;
+            }
+            if(c != ' ' || !current.empty())
+                current += c;
+        }
+        if(!current.empty() || !reval.empty())
+            reval.push_back(current);
+
+        return (reval);
+    }
+
+    class trace_backend
+    {
+        public:
+        trace_backend()
+        {
+            pthread_atfork([] { instance().lock_.lock(); },
+                           [] { instance().lock_.unlock(); },
+                           [] { instance().afterFork(); });
+        }
+
+        ~trace_backend()
+        {
+            shuttingDown_ = true;
+            stop();
+        }
+
+        static trace_backend &instance()
+        {
+            static trace_backend reval;
+
+            return (reval);
+        }
+
+        void start(const string &path, size_t bytesPerThread)
+        {
+            // stop, reconfigure and launch without letting a tracing thread launch in between
+            unique_lock<mutex> guard(lock_);
+            stopLocked(guard);
+            if(path.empty())
+            {
+                file_.reset();
+                out_ = &cout;
+            }
+            else
+            {
+                auto file = make_unique<ofstream>(path, ios::out | ios::trunc);
+                if(!*file)
+                    throw runtime_error("startTracing(): cannot open '" + path + "' for writing");
+                file_ = std::move(file);
+                out_  = file_.get();
+            }
+            ringBytes_ = bit_ceil(max(bytesPerThread, 4 * trace_detail::record_builder::maxBytes));
+            launch();
+        }
+
+        void startIfIdle()
+        {
+            lock_guard<mutex> guard(lock_);
+            if(!running_.load(memory_order_relaxed) && !shuttingDown_)
+                launch();
+        }
+
+        bool running() const
+        {
+            return (running_.load(memory_order_relaxed));
+        }
+
+        void stop()
+        {
+            unique_lock<mutex> guard(lock_);
+            stopLocked(guard);
+        }
+
+        void flush()
+        {
+            unique_lock<mutex> guard(lock_);
+            if(drainer_ == nullptr)
+                return;
+            uint64_t target = cycles_ + 1;
+            flushRequested_ = true;
+            wakeUp_.notify_all();
+            drained_.wait(guard, [&] { return (cycles_ >= target || drainer_ == nullptr); });
+        }
+
+        uint32_t addSite(const char *file, int line, const char *function, const char *names, TraceLevel level)
+        {
+            lock_guard<mutex> guard(lock_);
+            trace_site site;
+            site.prefix = string(levelName(level)) + " " + file + ":" + to_string(line) + " " + function;
+            for(const auto &name: splitNames(names))
+                site.labels.push_back(name.empty() ? " " : " " + name + "=");
+            sites_.push_back(std::move(site));
+
+            return (uint32_t(sites_.size() - 1));
+        }
+
+        shared_ptr<trace_ring> addThread()
+        {
+            lock_guard<mutex> guard(lock_);
+            rings_.push_back(make_shared<trace_ring>(ringBytes_, nextThread_++));
+
+            return (rings_.back());
+        }
+
+        uint64_t dropped()
+        {
+            lock_guard<mutex> guard(lock_);
+            uint64_t          reval = retiredDrops_;
+            for(const auto &r: rings_)
+                reval += r->dropped.load(memory_order_relaxed);
+
+            return (reval);
+        }
+
+        private:
+        /**
+         * Stop the drainer, if any, and wait until it is gone; the lock is held on entry and on
+         * return but released while joining, so the drainer is checked again afterwards: a
+         * tracing thread may have launched a new one, or another thread may be stopping it.
+         */
+        void stopLocked(unique_lock<mutex> &guard)
+        {
+            while(drainer_ != nullptr)
+            {
+                if(stopping_)
+                {
+                    drained_.wait(guard);
+                    continue;
+                }
+                stopping_       = true;
+                thread *drainer = drainer_;
+                wakeUp_.notify_all();
+                guard.unlock();
+                drainer->join();
+                guard.lock();
+
+                delete drainer;
+                drainer_  = nullptr;
+                stopping_ = false;
+                running_.store(false, memory_order_relaxed);
+                out_->flush();
+                drained_.notify_all();
+            }
+        }
+
+        void launch()
+        {
+            startTicks_ = profileTicks();
+            running_.store(true, memory_order_relaxed);
+            drainer_ = new thread([this] { drainLoop(); });
+        }
+
+        void drainLoop()
+        {
+            unique_lock<mutex> guard(lock_);
+            for(;;)
+            {
+                wakeUp_.wait_for(guard, chrono::milliseconds(5), [&] { return (stopping_ || flushRequested_); });
+                flushRequested_ = false;
+                bool last       = stopping_;
+                drain();
+                cycles_++;
+                drained_.notify_all();
+                if(last)
+                    return;
+            }
+        }
+
+        /**
+         * Decode the records of all rings, sorted by time stamp within this cycle only (a record
+         * of one thread may still be in flight while a later one of another is drained), and
+         * write them; forget the rings of finished threads once they are empty.
+         */
+        void drain()
+        {
+            text_.clear();
+            records_.clear();
+            char bytes[trace_detail::record_builder::maxBytes];
+            for(auto &ring: rings_)
+            {
+                uint64_t head = ring->head.load(memory_order_acquire);
+                uint64_t tail = ring->tail.load(memory_order_relaxed);
+                while(tail < head)
+                {
+                    uint16_t size;
+                    ring->copyOut(tail, reinterpret_cast<char *>(&size), sizeof(size));
+                    ring->copyOut(tail, bytes, size);
+                    decode(ring->thread, bytes, size);
+                    tail += size;
+                }
+                ring->tail.store(tail, memory_order_release);
+
+                uint64_t drops = ring->dropped.load(memory_order_relaxed);
+                if(drops > ring->reportedDrops)
+                {
+                    size_t begin = text_.size();
+                    text_ += "T" + to_string(ring->thread) + " dropped " + to_string(drops - ring->reportedDrops) +
+                             " records";
+                    records_.push_back(decoded_record{profileTicks(), begin, text_.size()});
+                    ring->reportedDrops = drops;
+                }
+            }
+
+            stable_sort(records_.begin(),
+                        records_.end(),
+                        [](const decoded_record &lhs, const decoded_record &rhs) { return (lhs.ticks < rhs.ticks); });
+            double secondsPerTick = 1e-9 / ticksPerNanosecond();
+            lines_.clear();
+            for(const auto &r: records_)
+            {
+                appendNumber(lines_, (double(r.ticks) - double(startTicks_)) * secondsPerTick, chars_format::fixed, 9);
+                lines_ += ' ';
+                lines_.append(text_, r.begin, r.end - r.begin);
+                lines_ += '\n';
+            }
+            out_->write(lines_.data(), lines_.size());
+            out_->flush();
+
+            auto retired = [](const shared_ptr<trace_ring> &ring)
+            {
+                return (ring->finished.load(memory_order_acquire) &&
+                        ring->tail.load(memory_order_relaxed) == ring->head.load(memory_order_acquire));
+            };
+            for(auto &ring: rings_)
+                if(retired(ring))
+                    retiredDrops_ += ring->dropped.load(memory_order_relaxed);
+            erase_if(rings_, retired);
+        }
+
+        /**
+         * Append the text of the record to the arena.
+         */
+        void decode(uint32_t thread, const char *bytes, size_t size)
+        {
+            decoded_record record;
+            uint32_t       site;
+            memcpy(&record.ticks, bytes + sizeof(uint16_t), sizeof(record.ticks));
+            memcpy(&site, bytes + sizeof(uint16_t) + sizeof(record.ticks), sizeof(site));
+            const trace_site &s = sites_[site];
+
+            record.begin = text_.size();
+            text_ += 'T';
+            appendNumber(text_, thread);
+            text_ += ' ';
+            text_ += s.prefix;
+            size_t at = trace_detail::record_builder::headerBytes;
+            for(size_t arg = 0; at < size; arg++)
+            {
+                text_ += arg < s.labels.size() ? string_view(s.labels[arg]) : string_view(" ");
+
+                auto type = trace_detail::ArgType(bytes[at++]);
+                auto read = [&](auto &value)
+                {
+                    memcpy(&value, bytes + at, sizeof(value));
+                    at += sizeof(value);
+                };
+                switch(type)
+                {
+                    case trace_detail::ArgType::INT:
+                    {
+                        int64_t v;
+                        read(v);
+                        appendNumber(text_, v);
+                        break;
+                    }
+                    case trace_detail::ArgType::UINT:
+                    {
+                        uint64_t v;
+                        read(v);
+                        appendNumber(text_, v);
+                        break;
+                    }
+                    case trace_detail::ArgType::FLOAT:
+                    {
+                        double v;
+                        read(v);
+                        appendNumber(text_, v);
+                        break;
+                    }
+                    case trace_detail::ArgType::BOOL:
+                    {
+                        uint8_t v;
+                        read(v);
+                        text_ += v != 0 ? '1' : '0';
+                        break;
+                    }
+                    case trace_detail::ArgType::CHAR:
+                    {
+                        char v;
+                        read(v);
+                        text_ += v;
+                        break;
+                    }
+                    case trace_detail::ArgType::STRING:
+                    {
+                        uint16_t length;
+                        read(length);
+                        text_.append(bytes + at, length);
+                        at += length;
+                        break;
+                    }
+                    case trace_detail::ArgType::POINTER:
+                    {
+                        uintptr_t v;
+                        read(v);
+                        text_ += "0x";
+                        appendNumber(text_, v, 16);
+                        break;
+                    }
+                }
+            }
+            record.end = text_.size();
+            records_.push_back(record);
+        }
+
+        /**
+         * Only the forking thread exists in the child: forget the drainer, and the records that
+         * the parent writes.
+         */
+        void afterFork()
+        {
+            lock_.unlock();
+            drainer_ = nullptr;
+            running_.store(false, memory_order_relaxed);
+            stopping_ = false;
+            for(auto &ring: rings_)
+                ring->tail.store(ring->head.load(memory_order_relaxed), memory_order_relaxed);
+        }
+
+        mutex                          lock_;
+        condition_variable             wakeUp_;
+        condition_variable             drained_;
+        deque<trace_site>              sites_;
+        vector<shared_ptr<trace_ring>> rings_;
+        uint32_t                       nextThread_     = 1;
+        size_t                         ringBytes_      = size_t(1) << 16;
+        thread                        *drainer_        = nullptr;
+        atomic<bool>                   running_        = false;
+        bool                           stopping_       = false;
+        bool                           flushRequested_ = false;
+        bool                           shuttingDown_   = false;
+        uint64_t                       cycles_         = 0;
+        uint64_t                       startTicks_     = 0;
+        uint64_t                       retiredDrops_   = 0;
+        ostream                       *out_            = &cout;
+        unique_ptr<ofstream>           file_;
+        string                         text_;     ///< arena of the drain cycle
+        vector<decoded_record>         records_;  ///< records of the drain cycle
+        string                         lines_;    ///< output of the drain cycle
+    };
+
+    /**
+     * Keeps the ring of a thread until the drainer has emptied it after the thread ended.
+     */
+    struct ring_owner
+    {
+        ring_owner() : ring(trace_backend::instance().addThread())
+        {
+        }
+
+        ~ring_owner()
+        {
+            ring->finished.store(true, memory_order_release);
+        }
+
+        shared_ptr<trace_ring> ring;
+    };
+
+    thread_local constinit trace_ring *threadRing = nullptr;
+};
+// namespace
+
+void setTraceLevel(TraceLevel level)
+{
+    trace_detail::threshold.store(uint8_t(level), memory_order_relaxed);
+}
+
+TraceLevel traceLevel()
+{
+    return (TraceLevel(trace_detail::threshold.load(memory_order_relaxed)));
+}
+
+void startTracing(const string &path, size_t bytesPerThread)
+{
+    trace_backend::instance().start(path, bytesPerThread);
+}
+
+void stopTracing()
+{
+    trace_backend::instance().stop();
+}
+
+void flushTracing()
+{
+    trace_backend::instance().flush();
+}
+
+uint64_t droppedTraceRecords()
+{
+    return (trace_backend::instance().dropped());
+}
+
+uint32_t registerTraceSite(const char *file, int line, const char *function, const char *names, TraceLevel level)
+{
+    return (trace_backend::instance().addSite(file, line, function, names, level));
+}
+
+void trace_detail::submit(string_view record)
+{
+    trace_ring *ring = threadRing;
+    if(ring == nullptr)
+    {
+        thread_local ring_owner owner;
+        ring = threadRing = owner.ring.get();
+    }
+    auto &backend = trace_backend::instance();
+    if(!backend.running())
+        backend.startIfIdle();
+    ring->push(record);
+}
+};
+// namespace util
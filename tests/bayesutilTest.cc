@@ -242,3 +242,35 @@ void bayesutilTest::util_bayes_test()
         e = bn.bayesBallAlgorithm(ce, irrelevant);
     }
 }
+
+void bayesutilTest::util_bayes_distribution_test()
+{
+    // makeUniform, normalise and canonise create the missing distribution of a node
+    auto makeNet = [](BayesNet &bn)
+    {
+        bn.addNode("Cloud", EventValueRange(true), "whether there are clouds");
+        bn.addNode("Rain", EventValueRange(VAR_UINT(0), 4), "amount of rain");
+        bn.addCauseEffect("Cloud", "Rain");
+        CPPUNIT_ASSERT(!bn.fullyDefined());
+    };
+
+    BayesNet bn;
+    makeNet(bn);
+    CPPUNIT_ASSERT_NO_THROW(bn.canonise());
+    CPPUNIT_ASSERT_NO_THROW(bn.normalise());
+    CPPUNIT_ASSERT(bn.fullyDefined());
+    long double p = bn.P(CondEvent(Event("Cloud", true)));
+    CPPUNIT_ASSERT(p > 0.0L);
+    CPPUNIT_ASSERT(p <= 1.0L);
+    p = bn.P(CondEvent(Event("Rain", VAR_UINT(2)), Event("Cloud", false)));
+    CPPUNIT_ASSERT(p > 0.0L);
+    CPPUNIT_ASSERT(p <= 1.0L);
+
+    bn.clear();
+    makeNet(bn);
+    CPPUNIT_ASSERT_NO_THROW(bn.normalise());
+
+    bn.clear();
+    makeNet(bn);
+    CPPUNIT_ASSERT_NO_THROW(bn.makeUniform());
+}
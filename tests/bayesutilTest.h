@@ -31,6 +31,7 @@ class bayesutilTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST_SUITE(bayesutilTest);
 
     CPPUNIT_TEST(util_bayes_test);
+    CPPUNIT_TEST(util_bayes_distribution_test);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -42,6 +43,7 @@ class bayesutilTest : public CPPUNIT_NS::TestFixture
 
     private:
     void util_bayes_test();
+    void util_bayes_distribution_test();
 };
 
 #endif /* BAYESUTILTEST_H */
@@ -23,7 +23,9 @@
 
 #include "bitConverterTest.h"
 
+#include <bit>
 #include <bit_converter.h>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <string>
@@ -54,3 +56,87 @@ void bitConverterTest::construction_test()
     bit_converter defaultBC = 0.0L;
     cout << defaultBC.asBitset().to_string() << endl;
 }
+
+void bitConverterTest::word_operations_test()
+{
+    bit_converter<uint32_t> w = 0x80000001U;
+    w.rotate(1);
+    CPPUNIT_ASSERT_EQUAL(0xC0000000U, uint32_t(w));
+    w.rotate(-2);
+    CPPUNIT_ASSERT_EQUAL(0x00000003U, uint32_t(w));
+    w.rotateLeft(36);
+    CPPUNIT_ASSERT_EQUAL(0x00000030U, uint32_t(w));
+    w.rotateRight(5);
+    CPPUNIT_ASSERT_EQUAL(0x80000001U, uint32_t(w));
+
+    CPPUNIT_ASSERT_EQUAL(2, w.popCount());
+    CPPUNIT_ASSERT_EQUAL(0, w.countTrailingZeros());
+    CPPUNIT_ASSERT_EQUAL(0, w.countLeadingZeros());
+    CPPUNIT_ASSERT_EQUAL(32, bit_converter<uint32_t>(0U).countTrailingZeros());
+
+    bit_converter<uint32_t> bytes = 0x11223344U;
+    bytes.swapBytes();
+    CPPUNIT_ASSERT_EQUAL(0x44332211U, uint32_t(bytes));
+    bytes.convertByteOrder(std::endian::native);
+    CPPUNIT_ASSERT_EQUAL(0x44332211U, uint32_t(bytes));
+    CPPUNIT_ASSERT_EQUAL(uint16_t(0x3412), byteSwap(uint16_t(0x1234)));
+
+    // types that are not machine words are handled byte by byte
+    bit_converter<long double> ld = 1.5L;
+    bit_converter<long double> rotated = ld;
+    rotated.rotate(13);
+    CPPUNIT_ASSERT_EQUAL(ld.popCount(), rotated.popCount());
+    for(long long i = 0; i < bit_converter<long double>::BITS_IN_DATA; i++)
+        CPPUNIT_ASSERT_EQUAL(ld.getBit((i + 13) % bit_converter<long double>::BITS_IN_DATA), rotated.getBit(i));
+    rotated.rotateLeft(13);
+    CPPUNIT_ASSERT_EQUAL(ld.asBitset().to_string(), rotated.asBitset().to_string());
+    CPPUNIT_ASSERT_EQUAL(ld.countTrailingZeros(), bit_converter<uint64_t>(0xC000000000000000ULL).countTrailingZeros());
+
+    // bitsets of parts of the data
+    bit_converter<uint16_t> h = 0xABCDU;
+    CPPUNIT_ASSERT_EQUAL(string("1010"), h.asBitset<4>(12).to_string());
+    CPPUNIT_ASSERT_EQUAL(string("11010000"), h.asBitset<8>(-4).to_string());
+    CPPUNIT_ASSERT_EQUAL(string("0000"), h.asBitset<4>(16).to_string());
+}
+
+void bitConverterTest::bit_field_test()
+{
+    // IPv4-like header word: version 4, header length 5, total length 1500, ttl 64
+    bit_converter<uint64_t> header = 0ULL;
+    header.setBits(0, 4, 4);
+    header.setBits(4, 4, 5);
+    header.setBits(16, 16, 1500);
+    header.setBits(56, 8, 64);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), header.getBits(0, 4));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(5), header.getBits(4, 4));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1500), header.getBits(16, 16));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(64), header.getBits(56, 8));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(header), header.getBits(0, 64));
+    header.setBits(4, 4, 0xFF);  // excess bits are ignored
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0xF4), header.getBits(0, 8));
+
+    // scattered fields
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0b11110000), extractBits(0xF0A0ULL, 0xF00FULL));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0xA005ULL), depositBits(0b10100101ULL, 0xF00FULL));
+    CPPUNIT_ASSERT_EQUAL(~0ULL, extractBits(~0ULL, ~0ULL));
+    CPPUNIT_ASSERT_EQUAL(0ULL, depositBits(~0ULL, 0ULL));
+
+    bit_converter<uint32_t> flags = 0x12345678U;
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0x1238), flags.extract(0xFFF0000FU));
+    flags.insert(0xFFF0000FU, 0xABCD);
+    CPPUNIT_ASSERT_EQUAL(0xABC4567DU, uint32_t(flags));
+
+    // fields across the bytes of a type that is not a machine word
+    struct rgb
+    {
+        uint8_t r = 0;
+        uint8_t g = 0;
+        uint8_t b = 0;
+    };
+    bit_converter<rgb> pixel;
+    pixel.setBits(3, 12, 0xABC);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0xABC), pixel.getBits(3, 12));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(0xE0), pixel.getByte(0));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(0x55), pixel.getByte(1));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(0x00), pixel.getByte(2));
+}
@@ -31,6 +31,8 @@ class bitConverterTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST_SUITE(bitConverterTest);
 
     CPPUNIT_TEST(construction_test);
+    CPPUNIT_TEST(word_operations_test);
+    CPPUNIT_TEST(bit_field_test);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -42,6 +44,8 @@ class bitConverterTest : public CPPUNIT_NS::TestFixture
 
     private:
     void construction_test();
+    void word_operations_test();
+    void bit_field_test();
 };
 
 #endif  // BIT_CONVERTER_TEST_H_INCLUDED
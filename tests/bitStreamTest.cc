@@ -0,0 +1,165 @@
+/*
+ * File:		bitStreamTest.cc
+ * Description:         Unit tests for the bit stream reader and writer
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "bitStreamTest.h"
+
+#include <bit>
+#include <bit_stream.h>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(bitStreamTest);
+
+bitStreamTest::bitStreamTest()
+{
+}
+
+bitStreamTest::~bitStreamTest()
+{
+}
+
+void bitStreamTest::setUp()
+{
+}
+
+void bitStreamTest::tearDown()
+{
+}
+
+namespace
+{
+vector<byte> bytes(initializer_list<unsigned> values)
+{
+    vector<byte> reval;
+    for(auto v: values)
+        reval.push_back(byte(v));
+
+    return (reval);
+}
+};
+// namespace
+
+void bitStreamTest::pack_unpack_test()
+{
+    // 3-bit fields 1..5: least significant bit first 001 010 011 100 101 -> 0xD1 0x58
+    vector<uint8_t> small = {1, 2, 3, 4, 5};
+    vector<byte>    packed(packedSize(small.size(), 3));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), packed.size());
+    packBits(span<const uint8_t>(small), 3, packed);
+    CPPUNIT_ASSERT(packed == bytes({0xD1, 0x58}));
+
+    // most significant bit first: 001 010 011 100 101 0 -> 0x29 0xCA
+    packBits(span<const uint8_t>(small), 3, packed, endian::big);
+    CPPUNIT_ASSERT(packed == bytes({0x29, 0xCA}));
+    vector<uint8_t> unpacked(small.size());
+    unpackBits(packed, 3, span<uint8_t>(unpacked), endian::big);
+    CPPUNIT_ASSERT(unpacked == small);
+
+    // 12-bit fields through the vectorised path and the tail, in both orders
+    vector<uint32_t> values(1001);
+    for(size_t i = 0; i < values.size(); i++)
+        values[i] = uint32_t(i * 2654435761U) & 0xFFF;
+    for(auto order: {endian::little, endian::big})
+    {
+        vector<byte> buffer(packedSize(values.size(), 12));
+        packBits(span<const uint32_t>(values), 12, buffer, order);
+        vector<uint32_t> back(values.size());
+        unpackBits(buffer, 12, span<uint32_t>(back), order);
+        CPPUNIT_ASSERT(back == values);
+        CPPUNIT_ASSERT_EQUAL(uint64_t(values[500]), peekBits(buffer, 500 * 12, 12, order));
+    }
+
+    // every width, including fields that do not fit into one 64-bit load
+    for(unsigned bits = 1; bits <= 64; bits++)
+    {
+        vector<uint64_t> wide(37);
+        for(size_t i = 0; i < wide.size(); i++)
+            wide[i] = (0x9E3779B97F4A7C15ULL * (i + 1)) & (bits == 64 ? ~0ULL : (1ULL << bits) - 1);
+        vector<byte> buffer(packedSize(wide.size(), bits));
+        packBits(span<const uint64_t>(wide), bits, buffer, endian::big);
+        vector<uint64_t> back(wide.size());
+        unpackBits(buffer, bits, span<uint64_t>(back), endian::big);
+        CPPUNIT_ASSERT(back == wide);
+    }
+
+    // fields are masked, trailing bits cleared
+    vector<uint16_t> over = {0xFFFF};
+    vector<byte>     one  = bytes({0xAA});
+    packBits(span<const uint16_t>(over), 5, one);
+    CPPUNIT_ASSERT(one == bytes({0x1F}));
+
+    vector<uint8_t> eight(8);
+    CPPUNIT_ASSERT_THROW(unpackBits(one, 9, span<uint8_t>(eight)), invalid_argument);
+    CPPUNIT_ASSERT_THROW(unpackBits(one, 2, span<uint8_t>(eight)), out_of_range);
+    CPPUNIT_ASSERT_THROW(packBits(span<const uint16_t>(over), 0, one), invalid_argument);
+}
+
+void bitStreamTest::reader_writer_test()
+{
+    // telemetry record: 3-bit type, 5-bit channel, 12-bit samples, 1-bit flag, 64-bit time
+    vector<uint16_t> samples = {0x123, 0xFFF, 0x000, 0x800};
+    for(auto order: {endian::little, endian::big})
+    {
+        bit_writer writer(order);
+        writer.write(6, 3);
+        writer.write(17, 5);
+        writer.write(samples, 12);
+        writer.write(1, 1);
+        writer.write(0x0123456789ABCDEFULL, 64);
+        CPPUNIT_ASSERT_EQUAL(size_t(3 + 5 + 48 + 1 + 64), writer.position());
+        CPPUNIT_ASSERT_EQUAL(size_t(16), writer.bytes().size());
+        writer.align();
+        writer.write(0x5A, 8);
+        CPPUNIT_ASSERT_EQUAL(size_t(17), writer.bytes().size());
+
+        bit_reader reader(writer.bytes(), order);
+        CPPUNIT_ASSERT_EQUAL(uint64_t(6), reader.read(3));
+        CPPUNIT_ASSERT_EQUAL(uint64_t(17), reader.read(5));
+        vector<uint16_t> back(samples.size());
+        reader.read(12, span<uint16_t>(back));
+        CPPUNIT_ASSERT(back == samples);
+        CPPUNIT_ASSERT_EQUAL(uint64_t(1), reader.read(1));
+        CPPUNIT_ASSERT_EQUAL(uint64_t(0x0123456789ABCDEFULL), reader.read(64));
+        reader.align();
+        CPPUNIT_ASSERT_EQUAL(uint64_t(0x5A), reader.read(8));
+        CPPUNIT_ASSERT_EQUAL(size_t(0), reader.remaining());
+        CPPUNIT_ASSERT_THROW(reader.read(1), out_of_range);
+
+        reader.seek(3);
+        CPPUNIT_ASSERT_EQUAL(uint64_t(17), reader.read(5));
+        CPPUNIT_ASSERT_THROW(reader.seek(17 * 8 + 1), out_of_range);
+    }
+
+    // big-endian fields read as in network headers
+    vector<byte> header = bytes({0x45, 0x00, 0x05, 0xDC});
+    bit_reader   ipv4(header, endian::big);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), ipv4.read(4));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(5), ipv4.read(4));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), ipv4.read(8));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1500), ipv4.read(16));
+}
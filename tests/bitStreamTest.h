@@ -0,0 +1,49 @@
+/*
+ * File:		bitStreamTest.h
+ * Description:         Unit tests for the bit stream reader and writer
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef BITSTREAMTEST_H
+#define BITSTREAMTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class bitStreamTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(bitStreamTest);
+
+    CPPUNIT_TEST(pack_unpack_test);
+    CPPUNIT_TEST(reader_writer_test);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    bitStreamTest();
+    virtual ~bitStreamTest();
+    void setUp();
+    void tearDown();
+
+    private:
+    void pack_unpack_test();
+    void reader_writer_test();
+};
+
+#endif /* BITSTREAMTEST_H */
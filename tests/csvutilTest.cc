@@ -96,6 +96,18 @@ void csvutilTest::util_csv_test()
         CPPUNIT_ASSERT_DOUBLES_EQUAL(csv.getFloat(2, 0), 3.14159265L, 0.000000001);
         CPPUNIT_ASSERT_EQUAL(csv.getInt(3, 0), VAR_INT(5));
     }
+    {
+        // the number scanned while guessing the type is kept for the conversion
+        NumberValue number;
+        CPPUNIT_ASSERT_EQUAL(CSV_COLUMN_TYPE_INT, CSVAnalyzer::guessType("-12", number));
+        CPPUNIT_ASSERT_EQUAL(int64_t(-12), number.intValue);
+        CPPUNIT_ASSERT_EQUAL(CSV_COLUMN_TYPE_INT, CSVAnalyzer::guessType("1", number));
+        CPPUNIT_ASSERT_EQUAL(int64_t(1), number.intValue);
+        CPPUNIT_ASSERT_EQUAL(CSV_COLUMN_TYPE_FLOAT, CSVAnalyzer::guessType("2.5e3", number));
+        CPPUNIT_ASSERT_EQUAL(2500.0L, number.floatValue);
+        CPPUNIT_ASSERT_EQUAL(CSV_COLUMN_TYPE_STRING, CSVAnalyzer::guessType("abc", number));
+        CPPUNIT_ASSERT(number.numberClass == util::NONE);
+    }
     {
         // BOOST_TEST_MESSAGE("Default Construct (no header /types rows)");
         CSVAnalyzer csv;
@@ -112,10 +124,10 @@ void csvutilTest::util_csv_test()
         CPPUNIT_ASSERT_EQUAL(csv.getInt(5, 0), VAR_INT(8));
         CPPUNIT_ASSERT_EQUAL(csv.getBool(6, 0), VAR_BOOL(true));
         CPPUNIT_ASSERT_EQUAL(csv.getBool(7, 0), VAR_BOOL(false));
-        CPPUNIT_ASSERT_EQUAL(csv.getInt(8, 0), VAR_INT(999999999999999999));         // last one converted to  int
-        CPPUNIT_ASSERT_EQUAL(csv.getUint(9, 0), VAR_UINT(1000000000000000000));      // first one converted to uint
-        CPPUNIT_ASSERT_EQUAL(csv.getUint(10, 0), VAR_UINT(9223372036854775807));     // max long long
-        CPPUNIT_ASSERT_EQUAL(csv.getUint(11, 0), VAR_UINT(9223372036854775808UL));   // one bigger
+        CPPUNIT_ASSERT_EQUAL(csv.getInt(8, 0), VAR_INT(999999999999999999));
+        CPPUNIT_ASSERT_EQUAL(csv.getInt(9, 0), VAR_INT(1000000000000000000));
+        CPPUNIT_ASSERT_EQUAL(csv.getInt(10, 0), VAR_INT(9223372036854775807));       // max long long: last int
+        CPPUNIT_ASSERT_EQUAL(csv.getUint(11, 0), VAR_UINT(9223372036854775808UL));   // one bigger: first uint
         CPPUNIT_ASSERT_EQUAL(csv.getUint(12, 0), VAR_UINT(10223372036854775807UL));  // a lot bigger
     }
     {
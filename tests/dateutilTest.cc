@@ -36,9 +36,11 @@
 #include <dateutil.h>
 #include <graphutil.h>
 #include <iostream>
+#include <random>
 #include <statutil.h>
 #include <string>
 #include <stringutil.h>
+#include <thread>
 
 using namespace std;
 using namespace util;
@@ -402,3 +404,196 @@ void dateutilTest::util_date_american_test()
         CPPUNIT_ASSERT(scanResults[i].correctResult());
     }
 }
+
+void dateutilTest::util_epoch_date_test()
+{
+    // compile-time construction and arithmetic
+    static_assert(epoch_date::fromCivil(1970, 1, 1).ticks() == 0);
+    static_assert(epoch_date::fromCivil(1970, 1, 2).ticks() == epoch_date::ticks_per_day);
+    static_assert(epoch_date::fromCivil(1969, 12, 31, 23, 59, 59).toTimeT() == -1);
+    static_assert(epoch_date::fromCivil(2000, 3, 1) - epoch_date::fromCivil(2000, 2, 28)
+                  == std::chrono::hours(48));
+    static_assert(epoch_date::fromCivil(2014, 2, 3) + std::chrono::hours(24) == epoch_date::fromCivil(2014, 2, 4));
+    static_assert(epoch_date::notADateTime() < epoch_date::negInfinity());
+
+    // distances involving special values are special, not overflowed (a compile error if UB)
+    static_assert((epoch_date::posInfinity() - epoch_date::negInfinity()).count() == epoch_date::pos_infin_ticks);
+    static_assert((epoch_date::negInfinity() - epoch_date::fromCivil(2000, 1, 1)).count() ==
+                  epoch_date::neg_infin_ticks);
+    static_assert((epoch_date() - epoch_date::fromCivil(2000, 1, 1)).count() == epoch_date::not_a_date_ticks);
+    static_assert((epoch_date::posInfinity() - epoch_date::posInfinity()).count() == epoch_date::not_a_date_ticks);
+    static_assert((epoch_date::maxDate() - epoch_date(epoch_date::neg_infin_ticks + 1)).count() ==
+                  epoch_date::pos_infin_ticks);
+    static_assert(epoch_date::maxDate() < epoch_date::posInfinity());
+    static_assert(valid(epoch_date::fromCivil(1900, 1, 1)) && valid(epoch_date::fromCivil(2200, 12, 31, 23, 59, 59)));
+    static_assert(!valid(epoch_date::fromCivil(1899, 12, 31)) && !valid(epoch_date::fromCivil(2201, 1, 1)));
+    static_assert(!valid(epoch_date()) && !valid(epoch_date::posInfinity()));
+
+    // round-trip through boost::posix_time
+    ptime pt = toDate(2012, 11, 1, 12, 45, 21, 123456);
+    CPPUNIT_ASSERT(epoch_date(pt).toPtime() == pt);
+    CPPUNIT_ASSERT(epoch_date(pt) == epoch_date::fromCivil(2012, 11, 1, 12, 45, 21, 123456));
+    CPPUNIT_ASSERT_EQUAL(pt_to_time_t(pt), epoch_date(pt).toTimeT());
+    CPPUNIT_ASSERT(epoch_date(toDate(1400, 1, 1)) == epoch_date::minDate());
+    CPPUNIT_ASSERT(epoch_date(ptime(max_date_time)) == epoch_date::maxDate());
+    CPPUNIT_ASSERT(epoch_date(date(1967, 11, 10)) == epoch_date::fromCivil(1967, 11, 10));
+    CPPUNIT_ASSERT_EQUAL(string("1967-Nov-10 12:34:56"), asString(epoch_date::fromCivil(1967, 11, 10, 12, 34, 56)));
+
+    // special values survive the round-trip
+    CPPUNIT_ASSERT(epoch_date(ptime()).isNotADateTime());
+    CPPUNIT_ASSERT(epoch_date(ptime(neg_infin)) == epoch_date::negInfinity());
+    CPPUNIT_ASSERT(epoch_date(ptime(pos_infin)).toPtime().is_pos_infinity());
+    CPPUNIT_ASSERT_EQUAL(string("not-a-date-time"), asString(epoch_date()));
+    CPPUNIT_ASSERT(epoch_date::posInfinity() + std::chrono::hours(1) == epoch_date::posInfinity());
+
+    // ordering agrees with boost for dates before and after the epoch
+    ptime early = toDate(1955, 6, 30, 1, 2, 3);
+    CPPUNIT_ASSERT((epoch_date(early) < epoch_date(pt)) == (early < pt));
+    CPPUNIT_ASSERT_EQUAL(epoch_date::rep_type(0), epoch_date(toDate(1955, 6, 30)).timeOfDay());
+    CPPUNIT_ASSERT(epoch_date(early).timeOfDay() == (1 * 3600 + 2 * 60 + 3) * epoch_date::ticks_per_second);
+}
+
+void dateutilTest::util_date_calc_test()
+{
+    using namespace util::datecalc;
+
+    static_assert(dayOfWeek(epoch_date::fromCivil(1970, 1, 1)) == 4);  // Thursday
+    static_assert(truncate(epoch_date::fromCivil(2020, 2, 29, 13, 14, 15), DateUnit::Month)
+                  == epoch_date::fromCivil(2020, 2, 1));
+    static_assert(civilFromDays(daysFromCivil(-4713, 11, 24)).year == -4713);
+
+    // compare the bulk kernels against boost for random dates either side of the epoch
+    mt19937_64                                     rng(4711);
+    uniform_int_distribution<epoch_date::rep_type> dist(epoch_date::fromCivil(1400, 1, 1).ticks(),
+                                                        epoch_date::fromCivil(2400, 1, 1).ticks());
+    vector<epoch_date>                             dates(5000);
+
+    for(auto &d: dates)
+        d = epoch_date(dist(rng));
+    dates.push_back(epoch_date());
+    dates.push_back(epoch_date::posInfinity());
+
+    vector<epoch_date>    dayStarts(dates.size()), weeks(dates.size()), months(dates.size()), years(dates.size());
+    vector<unsigned char> dows(dates.size());
+    vector<time_t>        secs(dates.size());
+
+    truncate(dates, dayStarts, DateUnit::Day);
+    truncate(dates, weeks, DateUnit::Week);
+    truncate(dates, months, DateUnit::Month);
+    truncate(dates, years, DateUnit::Year);
+    dayOfWeek(dates, dows);
+    toTimeT(dates, secs);
+
+    for(size_t i = 0; i < dates.size() - 2; i++)
+    {
+        date bd = dates[i].toPtime().date();
+
+        CPPUNIT_ASSERT(dayStarts[i] == epoch_date(bd));
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned>(bd.day_of_week().as_number()), static_cast<unsigned>(dows[i]));
+        CPPUNIT_ASSERT(weeks[i] == epoch_date(bd - days((bd.day_of_week().as_number() + 6) % 7)));
+        CPPUNIT_ASSERT(months[i] == epoch_date(date(bd.year(), bd.month(), 1)));
+        CPPUNIT_ASSERT(years[i] == epoch_date(date(bd.year(), 1, 1)));
+        CPPUNIT_ASSERT(civilFromDays(dates[i].daysSinceEpoch()).day == bd.day());
+        CPPUNIT_ASSERT_EQUAL(pt_to_time_t(dates[i].toPtime()), secs[i]);
+        CPPUNIT_ASSERT_EQUAL(pt_to_time_t(years[i].toPtime()), years[i].toTimeT());
+    }
+
+    // special values pass through unchanged
+    CPPUNIT_ASSERT(months[dates.size() - 2].isNotADateTime());
+    CPPUNIT_ASSERT(years[dates.size() - 1] == epoch_date::posInfinity());
+    CPPUNIT_ASSERT_EQUAL(7U, static_cast<unsigned>(dows.back()));
+
+    vector<epoch_date::rep_type> diffs(dates.size());
+    difference(dates, dayStarts, diffs);
+    CPPUNIT_ASSERT_EQUAL(dates[0].timeOfDay(), diffs[0]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::not_a_date_ticks, diffs[dates.size() - 2]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::not_a_date_ticks, diffs[dates.size() - 1]);
+
+    // infinities and overflowing differences do not wrap around
+    vector<epoch_date> lhs{epoch_date::posInfinity(),
+                           epoch_date::negInfinity(),
+                           epoch_date::posInfinity(),
+                           dates[0],
+                           dates[0],
+                           epoch_date(epoch_date::pos_infin_ticks - 1),
+                           epoch_date(epoch_date::neg_infin_ticks + 1)};
+    vector<epoch_date> rhs{epoch_date::negInfinity(),
+                           epoch_date::posInfinity(),
+                           dates[0],
+                           epoch_date::posInfinity(),
+                           epoch_date::negInfinity(),
+                           epoch_date(epoch_date::neg_infin_ticks + 1),
+                           epoch_date(epoch_date::pos_infin_ticks - 1)};
+    vector<epoch_date::rep_type> specialDiffs(lhs.size());
+    difference(lhs, rhs, specialDiffs);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::pos_infin_ticks, specialDiffs[0]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::neg_infin_ticks, specialDiffs[1]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::pos_infin_ticks, specialDiffs[2]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::neg_infin_ticks, specialDiffs[3]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::pos_infin_ticks, specialDiffs[4]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::pos_infin_ticks, specialDiffs[5]);
+    CPPUNIT_ASSERT_EQUAL(epoch_date::neg_infin_ticks, specialDiffs[6]);
+
+    // pre-1970 fractional seconds: truncated like pt_to_time_t(), floored by epoch_date::toTimeT()
+    vector<epoch_date> beforeEpoch{epoch_date(-1'500'000)};
+    vector<time_t>     beforeEpochSecs(1);
+    toTimeT(beforeEpoch, beforeEpochSecs);
+    CPPUNIT_ASSERT_EQUAL(time_t(-1), beforeEpochSecs[0]);
+    CPPUNIT_ASSERT_EQUAL(pt_to_time_t(beforeEpoch[0].toPtime()), beforeEpochSecs[0]);
+    CPPUNIT_ASSERT_EQUAL(time_t(-2), beforeEpoch[0].toTimeT());
+
+    vector<time_t> tooShort(1);
+    CPPUNIT_ASSERT_THROW(toTimeT(dates, tooShort), std::out_of_range);
+}
+
+void dateutilTest::util_date_format_registry_test()
+{
+    // a context with fixed formats is unaffected by changes to the global formats
+    DateFormats usFormats;
+    initDateFormats(DateFormatPreference::USA, usFormats);
+    DateParseContext usContext(make_shared<const DateFormats>(usFormats));
+
+    resetDateFormats();
+    CPPUNIT_ASSERT(currentDateFormats()->empty());
+    CPPUNIT_ASSERT(scanDate("02/05/2014").is_not_a_date_time());
+    CPPUNIT_ASSERT_EQUAL(string("2014-Feb-05 00:00:00"), asString(usContext.scan("02/05/2014")));
+
+    // a snapshot taken before a change stays intact
+    addDateFormat("%d/%m/%Y");
+    DateFormatsPtr snapshot = currentDateFormats();
+    addDateFormat("%Y%m%d");
+    CPPUNIT_ASSERT_EQUAL(size_t(1), snapshot->size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), currentDateFormats()->size());
+    CPPUNIT_ASSERT_EQUAL(string("2014-May-02 00:00:00"), asString(scanDate("02/05/2014")));
+
+    // parse concurrently while the global formats are being swapped
+    const string        ambiguous = "02/05/2014 12:34:56";
+    const ptime         us        = toDate(2014, 2, 5, 12, 34, 56);
+    const ptime         european  = toDate(2014, 5, 2, 12, 34, 56);
+    atomic<bool>        stop{false};
+    atomic<size_t>      wrong{0};
+    vector<std::thread> readers;
+
+    initDateFormats(DateFormatPreference::European);
+    for(size_t t = 0; t < 4; t++)
+    {
+        readers.emplace_back(
+         [&]
+         {
+             while(!stop)
+             {
+                 ptime dt = scanDate(ambiguous);
+                 if(dt != us && dt != european)
+                     wrong++;
+             }
+         });
+    }
+    for(size_t i = 0; i < 50; i++)
+        initDateFormats(i % 2 == 0 ? DateFormatPreference::USA : DateFormatPreference::European);
+    stop = true;
+    for(auto &reader: readers)
+        reader.join();
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), size_t(wrong));
+    CPPUNIT_ASSERT(scanDate(ambiguous) == european);
+}
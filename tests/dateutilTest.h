@@ -32,6 +32,9 @@ class dateutilTest : public CPPUNIT_NS::TestFixture
 
     CPPUNIT_TEST(util_date_european_test);
     CPPUNIT_TEST(util_date_american_test);
+    CPPUNIT_TEST(util_epoch_date_test);
+    CPPUNIT_TEST(util_date_calc_test);
+    CPPUNIT_TEST(util_date_format_registry_test);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -44,6 +47,9 @@ class dateutilTest : public CPPUNIT_NS::TestFixture
     private:
     void util_date_european_test();
     void util_date_american_test();
+    void util_epoch_date_test();
+    void util_date_calc_test();
+    void util_date_format_registry_test();
 };
 
 #endif /* DATEUTILTEST_H */
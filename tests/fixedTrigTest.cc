@@ -0,0 +1,186 @@
+/*
+ * File:		fixedTrigTest.cc
+ * Description:         Unit tests for fixed-point trigonometry
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "fixedTrigTest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fixed_trig.h>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(fixedTrigTest);
+
+fixedTrigTest::fixedTrigTest()
+{
+}
+
+fixedTrigTest::~fixedTrigTest()
+{
+}
+
+void fixedTrigTest::setUp()
+{
+}
+
+void fixedTrigTest::tearDown()
+{
+}
+
+namespace
+{
+const long double pi = numbers::pi_v<long double>;
+
+long double fromQ30(q30_t v)
+{
+    return ((long double)v / Q30_ONE);
+}
+};
+// namespace
+
+void fixedTrigTest::degree_test()
+{
+    // correctly rounded: error at most half a unit of the last place, 2^-31
+    const long double bound = 1.0L / (2.0L * Q30_ONE);
+    for(int64_t d = 0; d <= 359; d++)
+    {
+        long double x = pi * d / 180.0L;
+        CPPUNIT_ASSERT(fabsl(fromQ30(fixedSin(Deg360(d))) - sinl(x)) <= bound);
+        CPPUNIT_ASSERT(fabsl(fromQ30(fixedCos(Deg360(d))) - cosl(x)) <= bound);
+    }
+    for(int64_t d = -179; d <= 180; d++)
+    {
+        long double x = pi * d / 180.0L;
+        CPPUNIT_ASSERT(fabsl(fromQ30(fixedSin(Deg180(d))) - sinl(x)) <= bound);
+        CPPUNIT_ASSERT(fabsl(fromQ30(fixedCos(Deg180(d))) - cosl(x)) <= bound);
+    }
+    CPPUNIT_ASSERT_EQUAL(Q30_ONE, fixedSin(Deg360(int64_t(90))));
+    CPPUNIT_ASSERT_EQUAL(-Q30_ONE, fixedCos(Deg180(int64_t(180))));
+    CPPUNIT_ASSERT_EQUAL(q30_t(0), fixedSin(Deg180(int64_t(0))));
+
+    // batch variants agree with the single ones
+    vector<Deg180> angles;
+    for(int64_t d = -179; d <= 180; d++)
+        angles.push_back(d);
+    vector<q30_t> sines(angles.size());
+    vector<q30_t> cosines(angles.size());
+    fixedSin<Deg180>(angles, sines);
+    fixedCos<Deg180>(angles, cosines);
+    for(size_t i = 0; i < angles.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(fixedSin(angles[i]), sines[i]);
+        CPPUNIT_ASSERT_EQUAL(fixedCos(angles[i]), cosines[i]);
+    }
+    sines.resize(3);
+    CPPUNIT_ASSERT_THROW(fixedSin<Deg180>(angles, sines), invalid_argument);
+}
+
+void fixedTrigTest::radian_test()
+{
+    // documented bound 1e-8; every 7th micro-radian of the turn and the quarter turns
+    const long double bound    = 1e-8L;
+    long double       maxError = 0.0L;
+    vector<Rad2Pi>    angles;
+    for(int64_t r = 0; r <= MICRO_RAD_2PI_MAX; r += 7)
+        angles.push_back(r);
+    for(int64_t r: {int64_t(0), MICRO_RAD_PI / 2, MICRO_RAD_PI, MICRO_RAD_PI * 3 / 2, MICRO_RAD_2PI_MAX})
+        angles.push_back(r);
+
+    vector<q30_t> sines(angles.size());
+    vector<q30_t> cosines(angles.size());
+    fixedSin<Rad2Pi>(angles, sines);
+    fixedCos<Rad2Pi>(angles, cosines);
+    for(size_t i = 0; i < angles.size(); i++)
+    {
+        long double x = angles[i].val() * 1e-6L;
+        maxError      = max(maxError, fabsl(fromQ30(sines[i]) - sinl(x)));
+        maxError      = max(maxError, fabsl(fromQ30(cosines[i]) - cosl(x)));
+        if(i % 1000 == 0)
+        {
+            CPPUNIT_ASSERT_EQUAL(sines[i], fixedSin(angles[i]));
+            CPPUNIT_ASSERT_EQUAL(cosines[i], fixedCos(angles[i]));
+        }
+    }
+    CPPUNIT_ASSERT(maxError < bound);
+}
+
+void fixedTrigTest::atan2_test()
+{
+    // before rounding to the unit of the angle type the error is below 1e-7 radians
+    mt19937                       rng(2);
+    uniform_int_distribution<int> coordinate(INT32_MIN, INT32_MAX);
+    uniform_int_distribution<int> small(-1000, 1000);
+    vector<int32_t>               ys;
+    vector<int32_t>               xs;
+    for(size_t i = 0; i < 20000; i++)
+    {
+        bool large = i % 2 == 0;
+        ys.push_back(large ? coordinate(rng) : small(rng));
+        xs.push_back(large ? coordinate(rng) : small(rng));
+    }
+    for(int32_t y: {0, 1, -1, INT32_MAX, INT32_MIN})
+    {
+        for(int32_t x: {0, 1, -1, INT32_MAX, INT32_MIN})
+        {
+            ys.push_back(y);
+            xs.push_back(x);
+        }
+    }
+
+    vector<Rad2Pi> radians(ys.size());
+    vector<Deg360> degrees(ys.size());
+    vector<Deg180> degrees180(ys.size());
+    fixedAtan2<Rad2Pi>(ys, xs, radians);
+    fixedAtan2<Deg360>(ys, xs, degrees);
+    fixedAtan2<Deg180>(ys, xs, degrees180);
+    for(size_t i = 0; i < ys.size(); i++)
+    {
+        long double exact = atan2l(ys[i], xs[i]);  // in (-pi, pi]
+        if(exact < 0)
+            exact += 2 * pi;
+
+        // micro-radians: within half a unit plus the approximation error, modulo the turn
+        long double microRad = exact * 1e6L;
+        long double diff     = fabsl(radians[i].val() - microRad);
+        diff                 = min(diff, fabsl(diff - 2e6L * pi));
+        CPPUNIT_ASSERT(diff <= 0.5L + 0.1L);
+
+        long double degree = exact * 180.0L / pi;
+        diff               = fabsl(degrees[i].val() - degree);
+        diff               = min(diff, fabsl(diff - 360.0L));
+        CPPUNIT_ASSERT(diff <= 0.5L + 1e-5L);
+        CPPUNIT_ASSERT_EQUAL(Deg180(degrees[i]).val(), degrees180[i].val());
+        CPPUNIT_ASSERT_EQUAL(fixedAtan2<Rad2Pi>(ys[i], xs[i]).val(), radians[i].val());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(int64_t(0), fixedAtan2<Deg360>(0, 0).val());
+    CPPUNIT_ASSERT_EQUAL(int64_t(90), fixedAtan2<Deg360>(5, 0).val());
+    CPPUNIT_ASSERT_EQUAL(int64_t(-90), fixedAtan2<Deg180>(-5, 0).val());
+    CPPUNIT_ASSERT_EQUAL(int64_t(180), fixedAtan2<Deg180>(0, -5).val());
+    CPPUNIT_ASSERT_EQUAL(MICRO_RAD_PI / 2, fixedAtan2<Rad2Pi>(1, 0).val());
+}
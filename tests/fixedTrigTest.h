@@ -0,0 +1,51 @@
+/*
+ * File:		fixedTrigTest.h
+ * Description:         Unit tests for fixed-point trigonometry
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef FIXEDTRIGTEST_H
+#define FIXEDTRIGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class fixedTrigTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(fixedTrigTest);
+
+    CPPUNIT_TEST(degree_test);
+    CPPUNIT_TEST(radian_test);
+    CPPUNIT_TEST(atan2_test);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    fixedTrigTest();
+    virtual ~fixedTrigTest();
+    void setUp();
+    void tearDown();
+
+    private:
+    void degree_test();
+    void radian_test();
+    void atan2_test();
+};
+
+#endif /* FIXEDTRIGTEST_H */
@@ -0,0 +1,248 @@
+/*
+ * File:		floatingpointTest.cc
+ * Description:         Unit tests for floating point conversions
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "floatingpointTest.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <floatingpoint.h>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(floatingpointTest);
+
+floatingpointTest::floatingpointTest()
+{
+}
+
+floatingpointTest::~floatingpointTest()
+{
+}
+
+void floatingpointTest::setUp()
+{
+}
+
+void floatingpointTest::tearDown()
+{
+}
+
+namespace
+{
+decimal_record shortest(quadruple x)
+{
+    decimal_record reval;
+    quadruple_to_shortest_decimal(&x, &reval);
+
+    return (reval);
+}
+
+quadruple nearest(const decimal_record &d)
+{
+    quadruple reval = 0.0L;
+    decimal_to_nearest_quadruple(&reval, &d);
+
+    return (reval);
+}
+
+// reference: try increasing precision until the C library's (exact) conversion round-trips
+string referenceShortest(quadruple x, int &exponent)
+{
+    char text[64];
+    for(int precision = 1; precision <= LDBL_DECIMAL_DIG; ++precision)
+    {
+        snprintf(text, sizeof(text), "%.*Le", precision - 1, x);
+        if(strtold(text, nullptr) == x)
+            break;
+    }
+
+    string      reval;
+    const char *p = text;
+    for(; *p != 'e'; ++p)
+    {
+        if(isdigit(*p))
+            reval += *p;
+    }
+    exponent = atoi(p + 1) - int(reval.size() - 1);
+    while(reval.size() > 1 && reval.back() == '0')
+    {
+        reval.pop_back();
+        ++exponent;
+    }
+
+    return (reval);
+}
+};
+// namespace
+
+void floatingpointTest::shortest_decimal_test()
+{
+    decimal_record d = shortest(0.1L);
+    CPPUNIT_ASSERT_EQUAL(string("1"), string(d.ds));
+    CPPUNIT_ASSERT_EQUAL(-1, d.exponent);
+    CPPUNIT_ASSERT_EQUAL(1, d.ndigits);
+    CPPUNIT_ASSERT_EQUAL(0, d.sign);
+    CPPUNIT_ASSERT_EQUAL(fp_normal, d.fpclass);
+
+    d = shortest(-1234.5L);
+    CPPUNIT_ASSERT_EQUAL(string("12345"), string(d.ds));
+    CPPUNIT_ASSERT_EQUAL(-1, d.exponent);
+    CPPUNIT_ASSERT_EQUAL(1, d.sign);
+
+    d = shortest(1.0e20L);
+    CPPUNIT_ASSERT_EQUAL(string("1"), string(d.ds));
+    CPPUNIT_ASSERT_EQUAL(20, d.exponent);
+
+    d = shortest(1000203.0L);
+    CPPUNIT_ASSERT_EQUAL(string("1000203"), string(d.ds));
+    CPPUNIT_ASSERT_EQUAL(0, d.exponent);
+
+    d = shortest(numeric_limits<quadruple>::denorm_min());
+    CPPUNIT_ASSERT_EQUAL(fp_subnormal, d.fpclass);
+    CPPUNIT_ASSERT_EQUAL(1, d.ndigits);
+
+    d = shortest(0.0L);
+    CPPUNIT_ASSERT_EQUAL(fp_zero, d.fpclass);
+    CPPUNIT_ASSERT_EQUAL(string("0"), string(d.ds));
+
+    d = shortest(-numeric_limits<quadruple>::infinity());
+    CPPUNIT_ASSERT_EQUAL(fp_infinity, d.fpclass);
+    CPPUNIT_ASSERT_EQUAL(1, d.sign);
+
+    d = shortest(numeric_limits<quadruple>::quiet_NaN());
+    CPPUNIT_ASSERT_EQUAL(fp_quiet, d.fpclass);
+}
+
+void floatingpointTest::shortest_roundtrip_test()
+{
+    mt19937_64                           rng(4711);
+    uniform_real_distribution<quadruple> mantissa(1.0L, 10.0L);
+    uniform_int_distribution<int>        exponent(LDBL_MIN_10_EXP - 10, LDBL_MAX_10_EXP - 1);
+
+    for(size_t i = 0; i < 20000; ++i)
+    {
+        quadruple x = mantissa(rng) * powl(10.0L, exponent(rng));
+        if(x == 0.0L || !isfinite(x))
+            continue;
+
+        decimal_record d = shortest(x);
+        CPPUNIT_ASSERT_EQUAL(x, nearest(d));
+
+        int    refExponent = 0;
+        string ref         = referenceShortest(x, refExponent);
+        CPPUNIT_ASSERT_EQUAL(ref, string(d.ds));
+        CPPUNIT_ASSERT_EQUAL(refExponent, d.exponent);
+    }
+}
+
+void floatingpointTest::nearest_quadruple_test()
+{
+    CPPUNIT_ASSERT_EQUAL(0.1L, nearest(decimal_record(fp_normal, 0, -1, "1", 0, 1)));
+    CPPUNIT_ASSERT_EQUAL(-12.5L, nearest(decimal_record(fp_normal, 1, -1, "125", 0, 3)));
+    CPPUNIT_ASSERT_EQUAL(1.0e300L, nearest(decimal_record(fp_normal, 0, 300, "1", 0, 1)));
+    CPPUNIT_ASSERT_EQUAL(strtold("123456789012345678901234567890e-40", nullptr),
+                         nearest(decimal_record(fp_normal, 0, -40, "123456789012345678901234567890", 0, 30)));
+    CPPUNIT_ASSERT_EQUAL(0.0L, nearest(decimal_record(fp_zero)));
+    CPPUNIT_ASSERT(isinf(nearest(decimal_record(fp_infinity, 1))));
+    CPPUNIT_ASSERT(isnan(nearest(decimal_record(fp_quiet))));
+
+    // 2^64 + 1 is exactly half-way between two 64-bit significands: ties go to even unless "more"
+    // says that there are non-zero digits following
+    if(numeric_limits<quadruple>::digits == 64)
+    {
+        decimal_record tie(fp_normal, 0, 0, "18446744073709551617", 0, 20);
+        CPPUNIT_ASSERT_EQUAL(18446744073709551616.0L, nearest(tie));
+        tie.more = 1;
+        CPPUNIT_ASSERT(nearest(tie) > 18446744073709551616.0L);
+    }
+}
+
+void floatingpointTest::bulk_conversion_test()
+{
+    vector<quadruple> values = {0.1L,
+                                -1234.5L,
+                                1.0e20L,
+                                1.0e21L,
+                                0.000001L,
+                                1.5e-7L,
+                                0.0L,
+                                -0.0L,
+                                numeric_limits<quadruple>::infinity(),
+                                -numeric_limits<quadruple>::infinity(),
+                                numeric_limits<quadruple>::quiet_NaN()};
+    vector<string>    expected = {"0.1", "-1234.5", "100000000000000000000", "1e21", "0.000001", "1.5e-7",
+                                  "0", "-0", "inf", "-inf", "nan"};
+    decimal_column    column;
+    quadruples_to_decimals(values, column);
+    CPPUNIT_ASSERT_EQUAL(values.size(), column.size());
+    for(size_t i = 0; i < values.size(); i++)
+        CPPUNIT_ASSERT_EQUAL(expected[i], string(column[i]));
+
+    vector<quadruple> back(values.size());
+    decimals_to_quadruples(column, back);
+    for(size_t i = 0; i + 1 < values.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(values[i], back[i]);
+        CPPUNIT_ASSERT_EQUAL(signbit(values[i]), signbit(back[i]));
+    }
+    CPPUNIT_ASSERT(isnan(back.back()));
+
+    // big enough to be split over the thread pool
+    mt19937_64                           rng(1011);
+    uniform_real_distribution<quadruple> mantissa(-10.0L, 10.0L);
+    uniform_int_distribution<int>        exponent(-40, 40);
+    values.resize(200000);
+    for(auto &v: values)
+        v = mantissa(rng) * powl(10.0L, exponent(rng));
+    quadruples_to_decimals(values, column);
+    CPPUNIT_ASSERT_EQUAL(values.size(), column.size());
+    back.assign(values.size(), 0.0L);
+    decimals_to_quadruples(column, back);
+    CPPUNIT_ASSERT(values == back);
+    size_t totalLength = 0;
+    for(size_t i = 0; i < column.size(); i++)
+        totalLength += column[i].size();
+    CPPUNIT_ASSERT_EQUAL(column.arena().size(), totalLength);
+
+    vector<string_view> texts = {"  1", "1e", "1.5", "+.5E+1", "0.", "x", "-INFINITY", "1.2.3"};
+    vector<quadruple>   one(1);
+    for(auto t: texts)
+    {
+        bool valid = (t == "1.5" || t == "+.5E+1" || t == "0." || t == "-INFINITY");
+        if(valid)
+            decimals_to_quadruples(span<const string_view>(&t, 1), one);
+        else
+            CPPUNIT_ASSERT_THROW(decimals_to_quadruples(span<const string_view>(&t, 1), one), invalid_argument);
+    }
+    CPPUNIT_ASSERT_THROW(decimals_to_quadruples(texts, one), out_of_range);
+}
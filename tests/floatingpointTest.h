@@ -0,0 +1,53 @@
+/*
+ * File:		floatingpointTest.h
+ * Description:         Unit tests for floating point conversions
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef FLOATINGPOINTTEST_H
+#define FLOATINGPOINTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class floatingpointTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(floatingpointTest);
+
+    CPPUNIT_TEST(shortest_decimal_test);
+    CPPUNIT_TEST(shortest_roundtrip_test);
+    CPPUNIT_TEST(nearest_quadruple_test);
+    CPPUNIT_TEST(bulk_conversion_test);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    floatingpointTest();
+    virtual ~floatingpointTest();
+    void setUp();
+    void tearDown();
+
+    private:
+    void shortest_decimal_test();
+    void shortest_roundtrip_test();
+    void nearest_quadruple_test();
+    void bulk_conversion_test();
+};
+
+#endif /* FLOATINGPOINTTEST_H */
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <limited_int.h>
 #include <map>
+#include <random>
 #include <set>
 #include <sstream>
 #include <string>
@@ -659,3 +660,128 @@ void LimitedValuesTest::testDegreeConversion()
             CPPUNIT_FAIL("Rad2Pi values as value of map is invalid:" + asString(rad2Pi));
     }
 }
+
+template<typename LimitedInt_>
+void checkBulkAgainstScalar(int64_t seed)
+{
+    using T_ = decltype(LimitedInt_::min().val());
+
+    mt19937_64                   rng(seed);
+    uniform_int_distribution<T_> inRange(LimitedInt_::min().val(), LimitedInt_::max().val());
+    std::vector<LimitedInt_>     values;
+    std::vector<LimitedInt_>     operands;
+    for(size_t i = 0; i < 1001; i++)
+    {
+        values.push_back(inRange(rng));
+        operands.push_back(inRange(rng));
+    }
+    const T_ width = LimitedInt_::max().val() - LimitedInt_::min().val() + 1;
+
+    // offsets within one interval width, and far outside
+    for(T_ delta: {T_(0), T_(1), T_(-1), T_(width / 3), T_(-width + 1), T_(width * 5 + 7), T_(-width * 3 - 2)})
+    {
+        auto sum = values;
+        LimitedInt_::addAll(sum, delta);
+        auto difference = values;
+        LimitedInt_::subtractAll(difference, delta);
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            CPPUNIT_ASSERT_EQUAL(LimitedInt_(values[i].val() + delta).val(), sum[i].val());
+            CPPUNIT_ASSERT_EQUAL(LimitedInt_(values[i].val() - delta).val(), difference[i].val());
+        }
+    }
+
+    auto sum = values;
+    LimitedInt_::addAll(sum, operands);
+    auto difference = values;
+    LimitedInt_::subtractAll(difference, operands);
+    auto scaled = values;
+    LimitedInt_::scaleAll(scaled, -3);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(LimitedInt_(values[i].val() + operands[i].val()).val(), sum[i].val());
+        CPPUNIT_ASSERT_EQUAL(LimitedInt_(values[i].val() - operands[i].val()).val(), difference[i].val());
+        CPPUNIT_ASSERT_EQUAL(LimitedInt_(values[i].val() * -3).val(), scaled[i].val());
+    }
+
+    std::vector<LimitedInt_> shorter(3);
+    CPPUNIT_ASSERT_THROW(LimitedInt_::addAll(shorter, operands), invalid_argument);
+}
+
+void LimitedValuesTest::testBulkOperations()
+{
+    checkBulkAgainstScalar<Deg180>(1);
+    checkBulkAgainstScalar<Deg360>(2);
+    checkBulkAgainstScalar<Rad2Pi>(3);
+    checkBulkAgainstScalar<MilliM>(4);
+    checkBulkAgainstScalar<limited_int<int32_t, 1000, 1010>>(5);
+    checkBulkAgainstScalar<limited_int<int32_t, -150, -42>>(6);
+
+    // conversion as by the converting constructor
+    std::vector<Deg360> degrees;
+    for(int64_t d = 0; d < 360; d++)
+        degrees.push_back(d);
+    std::vector<Rad2Pi> radians(degrees.size());
+    Rad2Pi::convertAll(span<const Deg360>(degrees), radians);
+    for(size_t i = 0; i < degrees.size(); i++)
+        CPPUNIT_ASSERT_EQUAL(Rad2Pi(degrees[i]).val(), radians[i].val());
+
+    // resolve_throw: every value is processed before the exception
+    using Throwing = limited_int<int32_t, 0, 100, limited_int_traits<int32_t, 0, 100, resolve_throw, convert_scale>>;
+    std::vector<Throwing> values{10, 50, 90};
+    CPPUNIT_ASSERT_THROW(Throwing::addAll(values, 20), out_of_range);
+    CPPUNIT_ASSERT_EQUAL(30, values[0].val());
+    CPPUNIT_ASSERT_EQUAL(70, values[1].val());
+    CPPUNIT_ASSERT(!values[2].isValid());
+}
+
+void LimitedValuesTest::testConstexprConversion()
+{
+    // construction, resolution and conversion in constant expressions
+    static_assert(Deg360(int64_t(370)).val() == 10);
+    static_assert(Deg360(int64_t(-1)).val() == 359);
+    static_assert(!MilliM(FACTOR_M_TO_MM + 1).isValid());
+    static_assert(Rad2Pi(Deg360(int64_t(180))).val() == MICRO_RAD_PI);
+    static_assert(Deg360(Rad2Pi(MICRO_RAD_PI)).val() == 179);
+    static_assert(MicroM(MilliM(int64_t(500))).val() == 500'000);
+    static_assert(limited_int_ratio<MICRO_RAD_2PI_MAX + 1, 360>::num == 418'879);
+    static_assert(limited_int_ratio<MICRO_RAD_2PI_MAX + 1, 360>::den == 24);
+    static_assert(limited_int_ratio<2'000'000, 1'000>::num == 2'000 && limited_int_ratio<2'000'000, 1'000>::den == 1);
+
+    // the factor is exact: no rounding of the scale to an integer, nor long double error
+    for(int64_t r = 0; r <= MICRO_RAD_2PI_MAX; r += 997)
+    {
+        Deg360 degrees = Rad2Pi(r);
+        CPPUNIT_ASSERT_EQUAL(r * 360 / (MICRO_RAD_2PI_MAX + 1), degrees.val());
+    }
+    for(int64_t d = DEGREE_180_MIN; d <= DEGREE_180_MAX; d++)
+    {
+        Deg360 degrees = Deg180(d);
+        Deg180 back    = degrees;
+        CPPUNIT_ASSERT(degrees.val() >= DEGREE_360_MIN && degrees.val() <= DEGREE_360_MAX);
+        CPPUNIT_ASSERT(back.val() >= DEGREE_180_MIN && back.val() <= DEGREE_180_MAX);
+        CPPUNIT_ASSERT_EQUAL(d, back.val());
+    }
+    for(int64_t mm = 0; mm <= TWO_MILLION_MM_MAX; mm += 1009)
+    {
+        MilliM2Million distance = mm;
+        MicroM         scaled   = distance;
+        CPPUNIT_ASSERT_EQUAL(mm - FACTOR_M_TO_MICRO_METER, scaled.val());
+    }
+
+    // scaled values are truncated toward zero, alike for negative and positive ones
+    static_assert(MilliM(MicroM(int64_t(-1))).val() == 0);
+    static_assert(MilliM(MicroM(int64_t(-999))).val() == 0);
+    static_assert(MilliM(MicroM(int64_t(999))).val() == 0);
+    static_assert(MilliM(MicroM(int64_t(-1000))).val() == -1);
+    static_assert(MilliM(MicroM(int64_t(-1999))).val() == -1);
+    static_assert(MilliM(MicroM(int64_t(1999))).val() == 1);
+
+    // distances of the full default ranges do not overflow
+    static_assert(limited_int<int64_t, 0, 100>(limited_int<int64_t>(int64_t(0))).val() == 50);
+    static_assert(limited_int<int64_t, 0, 100>(limited_int<uint64_t>(UINT64_MAX)).val() == 100);
+    static_assert(limited_int<int64_t>(limited_int<int64_t, -100, 100>(int64_t(-100))).val() == INT64_MIN + 1);
+
+    // invalid values stay invalid
+    CPPUNIT_ASSERT(!MicroM(MilliM::invalid()).isValid());
+}
@@ -33,6 +33,8 @@ class LimitedValuesTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(testInstanciation);
     CPPUNIT_TEST(testIterator);
     CPPUNIT_TEST(testDegreeConversion);
+    CPPUNIT_TEST(testBulkOperations);
+    CPPUNIT_TEST(testConstexprConversion);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -46,6 +48,8 @@ class LimitedValuesTest : public CPPUNIT_NS::TestFixture
     void testInstanciation();
     void testIterator();
     void testDegreeConversion();
+    void testBulkOperations();
+    void testConstexprConversion();
 };
 
 #endif /* LIMITEDVALUESTEST_H */
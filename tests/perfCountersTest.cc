@@ -0,0 +1,178 @@
+/*
+ * File:		perfCountersTest.cc
+ * Description:         Unit tests for performance counter groups
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "perfCountersTest.h"
+
+#include <cstdint>
+#include <perf_counters.h>
+#include <profiling.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(perfCountersTest);
+
+perfCountersTest::perfCountersTest()
+{
+}
+
+perfCountersTest::~perfCountersTest()
+{
+}
+
+void perfCountersTest::setUp()
+{
+    resetProfile();
+}
+
+void perfCountersTest::tearDown()
+{
+}
+
+namespace
+{
+uint64_t spin(size_t iterations)
+{
+    volatile uint64_t reval = 0;
+    for(size_t i = 0; i < iterations; i++)
+        reval = reval + i * i;
+
+    return (reval);
+}
+};
+// namespace
+
+void perfCountersTest::sample_test()
+{
+    perf_sample start;
+    start.values = {100, 200, 3, 2, 1, 1000};
+    start.events = perfEventBit(PerfEvent::CYCLES) | perfEventBit(PerfEvent::INSTRUCTIONS);
+    perf_sample end = start;
+    end.values      = {150, 400, 3, 2, 1, 1000};
+
+    perf_sample diff = end - start;
+    CPPUNIT_ASSERT(diff.has(PerfEvent::CYCLES) && !diff.has(PerfEvent::TASK_CLOCK));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(50), diff[PerfEvent::CYCLES]);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(200), diff[PerfEvent::INSTRUCTIONS]);
+
+    // scaled counts may shrink between reads: the delta is 0, not a wrapped-around huge count
+    end.values[size_t(PerfEvent::CYCLES)] = 99;
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), (end - start)[PerfEvent::CYCLES]);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(200), (end - start)[PerfEvent::INSTRUCTIONS]);
+
+    // a total has the events of any of its parts
+    perf_sample total;
+    total += diff;
+    total += diff;
+    CPPUNIT_ASSERT_EQUAL(diff.events, total.events);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(400), total[PerfEvent::INSTRUCTIONS]);
+
+    CPPUNIT_ASSERT_EQUAL(string("branch-misses"), string(perfEventName(PerfEvent::BRANCH_MISSES)));
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0x3f), ALL_PERF_EVENTS);
+}
+
+void perfCountersTest::group_test()
+{
+    // nothing requested: nothing opened and nothing to explain
+    perf_counter_group none(0);
+    CPPUNIT_ASSERT(!none.available());
+    CPPUNIT_ASSERT(none.status().empty());
+    none.start();
+    CPPUNIT_ASSERT_EQUAL(uint32_t(0), none.read().events);
+
+    // hardware events are often unavailable (containers, virtual machines): either way the group
+    // must be usable and only report what it counted
+    perf_counter_group group;
+    CPPUNIT_ASSERT_EQUAL(group.available(), group.events() != 0);
+    CPPUNIT_ASSERT((group.events() & ~ALL_PERF_EVENTS) == 0);
+    CPPUNIT_ASSERT(group.events() == ALL_PERF_EVENTS || !group.status().empty());
+
+    group.start();
+    spin(1000000);
+    perf_sample first = group.read();
+    spin(1000000);
+    group.stop();
+    perf_sample second = group.read();
+    CPPUNIT_ASSERT_EQUAL(group.events(), first.events);
+    CPPUNIT_ASSERT_EQUAL(group.events(), second.events);
+    for(size_t e = 0; e < PERF_EVENT_COUNT; e++)
+    {
+        if((group.events() & perfEventBit(PerfEvent(e))) == 0)
+            CPPUNIT_ASSERT_EQUAL(uint64_t(0), second.values[e]);
+        CPPUNIT_ASSERT(second.values[e] >= first.values[e]);
+    }
+    if(group.available())
+    {
+        if(second.has(PerfEvent::INSTRUCTIONS))
+            CPPUNIT_ASSERT(second[PerfEvent::INSTRUCTIONS] > first[PerfEvent::INSTRUCTIONS] + 1000000);
+        if(second.has(PerfEvent::TASK_CLOCK))
+            CPPUNIT_ASSERT(second[PerfEvent::TASK_CLOCK] > first[PerfEvent::TASK_CLOCK]);
+
+        // stopped counters stand still
+        spin(1000000);
+        CPPUNIT_ASSERT(group.read().values == second.values);
+    }
+    CPPUNIT_ASSERT_EQUAL(group.events(), perf_counter_group().events());
+}
+
+void perfCountersTest::scope_test()
+{
+    perf_sample total;
+    {
+        scoped_perf_counters outer(total);
+        {
+            scoped_perf_counters inner(total);
+            spin(100000);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(threadPerfCounters().events(), total.events);
+    CPPUNIT_ASSERT_EQUAL(perfCountersAvailable(), total.events != 0);
+
+    for(size_t i = 0; i < 10; i++)
+    {
+        UTIL_PROFILE_COUNTERS_SCOPE("perfCountersTest.spin");
+        spin(10000);
+    }
+    auto report = profileReport();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), report.size());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(10), report.front().count);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(perfCountersAvailable() ? 10 : 0), report.front().eventScopes);
+    CPPUNIT_ASSERT_EQUAL(threadPerfCounters().events(), report.front().events.events);
+
+    // the counter table and JSON object only appear with counter values
+    ostringstream table;
+    printProfileReport(table);
+    ostringstream json;
+    printProfileReportJson(json);
+    CPPUNIT_ASSERT_EQUAL(perfCountersAvailable(), table.str().find("label (per scope)") != string::npos);
+    CPPUNIT_ASSERT_EQUAL(perfCountersAvailable(), json.str().find("\"events\": {") != string::npos);
+
+    resetProfile();
+    {
+        UTIL_PROFILE_COUNTERS_SCOPE("perfCountersTest.spin");
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(perfCountersAvailable() ? 1 : 0), profileReport().front().eventScopes);
+}
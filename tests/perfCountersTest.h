@@ -0,0 +1,51 @@
+/*
+ * File:		perfCountersTest.h
+ * Description:         Unit tests for performance counter groups
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef PERFCOUNTERSTEST_H
+#define PERFCOUNTERSTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class perfCountersTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(perfCountersTest);
+
+    CPPUNIT_TEST(sample_test);
+    CPPUNIT_TEST(group_test);
+    CPPUNIT_TEST(scope_test);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    perfCountersTest();
+    virtual ~perfCountersTest();
+    void setUp();
+    void tearDown();
+
+    private:
+    void sample_test();
+    void group_test();
+    void scope_test();
+};
+
+#endif /* PERFCOUNTERSTEST_H */
@@ -0,0 +1,189 @@
+/*
+ * File:		profilingTest.cc
+ * Description:         Unit tests for scoped timers and profile reports
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "profilingTest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <profiling.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(profilingTest);
+
+profilingTest::profilingTest()
+{
+}
+
+profilingTest::~profilingTest()
+{
+}
+
+void profilingTest::setUp()
+{
+    resetProfile();
+}
+
+void profilingTest::tearDown()
+{
+}
+
+namespace
+{
+const profile_entry *findEntry(const vector<profile_entry> &report, const string &label)
+{
+    for(const auto &e: report)
+        if(e.label == label)
+            return (&e);
+
+    return (nullptr);
+}
+
+/**
+ * Times a scope in its destructor, which runs after the counters of the thread are gone if the
+ * object was created before the first scope of the thread.
+ */
+struct late_scope
+{
+    ~late_scope()
+    {
+        UTIL_PROFILE_SCOPE("profilingTest.late");
+    }
+};
+
+void busyWait(chrono::microseconds duration)
+{
+    auto start = chrono::steady_clock::now();
+    while(chrono::steady_clock::now() - start < duration)
+        ;
+}
+};
+// namespace
+
+void profilingTest::histogram_test()
+{
+    // small values exact, then contiguous buckets with relative width below 1/16
+    for(uint64_t v = 0; v < 32; v++)
+        CPPUNIT_ASSERT_EQUAL(size_t(v), latency_histogram::bucketOf(v));
+    for(size_t b = 0; b + 1 < latency_histogram::bucketCount; b++)
+    {
+        uint64_t lower = latency_histogram::lowerBound(b);
+        uint64_t upper = latency_histogram::upperBound(b);
+        CPPUNIT_ASSERT_EQUAL(b, latency_histogram::bucketOf(lower));
+        CPPUNIT_ASSERT_EQUAL(b, latency_histogram::bucketOf(upper));
+        CPPUNIT_ASSERT_EQUAL(upper + 1, latency_histogram::lowerBound(b + 1));
+        if(lower >= 32)
+            CPPUNIT_ASSERT(double(upper - lower + 1) / double(lower) <= 1.0 / 16);
+    }
+    CPPUNIT_ASSERT_EQUAL(latency_histogram::bucketCount - 1, latency_histogram::bucketOf(UINT64_MAX));
+    CPPUNIT_ASSERT(ticksPerNanosecond() > 0.0);
+}
+
+void profilingTest::scoped_timer_test()
+{
+    // same label from different places and threads is one entry
+    auto work = []
+    {
+        for(size_t i = 0; i < 100; i++)
+        {
+            UTIL_PROFILE_SCOPE("profilingTest.loop");
+        }
+        UTIL_PROFILE_SCOPE("profilingTest.wait");
+        busyWait(chrono::microseconds(2000));
+    };
+    work();
+    vector<thread> threads;
+    for(size_t t = 0; t < 3; t++)
+        threads.emplace_back(work);
+    for(auto &t: threads)
+        t.join();
+    {
+        UTIL_PROFILE_SCOPE("profilingTest.loop");
+    }
+
+    // the counters of finished threads are kept
+    auto                 report = profileReport();
+    const profile_entry *loop   = findEntry(report, "profilingTest.loop");
+    const profile_entry *wait   = findEntry(report, "profilingTest.wait");
+    CPPUNIT_ASSERT(loop != nullptr && wait != nullptr);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(401), loop->count);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), wait->count);
+    CPPUNIT_ASSERT_EQUAL(scoped_timer<"profilingTest.loop">::site(), registerProfileSite("profilingTest.loop"));
+
+    // 2 ms each, measured within 20% (generous for loaded machines) and consistently ordered
+    CPPUNIT_ASSERT(wait->minNs >= 2e6 * 0.8);
+    CPPUNIT_ASSERT(wait->meanNs >= wait->minNs && wait->meanNs <= wait->maxNs);
+    CPPUNIT_ASSERT(wait->p50Ns >= wait->minNs && wait->p50Ns <= wait->p99Ns && wait->p99Ns <= wait->maxNs);
+    CPPUNIT_ASSERT(wait->totalNs >= 4 * wait->minNs);
+
+    // the report is sorted by total time
+    CPPUNIT_ASSERT_EQUAL(string("profilingTest.wait"), report.front().label);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(4), report.front().count);
+
+    resetProfile();
+    CPPUNIT_ASSERT(findEntry(profileReport(), "profilingTest.loop") == nullptr);
+
+    // scopes ending after the thread's counters are gone are dropped
+    thread late(
+     []
+     {
+         thread_local late_scope scope;
+         (void)scope;
+         UTIL_PROFILE_SCOPE("profilingTest.early");
+     });
+    late.join();
+    report = profileReport();
+    CPPUNIT_ASSERT(findEntry(report, "profilingTest.early") != nullptr);
+    CPPUNIT_ASSERT(findEntry(report, "profilingTest.late") == nullptr);
+}
+
+void profilingTest::report_test()
+{
+    for(size_t i = 0; i < 10; i++)
+    {
+        UTIL_PROFILE_SCOPE("profilingTest.\"quoted\"");
+    }
+
+    ostringstream table;
+    table << hex << setprecision(2) << setfill('*');
+    printProfileReport(table);
+    CPPUNIT_ASSERT(table.str().find("profilingTest.\"quoted\"") != string::npos);
+
+    // the formatting of the stream is left as it was
+    CPPUNIT_ASSERT(table.flags() == (ios_base::hex | ios_base::skipws));
+    CPPUNIT_ASSERT_EQUAL(streamsize(2), table.precision());
+    CPPUNIT_ASSERT_EQUAL('*', table.fill());
+
+    ostringstream json;
+    json << scientific;
+    printProfileReportJson(json);
+    CPPUNIT_ASSERT(json.flags() == (ios_base::scientific | ios_base::skipws | ios_base::dec));
+    CPPUNIT_ASSERT(json.str().find("\"label\": \"profilingTest.\\\"quoted\\\"\", \"count\": 10,") != string::npos);
+    CPPUNIT_ASSERT(json.str().front() == '[');
+}
@@ -0,0 +1,51 @@
+/*
+ * File:		profilingTest.h
+ * Description:         Unit tests for scoped timers and profile reports
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#ifndef PROFILINGTEST_H
+#define PROFILINGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class profilingTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(profilingTest);
+
+    CPPUNIT_TEST(histogram_test);
+    CPPUNIT_TEST(scoped_timer_test);
+    CPPUNIT_TEST(report_test);
+
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+    profilingTest();
+    virtual ~profilingTest();
+    void setUp();
+    void tearDown();
+
+    private:
+    void histogram_test();
+    void scoped_timer_test();
+    void report_test();
+};
+
+#endif /* PROFILINGTEST_H */
@@ -36,6 +36,7 @@
 #include <dateutil.h>
 #include <graphutil.h>
 #include <iostream>
+#include <iterator>
 #include <statutil.h>
 #include <string>
 #include <stringutil.h>
@@ -751,3 +752,421 @@ void stringutilTest::util_string_test()
     util_string_left_right_testT<string>();
     util_string_left_right_testT<ci_string>();
 }
+
+void stringutilTest::util_split_view_test()
+{
+    auto collect = [](auto view) {
+        vector<string> reval;
+        for(auto token: view)
+            reval.push_back(string(token));
+        return (reval);
+    };
+
+    // same tokens as the allocating splitIntoVector()
+    for(string str: {"", ",", "a", "a,b", ",a,,b,", "abc,def,ghi"})
+        CPPUNIT_ASSERT_EQUAL(splitIntoVector(str, ','), collect(splitView(str, ',')));
+    for(string str: {"", ";", "a;b,c", ";a,,b;", "a b\tc"})
+        CPPUNIT_ASSERT_EQUAL(splitIntoVector(str, string(",; \t")), collect(splitViewAnyOf(str, ",; \t")));
+
+    vector<string> expected = {"a", "b", "", "c:d", ""};
+    CPPUNIT_ASSERT_EQUAL(expected, collect(splitViewExact("a::b::::c:d::", "::")));
+    expected = {"no separator"};
+    CPPUNIT_ASSERT_EQUAL(expected, collect(splitViewExact("no separator", "")));
+
+    // iterators are forward iterators over the views
+    auto view = splitView("x,y,z", ',');
+    auto it   = view.begin();
+    auto copy = it++;
+    CPPUNIT_ASSERT(*copy == "x");
+    CPPUNIT_ASSERT(*it == "y");
+    CPPUNIT_ASSERT(it != copy);
+    CPPUNIT_ASSERT_EQUAL(ptrdiff_t(3), ranges::distance(view.begin(), view.end()));
+
+    vector<string_view> tokens;
+    string              line = "1,2,3";
+    splitIntoViews(line, ',', tokens);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), tokens.size());
+    CPPUNIT_ASSERT(tokens[2] == "3");
+    CPPUNIT_ASSERT(tokens[0].data() == line.data());
+    auto capacity = tokens.capacity();
+    splitIntoViews("4|5", any_of_separator("|"), tokens);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), tokens.size());
+    CPPUNIT_ASSERT_EQUAL(capacity, tokens.capacity());
+}
+
+void stringutilTest::util_char_class_kernels_test()
+{
+    // long enough for the 32-byte kernels, with the interesting bytes on both sides of the block edges
+    string pad(40, ' ');
+    string str = pad + "a  b\tc" + string(33, 'x') + " \xe4 " + pad;
+
+    string v = str;
+    trim(v);
+    CPPUNIT_ASSERT_EQUAL(string("a  b\tc") + string(33, 'x') + " \xe4", v);
+
+    v = str;
+    strip(v);
+    CPPUNIT_ASSERT_EQUAL(string("abc") + string(33, 'x') + "\xe4", v);
+
+    v = str;
+    strip(v, "x\xe4 \t", StripTrimMode::INSIDE);
+    CPPUNIT_ASSERT_EQUAL(string("abc"), v);
+
+    v = str;
+    replaceChar(v, " \t", '_', StripTrimMode::INSIDE);
+    CPPUNIT_ASSERT_EQUAL(pad + "a__b_c" + string(33, 'x') + "_\xe4 " + pad, v);
+
+    v = str;
+    replaceChar(v, "\xe4", '#', StripTrimMode::ALL);
+    CPPUNIT_ASSERT_EQUAL(pad + "a  b\tc" + string(33, 'x') + " # " + pad, v);
+
+    v = string(100, ' ');
+    strip(v);
+    CPPUNIT_ASSERT(v.empty());
+    v = string(100, ' ');
+    replaceChar(v, " ", '-', StripTrimMode::FRONT);
+    CPPUNIT_ASSERT_EQUAL(string(100, '-'), v);
+
+    // case-insensitive strings strip both cases
+    ci_string ci = ci_string(40, 'A') + "bcd" + ci_string(40, 'a');
+    strip(ci, "a");
+    CPPUNIT_ASSERT(ci == "BCD");
+
+    string mixed = "Hello, World! [\xc4] " + string(64, 'Q') + "z@`{";
+    toLowerInPlace(mixed);
+    CPPUNIT_ASSERT_EQUAL("hello, world! [\xc4] " + string(64, 'q') + "z@`{", mixed);
+    toUpperInPlace(mixed);
+    CPPUNIT_ASSERT_EQUAL("HELLO, WORLD! [\xc4] " + string(64, 'Q') + "Z@`{", mixed);
+    CPPUNIT_ASSERT_EQUAL(string("abc"), toLower(ci_string("AbC")));
+}
+
+void stringutilTest::util_ci_fold_test()
+{
+    // the word-at-a-time fold agrees with the table for every byte in every position
+    for(unsigned int c = 0; c < 256; c++)
+    {
+        uint64_t w = 0x0101010101010101ULL * c;
+        CPPUNIT_ASSERT_EQUAL(0x0101010101010101ULL * ciFold(char(c)), ciFoldWord(w));
+        CPPUNIT_ASSERT_EQUAL(uint64_t(ciFold(char(c))) << 40, ciFoldWord(uint64_t(c) << 40));
+    }
+    CPPUNIT_ASSERT_EQUAL(int('A'), int(ciFold('a')));
+    CPPUNIT_ASSERT_EQUAL(int('@'), int(ciFold('@')));
+    CPPUNIT_ASSERT_EQUAL(int('['), int(ciFold('[')));
+    CPPUNIT_ASSERT_EQUAL(int(0xE4), int(ciFold(char(0xE4))));
+
+    // compare() keeps its contract: sign and 1-based position of the first difference
+    CPPUNIT_ASSERT_EQUAL(0, ci_char_traits::compare("Hello World, how are you", "hELLO wORLD, HOW ARE YOU", 24));
+    CPPUNIT_ASSERT_EQUAL(-18, ci_char_traits::compare("Hello World, how are you", "hELLO wORLD, HOW BRE YOU", 24));
+    CPPUNIT_ASSERT_EQUAL(18, ci_char_traits::compare("Hello World, how cre you", "hELLO wORLD, HOW BRE YOU", 24));
+    CPPUNIT_ASSERT_EQUAL(0, ci_char_traits::compare("abcdefgh\0xyz", "ABCDEFGH\0uvw", 12));
+    CPPUNIT_ASSERT(ci_string("Some Longer Key 12345") == ci_string("sOME lONGER kEY 12345"));
+    CPPUNIT_ASSERT(ci_string("Some Longer Key 12345") < ci_string("sOME lONGER kEY 12346"));
+    CPPUNIT_ASSERT_EQUAL(ci_string::size_type(12), ci_string("Some Longer Key").find('k'));
+
+    // hashes agree for strings that compare equal
+    hash<ci_string> hasher;
+    for(string key: {"", "a", "Key", "exactly8", "a key of some length", "MiXeD-CaSe_With.Punctuation"})
+    {
+        ci_string lower(toLower(key).c_str());
+        ci_string upper(toUpper(key).c_str());
+        CPPUNIT_ASSERT_EQUAL(hasher(lower), hasher(upper));
+        CPPUNIT_ASSERT_EQUAL(hasher(lower), hasher(ci_string(key.c_str())));
+    }
+    CPPUNIT_ASSERT(hasher(ci_string("key1")) != hasher(ci_string("key2")));
+
+    unordered_map<ci_string, int> map = {{"True", 1}, {"FALSE", 0}};
+    CPPUNIT_ASSERT_EQUAL(1, map["tRuE"]);
+    CPPUNIT_ASSERT_EQUAL(0, map["false"]);
+}
+
+void stringutilTest::util_number_lexer_test()
+{
+    NumberValue value;
+
+    // malformed strings are not numbers, whatever characters they consist of
+    for(string str: {"", "-", "+", ".", "L", "l5", "1-2-3", "--1", "1.2.3", "1e", "1e+", "1e5e5", "1 ", "0x10", "abc"})
+    {
+        CPPUNIT_ASSERT_EQUAL(NONE, scanNumberString(str, value));
+        CPPUNIT_ASSERT_EQUAL(NONE, classifyNumberString(str));
+    }
+
+    // integers are classified by value, not length
+    CPPUNIT_ASSERT_EQUAL(INT, scanNumberString("-9223372036854775808", value));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<int64_t>::min(), value.intValue);
+    CPPUNIT_ASSERT_EQUAL(INT, scanNumberString("+9223372036854775807", value));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<int64_t>::max(), value.intValue);
+    CPPUNIT_ASSERT_EQUAL(INT, scanNumberString("00012L", value));
+    CPPUNIT_ASSERT_EQUAL(int64_t(12), value.intValue);
+    CPPUNIT_ASSERT_EQUAL(UINT, scanNumberString("9223372036854775808", value));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(9223372036854775808UL), value.uintValue);
+    CPPUNIT_ASSERT_EQUAL(UINT, scanNumberString("18446744073709551615", value));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<uint64_t>::max(), value.uintValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("18446744073709551616", value));
+    CPPUNIT_ASSERT_EQUAL(18446744073709551616.0L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("-9223372036854775809", value));
+    CPPUNIT_ASSERT_EQUAL(-9223372036854775809.0L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(INT, classifyNumberString(ci_string("-1234567890123456789")));
+
+    // floats are correctly rounded, on the fast path and beyond it
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("1E5", value));
+    CPPUNIT_ASSERT_EQUAL(1e5L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString(".5", value));
+    CPPUNIT_ASSERT_EQUAL(0.5L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("-5.", value));
+    CPPUNIT_ASSERT_EQUAL(-5.0L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("3.14159265358979323846264338", value));
+    CPPUNIT_ASSERT_EQUAL(3.14159265358979323846264338L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("0.000000000000000000000000000000001", value));
+    CPPUNIT_ASSERT_EQUAL(1e-33L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("1e5000", value));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<long double>::infinity(), value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("1e-5000", value));
+    CPPUNIT_ASSERT_EQUAL(0.0L, value.floatValue);
+
+    // the magnitude of long numbers comes from their digits, not only from the exponent
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString(string(5000, '9'), value));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<long double>::infinity(), value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("-1" + string(5000, '0') + ".0", value));
+    CPPUNIT_ASSERT_EQUAL(-numeric_limits<long double>::infinity(), value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("1" + string(5000, '0') + "e-10000", value));
+    CPPUNIT_ASSERT_EQUAL(0.0L, value.floatValue);
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString("0." + string(5000, '0') + "1", value));
+    CPPUNIT_ASSERT_EQUAL(0.0L, value.floatValue);
+    for(string str: {"0.1", "2.5e-7", "123456.789e3", "9007199254740993.0", "1.7976931348623157e308", "4.9e-324"})
+    {
+        CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberString(str, value));
+        CPPUNIT_ASSERT_EQUAL(strtold(str.c_str(), nullptr), value.floatValue);
+    }
+
+    // columns take the narrowest class that holds every cell
+    vector<NumberValue> values;
+    vector<string_view> cells = {"1", "-2", "3"};
+    CPPUNIT_ASSERT_EQUAL(INT, scanNumberStrings(cells, values));
+    CPPUNIT_ASSERT_EQUAL(int64_t(-2), values[1].intValue);
+    cells = {"1", "18446744073709551615"};
+    CPPUNIT_ASSERT_EQUAL(UINT, scanNumberStrings(cells, values));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), values[0].uintValue);
+    cells = {"-1", "18446744073709551615"};
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberStrings(cells, values));
+    CPPUNIT_ASSERT_EQUAL(-1.0L, values[0].floatValue);
+    CPPUNIT_ASSERT_EQUAL(INT, values[0].numberClass);
+    cells = {"1.5", "2"};
+    CPPUNIT_ASSERT_EQUAL(FLOAT, scanNumberStrings(cells, values));
+    CPPUNIT_ASSERT_EQUAL(2.0L, values[1].floatValue);
+    cells = {"1", "x"};
+    CPPUNIT_ASSERT_EQUAL(NONE, scanNumberStrings(cells, values));
+    cells.clear();
+    CPPUNIT_ASSERT_EQUAL(NONE, scanNumberStrings(cells, values));
+    CPPUNIT_ASSERT(values.empty());
+}
+
+void stringutilTest::util_bool_token_test()
+{
+    bool result = false;
+
+    for(string token: {"true", "TRUE", "tRuE", "t", "yes", "Y", "1", "on", "On"})
+    {
+        result = false;
+        CPPUNIT_ASSERT(scanBoolString(token, result));
+        CPPUNIT_ASSERT(result);
+    }
+    for(string token: {"false", "F", "no", "n", "0", "off", "OFF"})
+    {
+        result = true;
+        CPPUNIT_ASSERT(scanBoolString(token, result));
+        CPPUNIT_ASSERT(!result);
+    }
+    for(string token: vector<string>{"", "tru", "truex", "of", "onn", "2", "yes ", string("t\0", 2), "ja"})
+    {
+        result = true;
+        CPPUNIT_ASSERT(!scanBoolString(token, result));
+        CPPUNIT_ASSERT(!result);
+    }
+    CPPUNIT_ASSERT(scanBoolString(ci_string("Yes"), result));
+    CPPUNIT_ASSERT(result);
+
+    addBoolToken("Ja", true);
+    addBoolToken("nein", false);
+    addBoolToken("enabled", true);
+    addBoolToken("yes", true);
+    CPPUNIT_ASSERT(scanBoolString(string("JA"), result));
+    CPPUNIT_ASSERT(result);
+    CPPUNIT_ASSERT(scanBoolString(string("Nein"), result));
+    CPPUNIT_ASSERT(!result);
+    CPPUNIT_ASSERT(scanBoolString(ci_string("ENABLED"), result));
+    CPPUNIT_ASSERT(result);
+    CPPUNIT_ASSERT(!scanBoolString(string("jaa"), result));
+    addBoolToken("JA", false);
+    CPPUNIT_ASSERT(scanBoolString(string("ja"), result));
+    CPPUNIT_ASSERT(!result);
+    CPPUNIT_ASSERT_THROW(addBoolToken("no", true), invalid_argument);
+    CPPUNIT_ASSERT_THROW(addBoolToken("", true), invalid_argument);
+
+    resetBoolTokens();
+    CPPUNIT_ASSERT(!scanBoolString(string("ja"), result));
+    CPPUNIT_ASSERT(scanBoolString(string("no"), result));
+}
+
+void stringutilTest::util_aho_corasick_test()
+{
+    aho_corasick ac({"he", "she", "his", "hers"});
+    CPPUNIT_ASSERT_EQUAL(size_t(4), ac.patternCount());
+    CPPUNIT_ASSERT(!ac.caseInsensitive());
+
+    // overlapping matches, by end position and longest first
+    vector<substring_match> expected = {{1, 1}, {0, 2}, {3, 2}};
+    CPPUNIT_ASSERT(ac.findAll("ushers") == expected);
+    CPPUNIT_ASSERT(ac.findAll("USHERS").empty());
+    CPPUNIT_ASSERT(ac.containsAny("this"));
+    CPPUNIT_ASSERT(!ac.containsAny("tho"));
+    CPPUNIT_ASSERT(ac.findAll("").empty());
+
+    // case-insensitive, with duplicate and nested patterns
+    aho_corasick ci({"ERROR", "error", "Err", "rr"}, true);
+    expected = {{2, 0}, {3, 1}, {2, 5}, {3, 6}, {0, 5}, {1, 5}};
+    CPPUNIT_ASSERT(ci.findAll("ErR: eRRoR") == expected);
+
+    // the result does not depend on how the text is cut into buffers
+    string text = "the error rate hers his shehers";
+    for(size_t cut = 1; cut <= text.size(); cut++)
+    {
+        vector<substring_match> streamed;
+        aho_corasick::stream    matcher(ac);
+        for(size_t pos = 0; pos < text.size(); pos += cut)
+            matcher.feed(string_view(text).substr(pos, cut),
+                         [&streamed](const substring_match &m) { streamed.push_back(m); });
+        CPPUNIT_ASSERT(streamed == ac.findAll(text));
+        CPPUNIT_ASSERT_EQUAL(text.size(), matcher.offset());
+        matcher.reset();
+        CPPUNIT_ASSERT_EQUAL(size_t(0), matcher.offset());
+    }
+
+    // compare with string::find for all occurrences of each pattern
+    vector<string> keywords = {"rate", "he", "his", "e", "error"};
+    aho_corasick   kw(keywords);
+    size_t         found = 0;
+    for(const auto &keyword: keywords)
+    {
+        for(size_t pos = text.find(keyword); pos != string::npos; pos = text.find(keyword, pos + 1))
+            found++;
+    }
+    CPPUNIT_ASSERT_EQUAL(found, kw.findAll(text).size());
+
+    CPPUNIT_ASSERT_THROW(aho_corasick({"a", ""}), invalid_argument);
+}
+
+namespace
+{
+template<typename T_>
+string streamed(const T_ &v)
+{
+    stringstream ss;
+    ss << v;
+
+    return (ss.str());
+}
+};
+// namespace
+
+void stringutilTest::util_string_builder_test()
+{
+    // same text as the stream operators with default settings
+    CPPUNIT_ASSERT_EQUAL(streamed(-1234567890123LL), asString(-1234567890123LL));
+    CPPUNIT_ASSERT_EQUAL(streamed(3.14159265), asString(3.14159265));
+    CPPUNIT_ASSERT_EQUAL(streamed(1e21), asString(1e21));
+    CPPUNIT_ASSERT_EQUAL(streamed(-0.0), asString(-0.0));
+    CPPUNIT_ASSERT_EQUAL(streamed(1.0L / 3), asString(1.0L / 3));
+    CPPUNIT_ASSERT_EQUAL(streamed(2.5f), asString(2.5f));
+    CPPUNIT_ASSERT_EQUAL(streamed(true), asString(true));
+    CPPUNIT_ASSERT_EQUAL(streamed('c'), asString('c'));
+    CPPUNIT_ASSERT_EQUAL(streamed(ci_string("AbC")), asString(ci_string("AbC")));
+
+    vector<int> vec = {1, 2, 3};
+    CPPUNIT_ASSERT_EQUAL(streamed(vec), asString(vec));
+    CPPUNIT_ASSERT_EQUAL(streamed(vector<int>()), asString(vector<int>()));
+    deque<double> deq = {1.5, 2};
+    CPPUNIT_ASSERT_EQUAL(streamed(deq), asString(deq));
+    set<string> strSet = {"a", "b"};
+    CPPUNIT_ASSERT_EQUAL(streamed(strSet), asString(strSet));
+    map<int, vector<double>> nested = {{1, {1.5, 2.25}}, {2, {}}};
+    CPPUNIT_ASSERT_EQUAL(streamed(nested), asString(nested));
+    CPPUNIT_ASSERT_EQUAL(string("[ (1->< 1.5 | 2.25 >) (2->< >) ]"), asString(nested));
+    unordered_map<string, int> uMap = {{"k", 1}};
+    CPPUNIT_ASSERT_EQUAL(streamed(uMap), asString(uMap));
+    unordered_set<int> uSet = {4};
+    CPPUNIT_ASSERT_EQUAL(streamed(uSet), asString(uSet));
+    CPPUNIT_ASSERT_EQUAL(string("(* 1.5 < 2 *)"), streamed(deq));
+    CPPUNIT_ASSERT_EQUAL(string("{ a, b } {~ 4 ~} [ ]"),
+                         streamed(strSet) + " " + streamed(uSet) + " " + streamed(map<int, int>()));
+
+    // the helpers, appending and returning strings
+    CPPUNIT_ASSERT_EQUAL(string("{5}"), braced(5));
+    CPPUNIT_ASSERT_EQUAL(string("[< 1 >]"), bracketed(vector<int>{1}));
+    CPPUNIT_ASSERT_EQUAL(string("<a>"), angled("a"));
+    CPPUNIT_ASSERT_EQUAL(string("(2.5)"), roundBraced(2.5));
+    CPPUNIT_ASSERT_EQUAL(string("'x'"), squoted('x'));
+    CPPUNIT_ASSERT_EQUAL(string("|s|"), enclosed(string("s"), "|"));
+
+    string_builder sb(4);
+    util::quoted(sb, 1) << ' ';
+    braced(sb, map<int, int>{{1, 2}});
+    sb << ' ' << string_view("sv") << ' ' << numeric_limits<long long>::min();
+    string expected = "\"1\" {[ (1->2) ]} sv -9223372036854775808";
+    CPPUNIT_ASSERT_EQUAL(expected, string(sb.view()));
+    CPPUNIT_ASSERT_EQUAL(expected.size(), sb.size());
+    CPPUNIT_ASSERT_EQUAL(expected, std::move(sb).str());
+
+    string_builder reused;
+    reused << 1;
+    reused.clear();
+    CPPUNIT_ASSERT(reused.empty());
+    reused << 2 << '/' << 3;
+    CPPUNIT_ASSERT_EQUAL(string("2/3"), reused.str());
+}
+
+void stringutilTest::util_utf8_test()
+{
+    CPPUNIT_ASSERT(isValidUtf8(""));
+    CPPUNIT_ASSERT(isValidUtf8("plain ASCII text that is longer than one vector of 32 bytes"));
+    CPPUNIT_ASSERT(isValidUtf8("Gr\u00fc\u00dfe \u03a3\u03c9 \u20ac \U0001F600"));
+    CPPUNIT_ASSERT_EQUAL(string_view::npos, findInvalidUtf8("\xF4\x8F\xBF\xBF"));  // U+10FFFF
+
+    // offset of the first bad byte, also behind a long ASCII run
+    string ascii(70, 'x');
+    CPPUNIT_ASSERT_EQUAL(size_t(70), findInvalidUtf8(ascii + "\x80"));
+    CPPUNIT_ASSERT_EQUAL(size_t(72), findInvalidUtf8(ascii + "\xC3\xA4\xC3"));  // truncated
+    CPPUNIT_ASSERT_EQUAL(size_t(1), findInvalidUtf8("a\xC0\xAF"));               // overlong '/'
+    CPPUNIT_ASSERT_EQUAL(size_t(0), findInvalidUtf8("\xE0\x80\xAF"));           // overlong
+    CPPUNIT_ASSERT_EQUAL(size_t(0), findInvalidUtf8("\xED\xA0\x80"));           // surrogate
+    CPPUNIT_ASSERT_EQUAL(size_t(0), findInvalidUtf8("\xF4\x90\x80\x80"));       // > U+10FFFF
+    CPPUNIT_ASSERT_EQUAL(size_t(0), findInvalidUtf8("\xF8\x88\x80\x80\x80"));   // 5 bytes
+    CPPUNIT_ASSERT_EQUAL(size_t(2), findInvalidUtf8("\xC3\xA4\xE2\x82"));
+
+    CPPUNIT_ASSERT_EQUAL(ascii + "abc", utf8ToLower(string(70, 'X') + "aBc"));
+    CPPUNIT_ASSERT_EQUAL(string("stra\u00dfe \u00e4\u00f6\u00fc \u00ff i"),
+                         utf8ToLower("STRA\u00dfE \u00c4\u00d6\u00dc \u0178 \u0130"));
+    CPPUNIT_ASSERT_EQUAL(string("STRA\u00dfE \u00c4\u00d6\u00dc \u0178 I \u039c"),
+                         utf8ToUpper("stra\u00dfe \u00e4\u00f6\u00fc \u00ff \u0131 \u00b5"));
+    CPPUNIT_ASSERT_EQUAL(string("\u0161\u0107\u0142 \u01ce \u1ea1"), utf8ToLower("\u0160\u0106\u0141 \u01cd \u1ea0"));
+    CPPUNIT_ASSERT_EQUAL(string("\u0160\u0106\u0141 \u01cd \u1ea0"), utf8ToUpper("\u0161\u0107\u0142 \u01ce \u1ea1"));
+    CPPUNIT_ASSERT_EQUAL(string("\u03c3\u03af\u03c3\u03c5\u03c6\u03bf\u03c3"),
+                         utf8ToLower("\u03a3\u038a\u03a3\u03a5\u03a6\u039f\u03a3"));
+    CPPUNIT_ASSERT_EQUAL(string("\u041f\u0420\u0418\u0412\u0415\u0422 \u0401"),
+                         utf8ToUpper("\u043f\u0440\u0438\u0432\u0435\u0442 \u0451"));
+    CPPUNIT_ASSERT_EQUAL(string("\u0561\uff41"), utf8ToLower("\u0531\uff21"));
+
+    // the length in bytes may change, invalid bytes are kept
+    CPPUNIT_ASSERT_EQUAL(string("i"), utf8ToLower("\u0130"));
+    CPPUNIT_ASSERT_EQUAL(string("a\xFF\u00e4\xC3"), utf8ToLower("A\xFF\u00c4\xC3"));
+
+    // folding unifies the sigmas and long s
+    CPPUNIT_ASSERT_EQUAL(utf8FoldCase("\u03a3"), utf8FoldCase("\u03c2"));
+    CPPUNIT_ASSERT_EQUAL(string("ss"), utf8FoldCase("\u017fS"));
+    CPPUNIT_ASSERT(utf8EqualsIgnoreCase("Gr\u00fc\u00dfe aus M\u00fcnchen, \u039f\u0394\u03a5\u03a3\u03a3\u0395\u03a5\u03a3",
+                                        "GR\u00dc\u00dfE AUS m\u00dcNCHEN, \u03bf\u03b4\u03c5\u03c3\u03c3\u03b5\u03c5\u03c2"));
+    CPPUNIT_ASSERT(utf8EqualsIgnoreCase("\u017fome longer ASCII text", "Some LONGER ascii TEXT"));
+    CPPUNIT_ASSERT(!utf8EqualsIgnoreCase("Stra\u00dfe", "STRASSE"));  // no multi-letter folding
+    CPPUNIT_ASSERT(!utf8EqualsIgnoreCase("abc", "abcd"));
+    CPPUNIT_ASSERT(!utf8EqualsIgnoreCase("\xFF", "\xFE"));
+    CPPUNIT_ASSERT(utf8EqualsIgnoreCase("A\xFF", "a\xFF"));
+}
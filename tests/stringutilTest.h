@@ -34,6 +34,14 @@ class stringutilTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(util_container_conversion_test);
     CPPUNIT_TEST(util_string_test);
     CPPUNIT_TEST(util_ci_string_test);
+    CPPUNIT_TEST(util_split_view_test);
+    CPPUNIT_TEST(util_char_class_kernels_test);
+    CPPUNIT_TEST(util_ci_fold_test);
+    CPPUNIT_TEST(util_number_lexer_test);
+    CPPUNIT_TEST(util_bool_token_test);
+    CPPUNIT_TEST(util_aho_corasick_test);
+    CPPUNIT_TEST(util_string_builder_test);
+    CPPUNIT_TEST(util_utf8_test);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -48,6 +56,14 @@ class stringutilTest : public CPPUNIT_NS::TestFixture
     void util_container_conversion_test();
     void util_string_test();
     void util_ci_string_test();
+    void util_split_view_test();
+    void util_char_class_kernels_test();
+    void util_ci_fold_test();
+    void util_number_lexer_test();
+    void util_bool_token_test();
+    void util_aho_corasick_test();
+    void util_string_builder_test();
+    void util_utf8_test();
 };
 
 #endif /* STRINGUTILTEST_H */
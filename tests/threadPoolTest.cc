@@ -0,0 +1,122 @@
+/*
+ * File:		threadPoolTest.cc
+ * Description:         Unit tests for the thread pool
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "threadPoolTest.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread_pool.h>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(threadPoolTest);
+
+threadPoolTest::threadPoolTest()
+{
+}
+
+threadPoolTest::~threadPoolTest()
+{
+}
+
+void threadPoolTest::setUp()
+{
+}
+
+void threadPoolTest::tearDown()
+{
+}
+
+void threadPoolTest::submit_test()
+{
+    thread_pool pool(3);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), pool.size());
+
+    vector<future<int>> results;
+    for(int i = 0; i < 100; i++)
+        results.push_back(pool.submit([i] { return (i * i); }));
+    for(int i = 0; i < 100; i++)
+        CPPUNIT_ASSERT_EQUAL(i * i, results[i].get());
+
+    auto failing = pool.submit([]() -> int { throw runtime_error("expected"); });
+    CPPUNIT_ASSERT_THROW(failing.get(), runtime_error);
+}
+
+void threadPoolTest::parallel_for_test()
+{
+    thread_pool pool(4);
+
+    for(size_t n: {size_t(0), size_t(1), size_t(999), size_t(100000)})
+    {
+        vector<int>    hits(n, 0);
+        atomic<size_t> calls{0};
+        pool.parallelFor(n,
+                         1000,
+                         [&](size_t begin, size_t end)
+                         {
+                             ++calls;
+                             for(size_t i = begin; i < end; i++)
+                                 hits[i]++;
+                         });
+        for(auto h: hits)
+            CPPUNIT_ASSERT_EQUAL(1, h);
+        CPPUNIT_ASSERT(calls <= pool.size() + 1);
+    }
+
+    CPPUNIT_ASSERT_THROW(pool.parallelFor(100000,
+                                          10,
+                                          [](size_t begin, size_t)
+                                          {
+                                              if(begin > 0)
+                                                  throw out_of_range("expected");
+                                          }),
+                         out_of_range);
+}
+
+void threadPoolTest::nested_test()
+{
+    // a parallelFor() on the only worker would wait forever for its own queue
+    thread_pool pool(1);
+    CPPUNIT_ASSERT(!pool.inWorker());
+
+    vector<int> hits(100000, 0);
+    auto        done = pool.submit(
+        [&]
+        {
+            CPPUNIT_ASSERT(pool.inWorker());
+            CPPUNIT_ASSERT(!thread_pool::shared().inWorker());
+            pool.parallelFor(hits.size(),
+                             10,
+                             [&](size_t begin, size_t end)
+                             {
+                                 for(size_t i = begin; i < end; i++)
+                                     hits[i]++;
+                             });
+        });
+    done.get();
+    for(auto h: hits)
+        CPPUNIT_ASSERT_EQUAL(1, h);
+}
@@ -24,11 +24,22 @@
 #include "tinyTeaTest.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <stringutil.h>
+#include <thread_pool.h>
 #include <tinytea.h>
+#include <vector>
 
 using namespace std;
 using namespace util;
@@ -78,3 +89,243 @@ void tinyTeaTest::encryption_test()
     //    cout << (string)encStr << endl;
     //    cout << multiTea<string>::decrypt(encStr, "hasdkjghfdskjghlsdk") << endl;
 }
+
+void tinyTeaTest::xtea_test()
+{
+    // published test vectors: all zero for TEA; key 00 01 .. 0f, plain text "ABCDEFGH" for XTEA
+    CPPUNIT_ASSERT_EQUAL(0x94BAA94041EA3A0AULL, (unsigned long long)tinyTea<>::encrypt(0ULL, 0ULL, 0ULL));
+    CPPUNIT_ASSERT_EQUAL(0x72612CB5497DF3D0ULL,
+                         (unsigned long long)tinyXtea<>::encrypt(0x4546474841424344ULL,
+                                                                 0x0405060700010203ULL,
+                                                                 0x0C0D0E0F08090A0BULL));
+
+    vector<uint64_t> keys = {1701ULL, 666ULL, 0xFFFFFFFFFFFFFFFFULL};
+    for(uint64_t val = 0ULL; val < 10000ULL; val += 131ULL)
+    {
+        for(auto key1: keys)
+        {
+            for(auto key2: keys)
+            {
+                uint64_t enc = tinyXtea<>::encrypt(val, key1, key2);
+                CPPUNIT_ASSERT(enc != val);
+                CPPUNIT_ASSERT_EQUAL(val, tinyXtea<>::decrypt(enc, key1, key2));
+            }
+        }
+    }
+}
+
+void tinyTeaTest::counter_mode_test()
+{
+    const uint64_t key1  = 0x0123456789ABCDEFULL;
+    const uint64_t key2  = 0xFEDCBA9876543210ULL;
+    const uint64_t nonce = 0xDEADBEEF00000000ULL;
+
+    for(auto variant: {TeaVariant::TEA, TeaVariant::XTEA})
+    {
+        tea_ctr cipher(key1, key2, nonce, variant);
+
+        // the key stream is the encrypted counter
+        vector<uint64_t> stream(19);
+        cipher.keyStream(5, stream);
+        for(size_t i = 0; i < stream.size(); i++)
+        {
+            uint64_t expected = variant == TeaVariant::TEA ? uint64_t(tinyTea<>::encrypt(nonce + 5 + i, key1, key2)) :
+                                                             tinyXtea<>::encrypt(nonce + 5 + i, key1, key2);
+            CPPUNIT_ASSERT_EQUAL(expected, stream[i]);
+        }
+
+        // any length, and decryption is encryption
+        vector<byte> plain(1000);
+        for(size_t i = 0; i < plain.size(); i++)
+            plain[i] = byte(i * 31);
+        vector<byte> data = plain;
+        cipher.apply(data);
+        CPPUNIT_ASSERT(data != plain);
+        uint64_t first = stream[0];
+        cipher.keyStream(0, span<uint64_t>(&first, 1));
+        for(size_t i = 0; i < sizeof(first); i++)
+            CPPUNIT_ASSERT(data[i] == (plain[i] ^ byte(first >> (8 * i))));
+        cipher.apply(data);
+        CPPUNIT_ASSERT(data == plain);
+
+        // parts of the stream can be processed separately, at unaligned offsets
+        vector<byte> whole = plain;
+        cipher.apply(whole);
+        vector<byte> parts(plain.size());
+        cipher.apply(span<const byte>(plain).first(13), span<byte>(parts).first(13), 0);
+        cipher.apply(span<const byte>(plain).subspan(13, 500), span<byte>(parts).subspan(13, 500), 13);
+        cipher.apply(span<const byte>(plain).subspan(513), span<byte>(parts).subspan(513), 513);
+        CPPUNIT_ASSERT(parts == whole);
+
+        // large buffers are split across threads
+        vector<byte> large(3 << 20);
+        for(size_t i = 0; i < large.size(); i++)
+            large[i] = byte(i);
+        vector<byte> encrypted = large;
+        cipher.apply(encrypted, 7);
+        vector<byte> middle(encrypted.begin() + 2000001, encrypted.begin() + 2000101);
+        cipher.apply(middle, 7 + 2000001);
+        CPPUNIT_ASSERT(equal(middle.begin(), middle.end(), large.begin() + 2000001));
+        cipher.apply(encrypted, 7);
+        CPPUNIT_ASSERT(encrypted == large);
+    }
+
+    tea_ctr      cipher(key1, key2, nonce);
+    vector<byte> in(10);
+    vector<byte> out(11);
+    CPPUNIT_ASSERT_THROW(cipher.apply(in, out), invalid_argument);
+}
+
+void tinyTeaTest::kernel_test()
+{
+    CPPUNIT_ASSERT(teaKernelSupported(TeaKernel::SCALAR));
+    CPPUNIT_ASSERT(teaKernelSupported(bestTeaKernel()));
+
+    // every kernel bit-exact with tinyTea/tinyXtea, including the blocks after the last full stride
+    mt19937_64 rng(1024);
+    for(auto kernel: {TeaKernel::SCALAR, TeaKernel::SSE2, TeaKernel::AVX2})
+    {
+        if(!teaKernelSupported(kernel))
+        {
+            vector<uint64_t> block(1);
+            CPPUNIT_ASSERT_THROW(teaEncryptBlocks(block, 1ULL, 2ULL, TeaVariant::TEA, kernel), invalid_argument);
+            continue;
+        }
+
+        for(size_t n: {0UL, 1UL, 15UL, 16UL, 17UL, 100UL})
+        {
+            uint64_t         key1 = rng();
+            uint64_t         key2 = rng();
+            vector<uint64_t> plain(n);
+            for(auto &p: plain)
+                p = rng();
+
+            for(auto variant: {TeaVariant::TEA, TeaVariant::XTEA})
+            {
+                vector<uint64_t> blocks = plain;
+                teaEncryptBlocks(blocks, key1, key2, variant, kernel);
+                for(size_t i = 0; i < n; i++)
+                {
+                    uint64_t expected = variant == TeaVariant::TEA ? uint64_t(tinyTea<>::encrypt(plain[i], key1, key2)) :
+                                                                     tinyXtea<>::encrypt(plain[i], key1, key2);
+                    CPPUNIT_ASSERT_EQUAL(expected, blocks[i]);
+                }
+                teaDecryptBlocks(blocks, key1, key2, variant, kernel);
+                CPPUNIT_ASSERT(blocks == plain);
+            }
+        }
+
+        // counter mode with this kernel gives the same stream as with the scalar one
+        tea_ctr      reference(3ULL, 4ULL, 5ULL, TeaVariant::XTEA, TeaKernel::SCALAR);
+        tea_ctr      cipher(3ULL, 4ULL, 5ULL, TeaVariant::XTEA, kernel);
+        vector<byte> a(777, byte(0x5A));
+        vector<byte> b = a;
+        reference.apply(a, 3);
+        cipher.apply(b, 3);
+        CPPUNIT_ASSERT(a == b);
+    }
+}
+
+void tinyTeaTest::file_cipher_test()
+{
+    const uint64_t key1  = 0x0123456789ABCDEFULL;
+    const uint64_t key2  = 0xFEDCBA9876543210ULL;
+    const uint64_t nonce = 0x1122334455667788ULL;
+
+    // empty, shorter than, exactly and not quite a multiple of the chunk size
+    for(auto variant: {TeaVariant::TEA, TeaVariant::XTEA})
+    {
+        tea_file_cipher cipher(key1, key2, variant, 1000);
+        for(size_t size: {0UL, 1UL, 999UL, 1000UL, 1001UL, 3000UL, 64005UL})
+        {
+            string plain(size, '\0');
+            for(size_t i = 0; i < size; i++)
+                plain[i] = char(i * 7 + size);
+
+            istringstream plainIn(plain);
+            ostringstream encryptedOut;
+            CPPUNIT_ASSERT_EQUAL(uint64_t(size), cipher.encryptStream(plainIn, encryptedOut, nonce));
+            string encrypted = encryptedOut.str();
+            CPPUNIT_ASSERT_EQUAL(tea_file_cipher::headerSize + size, encrypted.size());
+            CPPUNIT_ASSERT_EQUAL(string("UTEA"), encrypted.substr(0, 4));
+
+            // the body is the counter mode encryption of the whole plain text
+            vector<byte> expected(size);
+            memcpy(expected.data(), plain.data(), size);
+            tea_ctr(key1, key2, nonce, variant).apply(expected);
+            CPPUNIT_ASSERT(memcmp(expected.data(), encrypted.data() + tea_file_cipher::headerSize, size) == 0);
+
+            // the variant is taken from the header, the chunk size need not match
+            istringstream encryptedIn(encrypted);
+            ostringstream decryptedOut;
+            tea_file_cipher decipher(key1, key2, TeaVariant::TEA, 77);
+            CPPUNIT_ASSERT_EQUAL(uint64_t(size), decipher.decryptStream(encryptedIn, decryptedOut));
+            CPPUNIT_ASSERT(decryptedOut.str() == plain);
+
+            // a header claiming 4 GiB chunks does not make decryption allocate them
+            string hugeChunks = encrypted;
+            hugeChunks.replace(8, 4, 4, '\xff');
+            istringstream hugeChunksIn(hugeChunks);
+            ostringstream hugeChunksOut;
+            CPPUNIT_ASSERT_EQUAL(uint64_t(size), decipher.decryptStream(hugeChunksIn, hugeChunksOut));
+            CPPUNIT_ASSERT(hugeChunksOut.str() == plain);
+        }
+    }
+
+    tea_file_cipher cipher(key1, key2);
+    istringstream   notEncrypted("this is not a cipher text");
+    ostringstream   out;
+    CPPUNIT_ASSERT_THROW(cipher.decryptStream(notEncrypted, out), runtime_error);
+    istringstream truncated("UTEA");
+    CPPUNIT_ASSERT_THROW(cipher.decryptStream(truncated, out), runtime_error);
+    CPPUNIT_ASSERT_THROW(tea_file_cipher(key1, key2, TeaVariant::TEA, 0), invalid_argument);
+
+    // streams encrypted by all workers of the shared pool at once must not wait for each other
+    {
+        string plain(20000, 'p');
+        for(size_t i = 0; i < plain.size(); i++)
+            plain[i] = char(i * 13);
+        tea_file_cipher small(key1, key2, TeaVariant::XTEA, 1000);
+        istringstream   plainIn(plain);
+        ostringstream   expected;
+        small.encryptStream(plainIn, expected, nonce);
+
+        thread_pool           &pool = thread_pool::shared();
+        vector<future<string>> results;
+        for(size_t w = 0; w < pool.size(); w++)
+            results.push_back(pool.submit(
+                [&]
+                {
+                    istringstream in(plain);
+                    ostringstream encrypted;
+                    small.encryptStream(in, encrypted, nonce);
+
+                    return (encrypted.str());
+                }));
+        for(auto &r: results)
+            CPPUNIT_ASSERT(r.get() == expected.str());
+    }
+
+    // files
+    auto   directory = filesystem::temp_directory_path();
+    string plainPath = (directory / "tinyTeaTest.plain").string();
+    string encPath   = (directory / "tinyTeaTest.enc").string();
+    string decPath   = (directory / "tinyTeaTest.dec").string();
+    string plain(5 << 20, 'x');
+    for(size_t i = 0; i < plain.size(); i += 4093)
+        plain[i] = char(i);
+    ofstream(plainPath, ios::binary) << plain;
+
+    CPPUNIT_ASSERT_EQUAL(uint64_t(plain.size()), cipher.encryptFile(plainPath, encPath));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(plain.size() + tea_file_cipher::headerSize), uint64_t(filesystem::file_size(encPath)));
+    CPPUNIT_ASSERT_EQUAL(uint64_t(plain.size()), cipher.decryptFile(encPath, decPath));
+    ifstream      decrypted(decPath, ios::binary);
+    ostringstream decryptedText;
+    decryptedText << decrypted.rdbuf();
+    CPPUNIT_ASSERT(decryptedText.str() == plain);
+    CPPUNIT_ASSERT_THROW(cipher.encryptFile((directory / "tinyTeaTest.missing").string(), encPath), runtime_error);
+
+    filesystem::remove(plainPath);
+    filesystem::remove(encPath);
+    filesystem::remove(decPath);
+}
@@ -31,6 +31,10 @@ class tinyTeaTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST_SUITE(tinyTeaTest);
 
     CPPUNIT_TEST(encryption_test);
+    CPPUNIT_TEST(xtea_test);
+    CPPUNIT_TEST(counter_mode_test);
+    CPPUNIT_TEST(kernel_test);
+    CPPUNIT_TEST(file_cipher_test);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -42,6 +46,10 @@ class tinyTeaTest : public CPPUNIT_NS::TestFixture
 
     private:
     void encryption_test();
+    void xtea_test();
+    void counter_mode_test();
+    void kernel_test();
+    void file_cipher_test();
 };
 
 #endif /* TINYTEATEST_H */
@@ -0,0 +1,197 @@
+/*
+ * File:		traceBackendTest.cc
+ * Description:         Unit tests for asynchronous tracing
+ *
+ * Copyright (C) 2026 Dieter J Kybelksties <github@kybelksties.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @date: 2026-10-18
+ * @author: Dieter J Kybelksties
+ */
+
+#include "traceBackendTest.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <trace_backend.h>
+#include <vector>
+
+using namespace std;
+using namespace util;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(traceBackendTest);
+
+namespace
+{
+const string filename = "/tmp/trace_backend_test.log";
+
+vector<string> traceLines()
+{
+    ifstream       is(filename);
+    vector<string> reval;
+    string         line;
+    while(getline(is, line))
+        reval.push_back(line);
+
+    return (reval);
+}
+
+size_t countContaining(const vector<string> &lines, const string &text)
+{
+    size_t reval = 0;
+    for(const auto &l: lines)
+        if(l.find(text) != string::npos)
+            reval++;
+
+    return (reval);
+}
+
+enum class colour
+{
+    RED,
+    GREEN
+};
+};
+// namespace
+
+traceBackendTest::traceBackendTest()
+{
+}
+
+traceBackendTest::~traceBackendTest()
+{
+}
+
+void traceBackendTest::setUp()
+{
+    setTraceLevel(TraceLevel::TRACE_DEBUG);
+    startTracing(filename);
+}
+
+void traceBackendTest::tearDown()
+{
+    stopTracing();
+    setTraceLevel(TraceLevel::TRACE_DEBUG);
+}
+
+void traceBackendTest::record_test()
+{
+    int         answer  = -42;
+    uint64_t    big     = 18446744073709551615ULL;
+    double      ratio   = 0.25;
+    bool        flag    = true;
+    char        letter  = 'x';
+    string      name    = "abc";
+    colour      c       = colour::GREEN;
+    const void *nothing = nullptr;
+    UTIL_TRACE(TraceLevel::TRACE_INFO);
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_WARNING, answer, big, ratio, flag, letter, name, c, nothing);
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_ERROR, answer + 1, string(2000, 'z'));
+    signed char   small   = 'y';
+    unsigned char byte    = 'z';
+    const char   *missing = nullptr;
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_INFO, small, byte, missing);
+    stopTracing();
+
+    auto lines = traceLines();
+    CPPUNIT_ASSERT_EQUAL(size_t(4), lines.size());
+    CPPUNIT_ASSERT(lines[0].find(" INFO ") != string::npos);
+    CPPUNIT_ASSERT(lines[0].find("traceBackendTest.cc:") != string::npos);
+    CPPUNIT_ASSERT(lines[0].find("record_test") != string::npos);
+    CPPUNIT_ASSERT(lines[1].find(" WARNING ") != string::npos);
+    CPPUNIT_ASSERT(lines[1].find(" answer=-42 big=18446744073709551615 ratio=0.25 flag=1 letter=x name=abc c=1 "
+                                 "nothing=0x0") != string::npos);
+
+    // names split at top-level commas only, too long arguments are cut off
+    CPPUNIT_ASSERT(lines[2].find(" ERROR ") != string::npos);
+    CPPUNIT_ASSERT(lines[2].find(" answer + 1=-41 string(2000, 'z')=zzz") != string::npos);
+    CPPUNIT_ASSERT(lines[2].size() < 1100);
+
+    // all character types are written as characters, a null C string as "(null)"
+    CPPUNIT_ASSERT(lines[3].find(" small=y byte=z missing=(null)") != string::npos);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), droppedTraceRecords());
+}
+
+void traceBackendTest::level_test()
+{
+    setTraceLevel(TraceLevel::TRACE_WARNING);
+    CPPUNIT_ASSERT(TraceLevel::TRACE_WARNING == traceLevel());
+    CPPUNIT_ASSERT(!traceEnabled(TraceLevel::TRACE_INFO));
+    CPPUNIT_ASSERT(traceEnabled(TraceLevel::TRACE_ERROR));
+
+    int evaluated = 0;
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_DEBUG, ++evaluated);
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_INFO, ++evaluated);
+    UTIL_TRACE_VALUES(TraceLevel::TRACE_ERROR, ++evaluated);
+    // arguments of discarded records are not evaluated
+    CPPUNIT_ASSERT_EQUAL(1, evaluated);
+
+    setTraceLevel(TraceLevel::TRACE_OFF);
+    UTIL_TRACE(TraceLevel::TRACE_ERROR);
+    flushTracing();
+
+    auto lines = traceLines();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), lines.size());
+    CPPUNIT_ASSERT(lines[0].find(" ERROR ") != string::npos);
+    CPPUNIT_ASSERT(lines[0].find("++evaluated=1") != string::npos);
+}
+
+void traceBackendTest::threads_test()
+{
+    // small buffers: whatever does not fit is dropped and counted, never blocks
+    stopTracing();
+    startTracing(filename, 4096);
+
+    constexpr size_t threads = 4;
+    constexpr size_t records = 5000;
+    vector<thread>   workers;
+    for(size_t t = 0; t < threads; t++)
+        workers.emplace_back(
+         [t]
+         {
+             for(size_t i = 0; i < records; i++)
+                 UTIL_TRACE_VALUES(TraceLevel::TRACE_INFO, t, i);
+         });
+    for(auto &w: workers)
+        w.join();
+    flushTracing();
+    uint64_t dropped = droppedTraceRecords();
+    stopTracing();
+
+    auto lines = traceLines();
+    CPPUNIT_ASSERT_EQUAL(threads * records, countContaining(lines, " i=") + size_t(dropped));
+    if(dropped > 0)
+        CPPUNIT_ASSERT(countContaining(lines, " records") > 0);
+
+    // the records of each thread keep their order; records of different threads are only
+    // sorted within one drain cycle, so there is no global order to check
+    vector<size_t> next(threads, 0);
+    vector<double> last(threads, 0.0);
+    for(const auto &l: lines)
+    {
+        auto pos = l.find(" t=");
+        if(pos == string::npos)
+            continue;
+        size_t t = stoul(l.substr(pos + 3));
+        size_t i = stoul(l.substr(l.find(" i=") + 3));
+        CPPUNIT_ASSERT(t < threads);
+        CPPUNIT_ASSERT(i >= next[t]);
+        CPPUNIT_ASSERT(stod(l) >= last[t]);
+        next[t] = i + 1;
+        last[t] = stod(l);
+    }
+}